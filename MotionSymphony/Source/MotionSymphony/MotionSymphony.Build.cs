@@ -26,6 +26,7 @@ public class MotionSymphony : ModuleRules
 				"MotionSymphony/Public/Objects",
 				"MotionSymphony/Public/Objects/Assets",
 				"MotionSymphony/Public/Objects/Tags",
+				"MotionSymphony/Public/Subsystems",
 
                 "MotionSymphony/Private",
                 "MotionSymphony/Private/AnimGraph",
@@ -34,7 +35,8 @@ public class MotionSymphony : ModuleRules
                 "MotionSymphony/Private/Utility",
 				"MotionSymphony/Private/Objects",
 				"MotionSymphony/Private/Objects/Assets",
-				"MotionSymphony/Private/Objects/Tags"
+				"MotionSymphony/Private/Objects/Tags",
+				"MotionSymphony/Private/Subsystems"
 				// ... add other private include paths required here ...
 			}
 			);
@@ -36,7 +36,7 @@ void FAnimNode_MSDistanceMatching::InitializeData()
 		return;
 	}
 
-	DistanceMatchingModule.Setup(CacheSequence, DistanceCurveName);
+	DistanceMatchingModule.Setup(CacheSequence, DistanceCurveName, bNegateDistanceCurve);
 	LastAnimSequenceUsed = CacheSequence;
 
 	const float CachePlayRateBasis = GetPlayRateBasis();
@@ -71,7 +71,7 @@ void FAnimNode_MSDistanceMatching::Initialize_AnyThread(const FAnimationInitiali
 	UAnimSequenceBase* CacheSequence = GetSequence();
 	if (CacheSequence != LastAnimSequenceUsed)
 	{
-		DistanceMatchingModule.Setup(CacheSequence, DistanceCurveName);
+		DistanceMatchingModule.Setup(CacheSequence, DistanceCurveName, bNegateDistanceCurve);
 		LastAnimSequenceUsed = CacheSequence;
 	}
 
@@ -12,6 +12,8 @@
 #include "Utility/MotionMatchingUtils.h"
 #include "Animation/AnimSyncScope.h"
 #include "Animation/MirrorDataTable.h"
+#include "Components/MotionInputProvider.h"
+#include "Components/SkeletalMeshComponent.h"
 
 FCriticalSection FAnimNode_MSMotionMatching::CheckValidCriticalSection;
 
@@ -77,12 +79,15 @@ FAnimNode_MSMotionMatching::FAnimNode_MSMotionMatching() :
 	TimeSinceMotionChosen(0.0f),
 	PoseInterpolationValue(0.0f),
 	bForcePoseSearch(false),
+	bPoseSearchDeferred(false),
 	CurrentChosenPoseId(0),
 	InputArraySize(0),
 	MotionRecorderConfigIndex(-1),
 	bValidToEvaluate(false),
 	bInitialized(false),
 	bTriggerTransition(false),
+	bRuntimeMirrored(false),
+	InputProviderSequence(0),
 	AnimInstanceProxy(nullptr)
 #if WITH_EDITORONLY_DATA
 	, PosesChecked(0),
@@ -104,6 +109,29 @@ FAnimNode_MSMotionMatching::~FAnimNode_MSMotionMatching()
 
 }
 
+FAnimNode_MotionRecorder* FAnimNode_MSMotionMatching::FindMotionRecorder(const FAnimationUpdateContext& Context) const
+{
+	if(!Context.AnimInstanceProxy
+		|| GetPlaybackMode(Context.AnimInstanceProxy) != EMotionMatchingPlaybackMode::Full)
+	{
+		return nullptr;
+	}
+	
+	if (IMotionSnapper* MotionSnapper = Context.GetMessage<IMotionSnapper>())
+	{
+		return &MotionSnapper->GetNode();
+	}
+
+	return nullptr;
+}
+
+void FAnimNode_MSMotionMatching::UpdatePlaybackModeState(const FAnimInstanceProxy* InAnimInstanceProxy)
+{
+	const EMotionMatchingPlaybackMode CurrentPlaybackMode = GetPlaybackMode(InAnimInstanceProxy);
+	MMAnimState.bUseBakedRootMotion = CurrentPlaybackMode != EMotionMatchingPlaybackMode::Full;
+	MMAnimState.bSkipNotifies = CurrentPlaybackMode == EMotionMatchingPlaybackMode::SearchOnly;
+}
+
 void FAnimNode_MSMotionMatching::InitializeWithPoseRecorder(const FAnimationUpdateContext& Context)
 {
 	FAnimNode_MotionRecorder* MotionRecorderNode = nullptr;
@@ -124,13 +152,9 @@ void FAnimNode_MSMotionMatching::InitializeWithPoseRecorder(const FAnimationUpda
 void FAnimNode_MSMotionMatching::InitializeMatchedTransition(const FAnimationUpdateContext& Context)
 {
 	TimeSinceMotionUpdate = TimeSinceMotionChosen = 0.0f;
+	UpdateInputFromProvider();
 	
-	FAnimNode_MotionRecorder* MotionRecorderNode = nullptr;
-	if (IMotionSnapper* MotionSnapper = Context.GetMessage<IMotionSnapper>())
-	{
-		MotionRecorderNode = &MotionSnapper->GetNode();
-	}
-	
+	FAnimNode_MotionRecorder* MotionRecorderNode = FindMotionRecorder(Context);
 	if (MotionRecorderNode)
 	{
 		ComputeCurrentPose(MotionRecorderNode->GetCurrentPoseArray(MotionRecorderConfigIndex));
@@ -143,6 +167,43 @@ void FAnimNode_MSMotionMatching::InitializeMatchedTransition(const FAnimationUpd
 	}
 }
 
+void FAnimNode_MSMotionMatching::InitializeInputProvider(const FAnimationUpdateContext& Context)
+{
+	InputProvider.Reset();
+	
+	if(!bUseInputProvider)
+	{
+		return;
+	}
+
+	const USkeletalMeshComponent* SkelMeshComponent = Context.AnimInstanceProxy->GetSkelMeshComponent();
+	const AActor* OwningActor = SkelMeshComponent ? SkelMeshComponent->GetOwner() : nullptr;
+	UMotionInputProvider* Provider = OwningActor ? OwningActor->FindComponentByClass<UMotionInputProvider>() : nullptr;
+	
+	if(!Provider)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Motion matching node is set to use an input provider but the owning actor has no 'Motion Input Provider' component. 'Input Data' will be used instead."));
+		return;
+	}
+
+	const UMotionMatchConfig* MMConfig = GetMotionData()->MotionMatchConfig;
+	if(Provider->MotionMatchConfig != MMConfig)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Motion matching node cannot use the input provider because its motion match config does not match the motion data. 'Input Data' will be used instead."));
+		return;
+	}
+
+	//The provider's input is copied straight into the desired input array so it is sized for the response features once
+	InputProvider = Provider;
+	InputProviderSequence = 0;
+	InputData.DesiredInputArray.SetNumZeroed(MMConfig->ResponseDimensionCount);
+}
+
+bool FAnimNode_MSMotionMatching::UpdateInputFromProvider()
+{
+	const UMotionInputProvider* Provider = InputProvider.Get();
+	return Provider && Provider->CopyInputArray(InputData.DesiredInputArray, InputProviderSequence);
+}
 
 void FAnimNode_MSMotionMatching::UpdateMotionMatchingState(const float DeltaTime, const FAnimationUpdateContext& Context)
 {
@@ -166,13 +227,10 @@ void FAnimNode_MSMotionMatching::UpdateMotionMatching(const float DeltaTime, con
 	const float PlayRateAdjustedDeltaTime = DeltaTime * PlaybackRate;
 	TimeSinceMotionChosen += PlayRateAdjustedDeltaTime;
 	TimeSinceMotionUpdate += PlayRateAdjustedDeltaTime;
-	
-	FAnimNode_MotionRecorder* MotionRecorderNode = nullptr;
-	if (IMotionSnapper* MotionSnapper = Context.GetMessage<IMotionSnapper>())
-	{
-		MotionRecorderNode = &MotionSnapper->GetNode();
-	}
-	
+
+	//Reduced playback modes output the reference pose so they take the current pose from the database instead of the
+	//recorder. Full mode scores against what was actually evaluated, so its pose choices can differ from theirs
+	FAnimNode_MotionRecorder* MotionRecorderNode = FindMotionRecorder(Context);
 	if (MotionRecorderNode)
 	{
 		ComputeCurrentPose(MotionRecorderNode->GetCurrentPoseArray(MotionRecorderConfigIndex));
@@ -184,9 +242,47 @@ void FAnimNode_MSMotionMatching::UpdateMotionMatching(const float DeltaTime, con
 
 	const TObjectPtr<const UMotionDataAsset> CurrentMotionData = GetMotionData();
 	bForcePoseSearch = CheckForcePoseSearch(CurrentMotionData);
+	bool bPoseSearchThisFrame = bForcePoseSearch || TimeSinceMotionUpdate >= UpdateInterval;
+
+	//A search that was not anticipated on the previous frame (e.g. a tag change) would run against an old snapshot. It
+	//is deferred by one frame so that the recorder can extract a snapshot for it. A search is never deferred twice in a
+	//row in case the recorder is not evaluated.
+	if (bPoseSearchThisFrame
+		&& MotionRecorderNode
+		&& !bPoseSearchDeferred
+		&& !MotionRecorderNode->IsSnapshotCurrent(MotionRecorderConfigIndex))
+	{
+		bPoseSearchThisFrame = false;
+		bPoseSearchDeferred = true;
+	}
+	else
+	{
+		bPoseSearchDeferred = false;
+	}
+	UMotionMatchConfig* MMConfig = CurrentMotionData->MotionMatchConfig;
+
+	//Input from a provider is only copied when it will be used by a search. The current pose was computed with the
+	//previous input so the new input is injected into it the same way that ComputeCurrentPose does.
+	if (bPoseSearchThisFrame && UpdateInputFromProvider())
+	{
+		int32 CurrentOffset = 0;
+		for(const TObjectPtr<UMatchFeatureBase> FeaturePtr : MMConfig->Features)
+		{
+			if(FeaturePtr->PoseCategory == EPoseCategory::Responsiveness
+				&& !(MotionRecorderNode && FeaturePtr->IsMotionSnapshotCompatible()))
+			{
+				const int32 FeatureLimit = FMath::Min3(FeaturePtr->Size() + CurrentOffset, InputData.DesiredInputArray.Num(),
+					CurrentInterpolatedPoseArray.Num() - 1);
+				for(int32 i = CurrentOffset; i < FeatureLimit; ++i)
+				{
+					CurrentInterpolatedPoseArray[i + 1] = InputData.DesiredInputArray[i];
+				}
+			}
+			CurrentOffset += FeaturePtr->Size();
+		}
+	}
 	
 	//Past trajectory mode
-	UMotionMatchConfig* MMConfig = CurrentMotionData->MotionMatchConfig;
 	if (PastTrajectoryMode == EPastTrajectoryMode::CopyFromCurrentPose)
 	{
 		int32 CurrentOffset = 0;
@@ -205,11 +301,20 @@ void FAnimNode_MSMotionMatching::UpdateMotionMatching(const float DeltaTime, con
 		}
 	}
 	
-	if (bForcePoseSearch || TimeSinceMotionUpdate >= UpdateInterval)
+	if (bPoseSearchThisFrame)
 	{
 		TimeSinceMotionUpdate = 0.0f;
 		PoseSearch(Context);
 	}
+
+	//The recorder only needs to extract the snapshot when it is evaluated before a search. This is the case for a
+	//deferred search, the next interval search and any forced search that will happen within the next frame.
+	if (MotionRecorderNode)
+	{
+		MotionRecorderNode->RequestSnapshot(MotionRecorderConfigIndex, bPoseSearchDeferred
+			|| TimeSinceMotionUpdate + PlayRateAdjustedDeltaTime >= UpdateInterval
+			|| CheckForcePoseSearch(CurrentMotionData, PlayRateAdjustedDeltaTime));
+	}
 }
 
 void FAnimNode_MSMotionMatching::ComputeCurrentPose()
@@ -221,67 +326,12 @@ void FAnimNode_MSMotionMatching::ComputeCurrentPose()
 		return;
 	}
 	
-	const float PoseInterval = FMath::Max(0.01f, CurrentMotionData->PoseInterval);
-
-	//====== Determine the next dominant pose ========
-	float DominantClipLength = GetMotionPlayLength(MMAnimState.AnimId, MMAnimState.AnimType, CurrentMotionData);
+	int32 BeforePoseId;
+	int32 AfterPoseId;
+	FindCurrentPosePair(CurrentMotionData, BeforePoseId, AfterPoseId);
 	
-	float TimePassed = TimeSinceMotionChosen;
-	int32 PoseIndex = MMAnimState.StartPoseId;
-
-	//Determine if the new time is out of bounds of the dominant pose clip
-	float NewDominantTime = MMAnimState.StartTime + TimePassed;
-	if (NewDominantTime >= DominantClipLength)
-	{
-		if (MMAnimState.bLoop)
-		{
-			NewDominantTime = FMotionMatchingUtils::WrapAnimationTime(NewDominantTime, DominantClipLength);
-		}
-		else
-		{
-			const float TimeToNextClip = DominantClipLength - (TimePassed + MMAnimState.StartTime);
-
-			if (TimeToNextClip < PoseInterval)
-			{
-				--PoseIndex;
-			}
-
-			NewDominantTime = DominantClipLength;
-		}
-
-		TimePassed = NewDominantTime - MMAnimState.StartTime;
-	}
-
-	int32 NumPosesPassed;
-	if (TimePassed < -UE_SMALL_NUMBER)
-	{
-		NumPosesPassed = FMath::CeilToInt(TimePassed / PoseInterval);
-	}
-	else
-	{
-		NumPosesPassed = FMath::FloorToInt(TimePassed / PoseInterval);
-	}
-
-	CurrentChosenPoseId = PoseIndex = FMath::Clamp(PoseIndex + NumPosesPassed, 0, CurrentMotionData->Poses.Num() - 1);
-
-	//Get the before and after poses and then interpolate
-	FPoseMotionData BeforePose;
-	FPoseMotionData AfterPose;
-
-	if (TimePassed < UE_SMALL_NUMBER)
-	{
-		AfterPose = CurrentMotionData->Poses[PoseIndex];
-		BeforePose = CurrentMotionData->Poses[FMath::Clamp(AfterPose.LastPoseId, 0, CurrentMotionData->Poses.Num() - 1)];
-
-		PoseInterpolationValue = 1.0f - FMath::Abs((TimePassed / PoseInterval) - static_cast<float>(NumPosesPassed));
-	}
-	else
-	{
-		BeforePose = CurrentMotionData->Poses[FMath::Min(PoseIndex, CurrentMotionData->Poses.Num() - 2)];
-		AfterPose = CurrentMotionData->Poses[FMath::Clamp(BeforePose.NextPoseId, 0, CurrentMotionData->Poses.Num() -1)];
-
-		PoseInterpolationValue = (TimePassed / PoseInterval) - static_cast<float>(NumPosesPassed);
-	}
+	const FRuntimePoseData& BeforePose = CurrentMotionData->RuntimePoses[BeforePoseId];
+	const FRuntimePoseData& AfterPose = CurrentMotionData->RuntimePoses[AfterPoseId];
 
 	FMotionMatchingUtils::LerpPose(CurrentInterpolatedPose, BeforePose, AfterPose, PoseInterpolationValue);
 
@@ -293,6 +343,8 @@ void FAnimNode_MSMotionMatching::ComputeCurrentPose()
 	FMotionMatchingUtils::LerpFloatArray(CurrentInterpolatedPoseArray, &PoseArray[BeforePoseArrayStartIndex],
 		&PoseArray[AfterPoseArrayStartIndex], PoseInterpolationValue);
 
+	MirrorCurrentPoseArray(CurrentMotionData);
+
 	//Inject the input array / trajectory
 	if(CurrentInterpolatedPoseArray.Num() > 0)
 	{
@@ -322,10 +374,65 @@ void FAnimNode_MSMotionMatching::ComputeCurrentPose(const TArray<float>* Current
 		return;
 	}
 	
-	const float PoseInterval = FMath::Max(0.01f, CurrentMotionData->PoseInterval);
+	int32 BeforePoseId;
+	int32 AfterPoseId;
+	FindCurrentPosePair(CurrentMotionData, BeforePoseId, AfterPoseId);
+	
+	const FRuntimePoseData& BeforePose = CurrentMotionData->RuntimePoses[BeforePoseId];
+	const FRuntimePoseData& AfterPose = CurrentMotionData->RuntimePoses[AfterPoseId];
+	
+	FMotionMatchingUtils::LerpPose(CurrentInterpolatedPose, BeforePose,
+		AfterPose, PoseInterpolationValue);
+
+	const FPoseMatrix& PoseMatrix = CurrentMotionData->LookupPoseMatrix;
+	const TArray<float>& PoseArray = PoseMatrix.PoseArray;
+	const int32 BeforePoseArrayStartIndex = FMath::Clamp(PoseMatrix.AtomCount * BeforePose.PoseId, 0, PoseArray.Num()-1);
+	const int32 AfterPoseArrayStartIndex = FMath::Clamp(PoseMatrix.AtomCount * AfterPose.PoseId, 0, PoseArray.Num()-1);
+
+	FMotionMatchingUtils::LerpFloatArray(CurrentInterpolatedPoseArray, &PoseArray[BeforePoseArrayStartIndex], 
+	                                     &PoseArray[AfterPoseArrayStartIndex], PoseInterpolationValue);
+
+	MirrorCurrentPoseArray(CurrentMotionData);
+
+#if ENABLE_ANIM_DEBUG && ENABLE_DRAW_DEBUG
+	if(CVarMMTrajectoryDebug.GetValueOnAnyThread() == 2)
+	{
+		DrawChosenInputArrayDebug(AnimInstanceProxy);
+	}
+#endif
+
+	//Inject the input array / trajectory. This currently assumes that all input is first in the pose array
+	CurrentInterpolatedPoseArray[0] = 1.0f;
+	const int32 Iterations = FMath::Min(CurrentInterpolatedPoseArray.Num() - 1, InputData.DesiredInputArray.Num());
+	for(int32 i = 0; i < Iterations; ++i)
+	{
+		CurrentInterpolatedPoseArray[i+1] = InputData.DesiredInputArray[i]; //+1 to pose array to make room for Pose Cost Multiplier value
+	}
+
+	int32 FeatureOffset = 0;
+	for(const TObjectPtr<UMatchFeatureBase> Feature : CurrentMotionData->MotionMatchConfig->Features)
+	{
+		const int32 FeatureSize = Feature->Size();
+		
+		if(Feature->IsMotionSnapshotCompatible())
+		{
+			for(int32 i = 0; i < FeatureSize; ++i)
+			{
+				CurrentInterpolatedPoseArray[FeatureOffset + i + 1] = (*CurrentPoseArray)[FeatureOffset + i];
+			}
+		}
+
+		FeatureOffset += FeatureSize;
+	}
+}
+
+void FAnimNode_MSMotionMatching::FindCurrentPosePair(const UMotionDataAsset* InMotionData, int32& OutBeforePoseId, int32& OutAfterPoseId)
+{
+	const float PoseInterval = FMath::Max(0.01f, InMotionData->PoseInterval);
+	const int32 MaxPoseIndex = InMotionData->RuntimePoses.Num() - 1;
 	
 	//====== Determine the next dominant pose ========
-	float DominantClipLength = GetMotionPlayLength(MMAnimState.AnimId, MMAnimState.AnimType, CurrentMotionData);
+	const float DominantClipLength = GetMotionPlayLength(MMAnimState.AnimId, MMAnimState.AnimType, InMotionData);
 	
 	float TimePassed = TimeSinceMotionChosen;
 	int32 PoseIndex = MMAnimState.StartPoseId;
@@ -353,6 +460,16 @@ void FAnimNode_MSMotionMatching::ComputeCurrentPose(const TArray<float>* Current
 		TimePassed = NewDominantTime - MMAnimState.StartTime;
 	}
 
+	//Adaptively sampled poses are not evenly spaced so the pose pair must be looked up by the time stored on each pose
+	if(InMotionData->HasVariablePoseSpacing())
+	{
+		InMotionData->FindPosePairAtTime(MMAnimState.StartPoseId, NewDominantTime, DominantClipLength,
+			OutBeforePoseId, OutAfterPoseId, PoseInterpolationValue);
+
+		CurrentChosenPoseId = OutBeforePoseId;
+		return;
+	}
+
 	int32 NumPosesPassed;
 	if (TimePassed < -UE_SMALL_NUMBER)
 	{
@@ -363,70 +480,60 @@ void FAnimNode_MSMotionMatching::ComputeCurrentPose(const TArray<float>* Current
 		NumPosesPassed = FMath::FloorToInt(TimePassed / PoseInterval);
 	}
 
-	const int32 MaxPoseIndex = CurrentMotionData->Poses.Num() - 1;
 	CurrentChosenPoseId = PoseIndex = FMath::Clamp(PoseIndex + NumPosesPassed, 0, MaxPoseIndex);
 
-	//Get the before and after poses and then interpolate
-	FPoseMotionData BeforePose;
-	FPoseMotionData AfterPose;
-
+	//Get the before and after poses
 	if (TimePassed < -UE_SMALL_NUMBER)
 	{
-		AfterPose = CurrentMotionData->Poses[PoseIndex];
-		BeforePose = CurrentMotionData->Poses[FMath::Clamp(AfterPose.LastPoseId, 0, MaxPoseIndex)];
+		OutAfterPoseId = PoseIndex;
+		OutBeforePoseId = FMath::Clamp(InMotionData->RuntimePoses[PoseIndex].LastPoseId, 0, MaxPoseIndex);
 
 		PoseInterpolationValue = 1.0f - FMath::Abs((TimePassed / PoseInterval) - static_cast<float>(NumPosesPassed));
 	}
 	else
 	{
-		BeforePose = CurrentMotionData->Poses[FMath::Min(PoseIndex, CurrentMotionData->Poses.Num() - 2)];
-		AfterPose = CurrentMotionData->Poses[FMath::Clamp(BeforePose.NextPoseId, 0, MaxPoseIndex)];
+		OutBeforePoseId = FMath::Clamp(PoseIndex, 0, FMath::Max(0, MaxPoseIndex - 1));
+		OutAfterPoseId = FMath::Clamp(InMotionData->RuntimePoses[OutBeforePoseId].NextPoseId, 0, MaxPoseIndex);
 
 		PoseInterpolationValue = (TimePassed / PoseInterval) - static_cast<float>(NumPosesPassed);
 	}
 
 	PoseInterpolationValue = FMath::Clamp(PoseInterpolationValue, 0.0f, 1.0f);
-	
-	FMotionMatchingUtils::LerpPose(CurrentInterpolatedPose, BeforePose,
-		AfterPose, PoseInterpolationValue);
-
-	const FPoseMatrix& PoseMatrix = CurrentMotionData->LookupPoseMatrix;
-	const TArray<float>& PoseArray = PoseMatrix.PoseArray;
-	const int32 BeforePoseArrayStartIndex = FMath::Clamp(PoseMatrix.AtomCount * BeforePose.PoseId, 0, PoseArray.Num()-1);
-	const int32 AfterPoseArrayStartIndex = FMath::Clamp(PoseMatrix.AtomCount * AfterPose.PoseId, 0, PoseArray.Num()-1);
-
-	FMotionMatchingUtils::LerpFloatArray(CurrentInterpolatedPoseArray, &PoseArray[BeforePoseArrayStartIndex], 
-	                                     &PoseArray[AfterPoseArrayStartIndex], PoseInterpolationValue);
+}
 
-#if ENABLE_ANIM_DEBUG && ENABLE_DRAW_DEBUG
-	if(CVarMMTrajectoryDebug.GetValueOnAnyThread() == 2)
+void FAnimNode_MSMotionMatching::MirrorCurrentPoseArray(const UMotionDataAsset* InMotionData)
+{
+	if(!bRuntimeMirrored
+		|| !InMotionData->UsesRuntimeMirroring()
+		|| CurrentInterpolatedPoseArray.Num() != InMotionData->LookupPoseMatrix.AtomCount)
 	{
-		DrawChosenInputArrayDebug(AnimInstanceProxy);
+		return;
 	}
-#endif
 
-	//Inject the input array / trajectory. This currently assumes that all input is first in the pose array
-	CurrentInterpolatedPoseArray[0] = 1.0f;
-	const int32 Iterations = FMath::Min(CurrentInterpolatedPoseArray.Num() - 1, InputData.DesiredInputArray.Num());
-	for(int32 i = 0; i < Iterations; ++i)
+	//The pose database only stores the un-mirrored animation so the interpolated pose is mirrored to match what is playing
+	MirroredPoseArray = CurrentInterpolatedPoseArray;
+	InMotionData->MirrorPoseArray(MirroredPoseArray.GetData(), CurrentInterpolatedPoseArray.GetData());
+	CurrentInterpolatedPose.bMirrored = true;
+}
+
+void FAnimNode_MSMotionMatching::GenerateMirroredQuery()
+{
+	TObjectPtr<const UMotionDataAsset> CurrentMotionData = GetMotionData();
+	if(!CurrentMotionData->UsesRuntimeMirroring()
+		|| CurrentInterpolatedPoseArray.Num() != CurrentMotionData->LookupPoseMatrix.AtomCount)
 	{
-		CurrentInterpolatedPoseArray[i+1] = InputData.DesiredInputArray[i]; //+1 to pose array to make room for Pose Cost Multiplier value
+		return;
 	}
 
-	int32 FeatureOffset = 0;
-	for(const TObjectPtr<UMatchFeatureBase> Feature : CurrentMotionData->MotionMatchConfig->Features)
-	{
-		const int32 FeatureSize = Feature->Size();
-		
-		if(Feature->IsMotionSnapshotCompatible())
-		{
-			for(int32 i = 0; i < FeatureSize; ++i)
-			{
-				CurrentInterpolatedPoseArray[FeatureOffset + i + 1] = (*CurrentPoseArray)[FeatureOffset + i];
-			}
-		}
+	/* Searching an un-mirrored pose with the mirrored query is equivalent to searching the mirrored pose with
+	 * the actual query. The mirrored input is also kept for tolerance tests against runtime mirrored animations */
+	MirroredPoseArray.SetNumUninitialized(CurrentInterpolatedPoseArray.Num(), false);
+	CurrentMotionData->MirrorPoseArray(CurrentInterpolatedPoseArray.GetData(), MirroredPoseArray.GetData());
 
-		FeatureOffset += FeatureSize;
+	MirroredDesiredInputArray.SetNumUninitialized(InputData.DesiredInputArray.Num(), false);
+	for(int32 i = 0; i < MirroredDesiredInputArray.Num(); ++i)
+	{
+		MirroredDesiredInputArray[i] = i + 1 < MirroredPoseArray.Num() ? MirroredPoseArray[i + 1] : InputData.DesiredInputArray[i];
 	}
 }
 
@@ -442,6 +549,8 @@ void FAnimNode_MSMotionMatching::PoseSearch(const FAnimationUpdateContext& Conte
 	{
 		return;
 	}
+
+	GenerateMirroredQuery();
 	
 	const int32 MaxPoseId = CurrentMotionData->Poses.Num() - 1;
 	CurrentChosenPoseId = FMath::Clamp(CurrentChosenPoseId, 0, MaxPoseId);
@@ -462,9 +571,10 @@ void FAnimNode_MSMotionMatching::PoseSearch(const FAnimationUpdateContext& Conte
 		}
 	}
 
+	bool bLowestPoseMirrored = false;
 	const int32 LowestPoseId = (SearchQuality == EMotionMatchingSearchQuality::Performance) 
-		? GetLowestCostPoseId_Standard()
-		: GetLowestCostPoseId_HighQuality(Context.GetDeltaTime());
+		? GetLowestCostPoseId_Standard(bLowestPoseMirrored)
+		: GetLowestCostPoseId_HighQuality(Context.GetDeltaTime(), bLowestPoseMirrored);
 
 	const FPoseMotionData& BestPose = CurrentMotionData->Poses[LowestPoseId];
 
@@ -476,26 +586,31 @@ void FAnimNode_MSMotionMatching::PoseSearch(const FAnimationUpdateContext& Conte
 	 */
 	const bool bSameAnim = BestPose.AnimId == CurrentInterpolatedPose.AnimId
 					&& BestPose.AnimType == CurrentInterpolatedPose.AnimType
-					&& BestPose.bMirrored == CurrentInterpolatedPose.bMirrored;
+					&& (BestPose.bMirrored || bLowestPoseMirrored) == CurrentInterpolatedPose.bMirrored;
 
 	TObjectPtr<const UMotionAnimObject> SourceMotion = MotionData->GetSourceAnim(BestPose.AnimId, BestPose.AnimType);
 	
 	const bool bWinnerAtSameLocation = bSameAnim && ((SourceMotion ? SourceMotion->bLoop : false) ||
 									(FMath::Abs(BestPose.Time - CurrentInterpolatedPose.Time) < SamePoseTolerance
-									&& FVector2D::DistSquared(BestPose.BlendSpacePosition, CurrentInterpolatedPose.BlendSpacePosition) < 1.0f));
+									&& FVector2D::DistSquared(BestPose.BlendSpacePosition,
+										CurrentMotionData->Poses[CurrentInterpolatedPose.PoseId].BlendSpacePosition) < 1.0f));
 	
 	if (!bWinnerAtSameLocation)
 	{
-		TransitionToPose(BestPose.PoseId, Context);
+		TransitionToPose(BestPose.PoseId, Context, 0.0f, bLowestPoseMirrored);
 	}
 }
 
 void FAnimNode_MSMotionMatching::TransitionPoseSearch(const FAnimationUpdateContext& Context)
 {
-	TransitionToPose(GetLowestCostPoseId_Transition(), Context, 0.0f);
+	GenerateMirroredQuery();
+
+	bool bLowestPoseMirrored = false;
+	const int32 LowestPoseId = GetLowestCostPoseId_Transition(bLowestPoseMirrored);
+	TransitionToPose(LowestPoseId, Context, 0.0f, bLowestPoseMirrored);
 }
 
-bool FAnimNode_MSMotionMatching::CheckForcePoseSearch(const UMotionDataAsset* InMotionData) const
+bool FAnimNode_MSMotionMatching::CheckForcePoseSearch(const UMotionDataAsset* InMotionData, const float LookAheadTime) const
 {
 	if(!InMotionData)
 	{
@@ -504,45 +619,43 @@ bool FAnimNode_MSMotionMatching::CheckForcePoseSearch(const UMotionDataAsset* In
 	
 	if(bUserForcePoseSearch
 		|| CurrentInterpolatedPose.SearchFlag == EPoseSearchFlag::DoNotUse
-		|| !CurrentInterpolatedPose.MotionTags.HasAllExact(RequiredMotionTags))
+		|| !InMotionData->MotionTagList.IsValidIndex(CurrentInterpolatedPose.TagSectionIndex)
+		|| !InMotionData->MotionTagList[CurrentInterpolatedPose.TagSectionIndex].HasAllExact(RequiredMotionTags))
 	{
 		return true;
 	}
 	
 	if (!MMAnimState.bLoop)
 	{
-		if (MMAnimState.StartTime + TimeSinceMotionChosen  > MMAnimState.AnimLength)
+		if (MMAnimState.StartTime + TimeSinceMotionChosen + LookAheadTime > MMAnimState.AnimLength)
 		{
 			return true;
 		}
 	}
-	const int32 PoseCountToCheck = CurrentInterpolatedPose.PoseId + FMath::CeilToInt32(BlendTime / InMotionData->GetPoseInterval());
+	//Force a search if there will be a DoNotUse pose or a new animation within the blend time. With variable pose
+	//spacing the baked end time of the usable poses is compared instead of walking the poses in the blend window.
+	if(InMotionData->HasVariablePoseSpacing())
+	{
+		return CurrentInterpolatedPose.UsableEndTime - CurrentInterpolatedPose.Time < BlendTime + LookAheadTime;
+	}
+	
+	const int32 PoseCountToCheck = InMotionData->GetPoseCountInTimeSpan(CurrentInterpolatedPose.PoseId,
+		BlendTime + LookAheadTime);
 
 	//End of pose data, pose search must be forced
-	if(PoseCountToCheck >= InMotionData->Poses.Num())
+	if(CurrentInterpolatedPose.PoseId + PoseCountToCheck >= InMotionData->RuntimePoses.Num())
 	{
 		return true;
 	}
 
-	//Check ahead to see if there will be a DoNotUse pose within the blend time or a new animation
-	for(int32 i = CurrentInterpolatedPose.PoseId; i < PoseCountToCheck; ++i)
-	{
-		const FPoseMotionData& ThisPose = InMotionData->Poses[i];
-		
-		if(ThisPose.SearchFlag == EPoseSearchFlag::DoNotUse
-			|| ThisPose.AnimId != CurrentInterpolatedPose.AnimId
-			|| ThisPose.AnimType != CurrentInterpolatedPose.AnimType)
-		{
-			return true;
-		}
-	}
-	
-	return false;
+	return CurrentInterpolatedPose.UsablePoseCount < PoseCountToCheck;
 }
 
 /** TRANSITION POSE SEARCH*/
-int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Transition()
+int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Transition(bool& bOutMirrored)
 {
+	bOutMirrored = bRuntimeMirrored;
+	
 	if(!GenerateCalibrationArray())
 	{
 		return CurrentChosenPoseId;
@@ -567,62 +680,78 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Transition()
 	const TArray<float>& OuterAABBArray = CurrentMotionData->PoseAABBMatrix_Outer.ExtentsArray;
 	const TArray<float>& InnerAABBArray = CurrentMotionData->PoseAABBMatrix_Inner.ExtentsArray;
 	const TArray<float>& PoseArray = CurrentMotionData->SearchPoseMatrix.PoseArray;
-	for(int32 OuterAABBIndex = OuterAABBStartIndex; OuterAABBIndex < OuterAABBEndIndex; ++OuterAABBIndex)
+
+	//The second search pass finds mirrored poses by comparing the un-mirrored poses against a mirrored query
+	const int32 SearchPassCount = CurrentMotionData->UsesRuntimeMirroring() ? 2 : 1;
+	for(int32 SearchPass = 0; SearchPass < SearchPassCount; ++SearchPass)
 	{
-		const int32 OuterAABBAtomStartIndex = OuterAABBIndex * AtomCount * 2;
+		const bool bMirrorPass = SearchPass > 0;
+		const TArray<float>& QueryArray = bMirrorPass ? MirroredPoseArray : CurrentInterpolatedPoseArray;
+		const TArray<float>& PassCalibrationArray = bMirrorPass ? MirroredCalibrationArray : CalibrationArray;
 		
-		float AABBCost = 0.0f;
-		for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+		for(int32 OuterAABBIndex = OuterAABBStartIndex; OuterAABBIndex < OuterAABBEndIndex; ++OuterAABBIndex)
 		{
-			const int32 OuterAABBAtomIndex = OuterAABBAtomStartIndex + (DimIndex * 2);
+			const int32 OuterAABBAtomStartIndex = OuterAABBIndex * AtomCount * 2;
+		
+			float AABBCost = 0.0f;
+			for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+			{
+				const int32 OuterAABBAtomIndex = OuterAABBAtomStartIndex + (DimIndex * 2);
 
-			const float ClosestPoint = FMath::Clamp(CurrentInterpolatedPoseArray[DimIndex],
-			                                        OuterAABBArray[OuterAABBAtomIndex],
-			                                        OuterAABBArray[OuterAABBAtomIndex + 1]);
+				const float ClosestPoint = FMath::Clamp(QueryArray[DimIndex],
+				                                        OuterAABBArray[OuterAABBAtomIndex],
+				                                        OuterAABBArray[OuterAABBAtomIndex + 1]);
 
-			AABBCost += FMath::Abs(CurrentInterpolatedPoseArray[DimIndex] - ClosestPoint) * CalibrationArray[DimIndex - 1];
-		}
+				AABBCost += FMath::Abs(QueryArray[DimIndex] - ClosestPoint) * PassCalibrationArray[DimIndex - 1];
+			}
 
-		if(AABBCost < LowestCost)
-		{
-			//We need to search the inner AABBs
-			const int32 InnerAABBStartIndex = OuterAABBIndex * 4;
-			const int32 InnerAABBEndIndex = FMath::Min(InnerAABBStartIndex + 4, FMath::CeilToInt32(MotionTagEndPoseIndex / 16.0f));
-			for(int32 InnerAABBIndex = InnerAABBStartIndex; InnerAABBIndex < InnerAABBEndIndex; ++InnerAABBIndex)
+			if(AABBCost < LowestCost)
 			{
-				const int32 InnerAABBAtomStartIndex = InnerAABBIndex * AtomCount * 2;
-
-				AABBCost = 0.0f;
-				for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+				//We need to search the inner AABBs
+				const int32 InnerAABBStartIndex = OuterAABBIndex * 4;
+				const int32 InnerAABBEndIndex = FMath::Min(InnerAABBStartIndex + 4, FMath::CeilToInt32(MotionTagEndPoseIndex / 16.0f));
+				for(int32 InnerAABBIndex = InnerAABBStartIndex; InnerAABBIndex < InnerAABBEndIndex; ++InnerAABBIndex)
 				{
-					const int32 InnerAABBAtomIndex = InnerAABBAtomStartIndex + (DimIndex * 2);
+					const int32 InnerAABBAtomStartIndex = InnerAABBIndex * AtomCount * 2;
 
-					const float ClosestPoint = FMath::Clamp(CurrentInterpolatedPoseArray[DimIndex],
-															InnerAABBArray[InnerAABBAtomIndex],
-															InnerAABBArray[InnerAABBAtomIndex + 1]);
+					AABBCost = 0.0f;
+					for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+					{
+						const int32 InnerAABBAtomIndex = InnerAABBAtomStartIndex + (DimIndex * 2);
 
-					AABBCost += FMath::Abs(CurrentInterpolatedPoseArray[DimIndex] - ClosestPoint) * CalibrationArray[DimIndex - 1];
-				}
+						const float ClosestPoint = FMath::Clamp(QueryArray[DimIndex],
+																InnerAABBArray[InnerAABBAtomIndex],
+																InnerAABBArray[InnerAABBAtomIndex + 1]);
 
-				if(AABBCost < LowestCost)
-				{
-					const int32 StartPoseIndex = FMath::Max(InnerAABBIndex * 16, MotionTagStartPoseIndex);
-					const int32 EndPoseIndex = FMath::Min((InnerAABBIndex * 16) + 16, MotionTagEndPoseIndex);
-					for(int32 PoseIndex = StartPoseIndex; PoseIndex < EndPoseIndex; ++PoseIndex)
+						AABBCost += FMath::Abs(QueryArray[DimIndex] - ClosestPoint) * PassCalibrationArray[DimIndex - 1];
+					}
+
+					if(AABBCost < LowestCost)
 					{
-						float Cost = 0.0f;
-						const int32 MatrixStartIndex = PoseIndex * AtomCount;
-						const float PoseFavour = PoseArray[MatrixStartIndex]; //Pose cost multiplier is the first atom of a pose array
-						for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
+						const int32 StartPoseIndex = FMath::Max(InnerAABBIndex * 16, MotionTagStartPoseIndex);
+						const int32 EndPoseIndex = FMath::Min((InnerAABBIndex * 16) + 16, MotionTagEndPoseIndex);
+						for(int32 PoseIndex = StartPoseIndex; PoseIndex < EndPoseIndex; ++PoseIndex)
 						{
-							Cost += FMath::Abs(PoseArray[MatrixStartIndex + AtomIndex] - CurrentInterpolatedPoseArray[AtomIndex])
-									* CalibrationArray[AtomIndex - 1] * PoseFavour; 
-						}
+							if(bMirrorPass && !CurrentMotionData->IsSearchPoseMirrorable(PoseIndex))
+							{
+								continue;
+							}
+
+							float Cost = 0.0f;
+							const int32 MatrixStartIndex = PoseIndex * AtomCount;
+							const float PoseFavour = PoseArray[MatrixStartIndex]; //Pose cost multiplier is the first atom of a pose array
+							for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
+							{
+								Cost += FMath::Abs(PoseArray[MatrixStartIndex + AtomIndex] - QueryArray[AtomIndex])
+										* PassCalibrationArray[AtomIndex - 1] * PoseFavour; 
+							}
 						
-						if(Cost < LowestCost)
-						{
-							LowestCost = Cost;
-							LowestPoseId_SM = PoseIndex;
+							if(Cost < LowestCost)
+							{
+								LowestCost = Cost;
+								LowestPoseId_SM = PoseIndex;
+								bOutMirrored = bMirrorPass;
+							}
 						}
 					}
 				}
@@ -634,8 +763,10 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Transition()
 }
 
 /** STANDARD QUALITY POSE SEARCH*/
-int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Standard()
+int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Standard(bool& bOutMirrored)
 {
+	bOutMirrored = bRuntimeMirrored;
+	
 	if(!GenerateCalibrationArray())
 	{
 		return CurrentChosenPoseId;
@@ -646,6 +777,10 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Standard()
 	TObjectPtr<const UMotionDataAsset> CurrentMotionData = GetMotionData();
 	const int32 AtomCount = CurrentMotionData->SearchPoseMatrix.AtomCount;
 	const TArray<float>& LookupPoseArray = CurrentMotionData->LookupPoseMatrix.PoseArray;
+
+	//The current animation is only stored un-mirrored so if it is mirrored at runtime it is compared with the mirrored query
+	const TArray<float>& CurrentQueryArray = bRuntimeMirrored ? MirroredPoseArray : CurrentInterpolatedPoseArray;
+	const TArray<float>& CurrentCalibrationArray = bRuntimeMirrored ? MirroredCalibrationArray : CalibrationArray;
 	
 	//Check cost of current pose first for "Favour Current Pose"
 	int32 LowestPoseId_LM = 0; //_LM stands for Lookup Matrix
@@ -661,8 +796,8 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Standard()
 
 			for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
 			{
-				LowestCost += FMath::Abs(LookupPoseArray[PoseStartIndex + AtomIndex] - CurrentInterpolatedPoseArray[AtomIndex])
-					* CalibrationArray[AtomIndex - 1];
+				LowestCost += FMath::Abs(LookupPoseArray[PoseStartIndex + AtomIndex] - CurrentQueryArray[AtomIndex])
+					* CurrentCalibrationArray[AtomIndex - 1];
 			}
 			LowestCost *= PoseFavour;
 			LowestCost *= CurrentPoseFavour;
@@ -699,86 +834,102 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Standard()
 	const TArray<float>& OuterAABBArray = CurrentMotionData->PoseAABBMatrix_Outer.ExtentsArray;
 	const TArray<float>& InnerAABBArray = CurrentMotionData->PoseAABBMatrix_Inner.ExtentsArray;
 	const TArray<float>& PoseArray = CurrentMotionData->SearchPoseMatrix.PoseArray;
-	for(int32 OuterAABBIndex = OuterAABBStartIndex; OuterAABBIndex < OuterAABBEndIndex; ++OuterAABBIndex)
+
+	//The second search pass finds mirrored poses by comparing the un-mirrored poses against a mirrored query
+	const int32 SearchPassCount = CurrentMotionData->UsesRuntimeMirroring() ? 2 : 1;
+	for(int32 SearchPass = 0; SearchPass < SearchPassCount; ++SearchPass)
 	{
-#if WITH_EDITORONLY_DATA	
-		++OuterAABBsChecked;
-#endif
+		const bool bMirrorPass = SearchPass > 0;
+		const TArray<float>& QueryArray = bMirrorPass ? MirroredPoseArray : CurrentInterpolatedPoseArray;
+		const TArray<float>& PassCalibrationArray = bMirrorPass ? MirroredCalibrationArray : CalibrationArray;
 		
-		const int32 OuterAABBAtomStartIndex = OuterAABBIndex * AtomCount * 2;
-		
-		float AABBCost = 0.0f;
-		for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+		for(int32 OuterAABBIndex = OuterAABBStartIndex; OuterAABBIndex < OuterAABBEndIndex; ++OuterAABBIndex)
 		{
-			const int32 OuterAABBAtomIndex = OuterAABBAtomStartIndex + (DimIndex * 2);
+	#if WITH_EDITORONLY_DATA	
+			++OuterAABBsChecked;
+	#endif
+		
+			const int32 OuterAABBAtomStartIndex = OuterAABBIndex * AtomCount * 2;
+		
+			float AABBCost = 0.0f;
+			for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+			{
+				const int32 OuterAABBAtomIndex = OuterAABBAtomStartIndex + (DimIndex * 2);
 
-			const float ClosestPoint = FMath::Clamp(CurrentInterpolatedPoseArray[DimIndex],
-			                                        OuterAABBArray[OuterAABBAtomIndex],
-			                                        OuterAABBArray[OuterAABBAtomIndex + 1]);
+				const float ClosestPoint = FMath::Clamp(QueryArray[DimIndex],
+				                                        OuterAABBArray[OuterAABBAtomIndex],
+				                                        OuterAABBArray[OuterAABBAtomIndex + 1]);
 
-			AABBCost += FMath::Abs(CurrentInterpolatedPoseArray[DimIndex] - ClosestPoint) * CalibrationArray[DimIndex - 1];
-		}
+				AABBCost += FMath::Abs(QueryArray[DimIndex] - ClosestPoint) * PassCalibrationArray[DimIndex - 1];
+			}
 
-		if(AABBCost < LowestCost)
-		{
-#if WITH_EDITORONLY_DATA	
-			++OuterAABBsPassed;
-#endif
+			if(AABBCost < LowestCost)
+			{
+	#if WITH_EDITORONLY_DATA	
+				++OuterAABBsPassed;
+	#endif
 			
-			//We need to search the inner AABBs
+				//We need to search the inner AABBs
 
-			const int32 InnerAABBStartIndex = OuterAABBIndex * 4;
-			const int32 InnerAABBEndIndex = FMath::Min(InnerAABBStartIndex + 4, FMath::CeilToInt32(MotionTagEndPoseIndex / 16.0f));
-			for(int32 InnerAABBIndex = InnerAABBStartIndex; InnerAABBIndex < InnerAABBEndIndex; ++InnerAABBIndex)
-			{
-#if WITH_EDITORONLY_DATA	
-				++InnerAABBsChecked;
-#endif
+				const int32 InnerAABBStartIndex = OuterAABBIndex * 4;
+				const int32 InnerAABBEndIndex = FMath::Min(InnerAABBStartIndex + 4, FMath::CeilToInt32(MotionTagEndPoseIndex / 16.0f));
+				for(int32 InnerAABBIndex = InnerAABBStartIndex; InnerAABBIndex < InnerAABBEndIndex; ++InnerAABBIndex)
+				{
+	#if WITH_EDITORONLY_DATA	
+					++InnerAABBsChecked;
+	#endif
 				
-				const int32 InnerAABBAtomStartIndex = InnerAABBIndex * AtomCount * 2;
+					const int32 InnerAABBAtomStartIndex = InnerAABBIndex * AtomCount * 2;
 
-				AABBCost = 0.0f;
-				for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
-				{
-					const int32 InnerAABBAtomIndex = InnerAABBAtomStartIndex + (DimIndex * 2);
+					AABBCost = 0.0f;
+					for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+					{
+						const int32 InnerAABBAtomIndex = InnerAABBAtomStartIndex + (DimIndex * 2);
 
-					const float ClosestPoint = FMath::Clamp(CurrentInterpolatedPoseArray[DimIndex],
-															InnerAABBArray[InnerAABBAtomIndex],
-															InnerAABBArray[InnerAABBAtomIndex + 1]);
+						const float ClosestPoint = FMath::Clamp(QueryArray[DimIndex],
+																InnerAABBArray[InnerAABBAtomIndex],
+																InnerAABBArray[InnerAABBAtomIndex + 1]);
 
-					AABBCost += FMath::Abs(CurrentInterpolatedPoseArray[DimIndex] - ClosestPoint) * CalibrationArray[DimIndex - 1];
-				}
+						AABBCost += FMath::Abs(QueryArray[DimIndex] - ClosestPoint) * PassCalibrationArray[DimIndex - 1];
+					}
 
-				if(AABBCost < LowestCost)
-				{
-#if WITH_EDITORONLY_DATA	
-					++InnerAABBsPassed;
-#endif
-					
-					const int32 StartPoseIndex = FMath::Max(InnerAABBIndex * 16, MotionTagStartPoseIndex);
-					const int32 EndPoseIndex = FMath::Min((InnerAABBIndex * 16) + 16, MotionTagEndPoseIndex);
-					for(int32 PoseIndex = StartPoseIndex; PoseIndex < EndPoseIndex; ++PoseIndex)
+					if(AABBCost < LowestCost)
 					{
-#if WITH_EDITORONLY_DATA	
-						++PosesChecked;
-#endif
+	#if WITH_EDITORONLY_DATA	
+						++InnerAABBsPassed;
+	#endif
+					
+						const int32 StartPoseIndex = FMath::Max(InnerAABBIndex * 16, MotionTagStartPoseIndex);
+						const int32 EndPoseIndex = FMath::Min((InnerAABBIndex * 16) + 16, MotionTagEndPoseIndex);
+						for(int32 PoseIndex = StartPoseIndex; PoseIndex < EndPoseIndex; ++PoseIndex)
+						{
+							if(bMirrorPass && !CurrentMotionData->IsSearchPoseMirrorable(PoseIndex))
+							{
+								continue;
+							}
+
+	#if WITH_EDITORONLY_DATA	
+							++PosesChecked;
+	#endif
 						
-						float Cost = 0.0f;
-						const int32 MatrixStartIndex = PoseIndex * AtomCount;
-						const float PoseFavour = PoseArray[MatrixStartIndex]; //Pose cost multiplier is the first atom of a pose array
+							float Cost = 0.0f;
+							const int32 MatrixStartIndex = PoseIndex * AtomCount;
+							const float PoseFavour = PoseArray[MatrixStartIndex]; //Pose cost multiplier is the first atom of a pose array
 						
-						for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
-						{
-							Cost += FMath::Abs(PoseArray[MatrixStartIndex + AtomIndex] - CurrentInterpolatedPoseArray[AtomIndex])
-									* CalibrationArray[AtomIndex - 1]; 
-						}
+							for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
+							{
+								Cost += FMath::Abs(PoseArray[MatrixStartIndex + AtomIndex] - QueryArray[AtomIndex])
+										* PassCalibrationArray[AtomIndex - 1]; 
+							}
 						
-						Cost *= PoseFavour;
-						if(Cost < LowestCost)
-						{
-							bNextNaturalChosen = false;
-							LowestCost = Cost;
-							LowestPoseId_SM = PoseIndex;
+							Cost *= PoseFavour;
+							if(Cost < LowestCost)
+							{
+								bNextNaturalChosen = false;
+								LowestCost = Cost;
+								LowestPoseId_SM = PoseIndex;
+								bOutMirrored = bMirrorPass;
+							}
 						}
 					}
 				}
@@ -801,8 +952,10 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_Standard()
 }
 
 /** HIGH QUALITY POSE SEARCH*/
-int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_HighQuality(const float DeltaTime)
+int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_HighQuality(const float DeltaTime, bool& bOutMirrored)
 {
+	bOutMirrored = bRuntimeMirrored;
+	
 	if(!GenerateCalibrationArray())
 	{
 		return CurrentChosenPoseId;
@@ -811,6 +964,10 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_HighQuality(const float De
 	TObjectPtr<const UMotionDataAsset> CurrentMotionData = GetMotionData();
 	const int32 AtomCount = CurrentMotionData->SearchPoseMatrix.AtomCount;
 	const TArray<float>& LookupPoseArray = CurrentMotionData->LookupPoseMatrix.PoseArray;
+
+	//The current animation is only stored un-mirrored so if it is mirrored at runtime it is compared with the mirrored query
+	const TArray<float>& CurrentQueryArray = bRuntimeMirrored ? MirroredPoseArray : CurrentInterpolatedPoseArray;
+	const TArray<float>& CurrentCalibrationArray = bRuntimeMirrored ? MirroredCalibrationArray : CalibrationArray;
 	
 	//Check cost of current pose first for "Favour Current Pose"
 	int32 LowestPoseId_LM = 0; //_LM stands for Lookup Matrix, _SM stands for Search Matrix
@@ -823,8 +980,8 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_HighQuality(const float De
 
 		for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
 		{
-			LowestCost += FMath::Abs(LookupPoseArray[PoseStartIndex + AtomIndex] - CurrentInterpolatedPoseArray[AtomIndex])
-				* CalibrationArray[AtomIndex - 1];
+			LowestCost += FMath::Abs(LookupPoseArray[PoseStartIndex + AtomIndex] - CurrentQueryArray[AtomIndex])
+				* CurrentCalibrationArray[AtomIndex - 1];
 		}
 		LowestCost *= PoseFavour;
 		LowestCost *= CurrentPoseFavour;
@@ -858,109 +1015,125 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostPoseId_HighQuality(const float De
 	const TArray<float>& OuterAABBArray = CurrentMotionData->PoseAABBMatrix_Outer.ExtentsArray;
 	const TArray<float>& InnerAABBArray = CurrentMotionData->PoseAABBMatrix_Inner.ExtentsArray;
 	const TArray<float>& PoseArray = CurrentMotionData->SearchPoseMatrix.PoseArray;
-	for(int32 OuterAABBIndex = OuterAABBStartIndex; OuterAABBIndex < OuterAABBEndIndex; ++OuterAABBIndex)
+
+	//The second search pass finds mirrored poses by comparing the un-mirrored poses against a mirrored query
+	const int32 SearchPassCount = CurrentMotionData->UsesRuntimeMirroring() ? 2 : 1;
+	for(int32 SearchPass = 0; SearchPass < SearchPassCount; ++SearchPass)
 	{
-#if WITH_EDITORONLY_DATA	
-		++OuterAABBsChecked;
-#endif
-		
-		const int32 OuterAABBAtomStartIndex = OuterAABBIndex * AtomCount * 2;
+		const bool bMirrorPass = SearchPass > 0;
+		const TArray<float>& QueryArray = bMirrorPass ? MirroredPoseArray : CurrentInterpolatedPoseArray;
+		const TArray<float>& PassCalibrationArray = bMirrorPass ? MirroredCalibrationArray : CalibrationArray;
 		
-		float AABBCost = 0.0f;
-		for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+		for(int32 OuterAABBIndex = OuterAABBStartIndex; OuterAABBIndex < OuterAABBEndIndex; ++OuterAABBIndex)
 		{
-			const int32 OuterAABBAtomIndex = OuterAABBAtomStartIndex + (DimIndex * 2);
+	#if WITH_EDITORONLY_DATA	
+			++OuterAABBsChecked;
+	#endif
+		
+			const int32 OuterAABBAtomStartIndex = OuterAABBIndex * AtomCount * 2;
+		
+			float AABBCost = 0.0f;
+			for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+			{
+				const int32 OuterAABBAtomIndex = OuterAABBAtomStartIndex + (DimIndex * 2);
 
-			const float ClosestPoint = FMath::Clamp(CurrentInterpolatedPoseArray[DimIndex],
-			                                        OuterAABBArray[OuterAABBAtomIndex],
-			                                        OuterAABBArray[OuterAABBAtomIndex + 1]);
+				const float ClosestPoint = FMath::Clamp(QueryArray[DimIndex],
+				                                        OuterAABBArray[OuterAABBAtomIndex],
+				                                        OuterAABBArray[OuterAABBAtomIndex + 1]);
 
-			AABBCost += FMath::Abs(CurrentInterpolatedPoseArray[DimIndex] - ClosestPoint) * CalibrationArray[DimIndex - 1];
-		}
+				AABBCost += FMath::Abs(QueryArray[DimIndex] - ClosestPoint) * PassCalibrationArray[DimIndex - 1];
+			}
 
-		if(AABBCost < LowestCost)
-		{
-#if WITH_EDITORONLY_DATA	
-			++OuterAABBsPassed;
-#endif
+			if(AABBCost < LowestCost)
+			{
+	#if WITH_EDITORONLY_DATA	
+				++OuterAABBsPassed;
+	#endif
 			
-			//We need to search the inner AABBs
+				//We need to search the inner AABBs
 
-			const int32 InnerAABBStartIndex = OuterAABBIndex * 4;
-			const int32 InnerAABBEndIndex = FMath::Min(InnerAABBStartIndex + 4, FMath::CeilToInt32(MotionTagEndPoseIndex / 16.0f));
-			for(int32 InnerAABBIndex = InnerAABBStartIndex; InnerAABBIndex < InnerAABBEndIndex; ++InnerAABBIndex)
-			{
-#if WITH_EDITORONLY_DATA	
-				++InnerAABBsChecked;
-#endif
+				const int32 InnerAABBStartIndex = OuterAABBIndex * 4;
+				const int32 InnerAABBEndIndex = FMath::Min(InnerAABBStartIndex + 4, FMath::CeilToInt32(MotionTagEndPoseIndex / 16.0f));
+				for(int32 InnerAABBIndex = InnerAABBStartIndex; InnerAABBIndex < InnerAABBEndIndex; ++InnerAABBIndex)
+				{
+	#if WITH_EDITORONLY_DATA	
+					++InnerAABBsChecked;
+	#endif
 				
-				const int32 InnerAABBAtomStartIndex = InnerAABBIndex * AtomCount * 2;
+					const int32 InnerAABBAtomStartIndex = InnerAABBIndex * AtomCount * 2;
 
-				AABBCost = 0.0f;
-				for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
-				{
-					const int32 InnerAABBAtomIndex = InnerAABBAtomStartIndex + (DimIndex * 2);
+					AABBCost = 0.0f;
+					for(int32 DimIndex = 1; DimIndex < AtomCount; ++DimIndex)
+					{
+						const int32 InnerAABBAtomIndex = InnerAABBAtomStartIndex + (DimIndex * 2);
 
-					const float ClosestPoint = FMath::Clamp(CurrentInterpolatedPoseArray[DimIndex],
-															InnerAABBArray[InnerAABBAtomIndex],
-															InnerAABBArray[InnerAABBAtomIndex + 1]);
+						const float ClosestPoint = FMath::Clamp(QueryArray[DimIndex],
+																InnerAABBArray[InnerAABBAtomIndex],
+																InnerAABBArray[InnerAABBAtomIndex + 1]);
 
-					AABBCost += FMath::Abs(CurrentInterpolatedPoseArray[DimIndex] - ClosestPoint) * CalibrationArray[DimIndex - 1];
-				}
+						AABBCost += FMath::Abs(QueryArray[DimIndex] - ClosestPoint) * PassCalibrationArray[DimIndex - 1];
+					}
 
-				if(AABBCost < LowestCost)
-				{
-#if WITH_EDITORONLY_DATA	
-					++InnerAABBsPassed;
-#endif
-					const float PoseInterval = CurrentMotionData->PoseInterval;
-					const float ResVelWeight = CurrentMotionData->MotionMatchConfig->ResultantVelocityWeight;
-					const int32 ResIndex = AtomCount - 12;
-					
-					const int32 StartPoseIndex = FMath::Max(InnerAABBIndex * 16, MotionTagStartPoseIndex);
-					const int32 EndPoseIndex = FMath::Min((InnerAABBIndex * 16) + 16, MotionTagEndPoseIndex);
-					for(int32 PoseIndex = StartPoseIndex; PoseIndex < EndPoseIndex; ++PoseIndex)
+					if(AABBCost < LowestCost)
 					{
-#if WITH_EDITORONLY_DATA	
-						++PosesChecked;
-#endif
-						
-						float Cost = 0.0f;
-						const int32 MatrixStartIndex = PoseIndex * AtomCount;
-						const float PoseFavour = PoseArray[MatrixStartIndex]; //Pose cost multiplier is the first atom of a pose array
-
-						/** Basic Cost Loop*/
-						for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
+	#if WITH_EDITORONLY_DATA	
+						++InnerAABBsPassed;
+	#endif
+						const float PoseInterval = CurrentMotionData->PoseInterval;
+						const float ResVelWeight = CurrentMotionData->MotionMatchConfig->ResultantVelocityWeight;
+						const int32 ResIndex = AtomCount - 12;
+					
+						const int32 StartPoseIndex = FMath::Max(InnerAABBIndex * 16, MotionTagStartPoseIndex);
+						const int32 EndPoseIndex = FMath::Min((InnerAABBIndex * 16) + 16, MotionTagEndPoseIndex);
+						for(int32 PoseIndex = StartPoseIndex; PoseIndex < EndPoseIndex; ++PoseIndex)
 						{
-							Cost += FMath::Abs(PoseArray[MatrixStartIndex + AtomIndex] - CurrentInterpolatedPoseArray[AtomIndex])
-									* CalibrationArray[AtomIndex - 1]; 
-						}
+							if(bMirrorPass && !CurrentMotionData->IsSearchPoseMirrorable(PoseIndex))
+							{
+								continue;
+							}
+
+	#if WITH_EDITORONLY_DATA	
+							++PosesChecked;
+	#endif
+						
+							float Cost = 0.0f;
+							const int32 MatrixStartIndex = PoseIndex * AtomCount;
+							const float PoseFavour = PoseArray[MatrixStartIndex]; //Pose cost multiplier is the first atom of a pose array
+
+							/** Basic Cost Loop*/
+							for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
+							{
+								Cost += FMath::Abs(PoseArray[MatrixStartIndex + AtomIndex] - QueryArray[AtomIndex])
+										* PassCalibrationArray[AtomIndex - 1]; 
+							}
 						
 
-						/** High Quality Cost Loop (I.e. Resultant Velocity Costing */
-						float ResVelX = CurrentInterpolatedPoseArray[ResIndex] - PoseArray[MatrixStartIndex + ResIndex] / DeltaTime;
-						float ResVelY = CurrentInterpolatedPoseArray[ResIndex+1] - PoseArray[MatrixStartIndex + ResIndex+1] / DeltaTime;
-						float ResVelZ = CurrentInterpolatedPoseArray[ResIndex+2] - PoseArray[MatrixStartIndex + ResIndex+2] / DeltaTime;
-
-						float ResVelCost = FMath::Abs(ResVelX - CurrentInterpolatedPoseArray[ResIndex + 3]) * CalibrationArray[ResIndex + 2];
-						ResVelCost += FMath::Abs(ResVelY - CurrentInterpolatedPoseArray[ResIndex + 4]) * CalibrationArray[ResIndex + 3];
-						ResVelCost +=	FMath::Abs(ResVelZ - CurrentInterpolatedPoseArray[ResIndex + 5]) * CalibrationArray[ResIndex + 4];
-
-						ResVelX = CurrentInterpolatedPoseArray[ResIndex+6] - PoseArray[MatrixStartIndex + ResIndex+6] / DeltaTime;
-						ResVelY = CurrentInterpolatedPoseArray[ResIndex+7] - PoseArray[MatrixStartIndex + ResIndex+7] / DeltaTime;
-						ResVelZ = CurrentInterpolatedPoseArray[ResIndex+8] - PoseArray[MatrixStartIndex + ResIndex+8] / DeltaTime;
-
-						ResVelCost += FMath::Abs(ResVelX - CurrentInterpolatedPoseArray[ResIndex + 9]) * CalibrationArray[ResIndex + 8];
-						ResVelCost += FMath::Abs(ResVelY - CurrentInterpolatedPoseArray[ResIndex + 10]) * CalibrationArray[ResIndex + 9];
-						ResVelCost +=	FMath::Abs(ResVelZ - CurrentInterpolatedPoseArray[ResIndex + 11]) * CalibrationArray[ResIndex + 10];
-
-						Cost += ResVelCost * ResVelWeight;
-						Cost *= PoseFavour;
-						if(Cost < LowestCost)
-						{
-							bNextNaturalChosen = false;
-							LowestCost = Cost;
-							LowestPoseId_SM = PoseIndex;
+							/** High Quality Cost Loop (I.e. Resultant Velocity Costing */
+							float ResVelX = QueryArray[ResIndex] - PoseArray[MatrixStartIndex + ResIndex] / DeltaTime;
+							float ResVelY = QueryArray[ResIndex+1] - PoseArray[MatrixStartIndex + ResIndex+1] / DeltaTime;
+							float ResVelZ = QueryArray[ResIndex+2] - PoseArray[MatrixStartIndex + ResIndex+2] / DeltaTime;
+
+							float ResVelCost = FMath::Abs(ResVelX - QueryArray[ResIndex + 3]) * PassCalibrationArray[ResIndex + 2];
+							ResVelCost += FMath::Abs(ResVelY - QueryArray[ResIndex + 4]) * PassCalibrationArray[ResIndex + 3];
+							ResVelCost +=	FMath::Abs(ResVelZ - QueryArray[ResIndex + 5]) * PassCalibrationArray[ResIndex + 4];
+
+							ResVelX = QueryArray[ResIndex+6] - PoseArray[MatrixStartIndex + ResIndex+6] / DeltaTime;
+							ResVelY = QueryArray[ResIndex+7] - PoseArray[MatrixStartIndex + ResIndex+7] / DeltaTime;
+							ResVelZ = QueryArray[ResIndex+8] - PoseArray[MatrixStartIndex + ResIndex+8] / DeltaTime;
+
+							ResVelCost += FMath::Abs(ResVelX - QueryArray[ResIndex + 9]) * PassCalibrationArray[ResIndex + 8];
+							ResVelCost += FMath::Abs(ResVelY - QueryArray[ResIndex + 10]) * PassCalibrationArray[ResIndex + 9];
+							ResVelCost +=	FMath::Abs(ResVelZ - QueryArray[ResIndex + 11]) * PassCalibrationArray[ResIndex + 10];
+
+							Cost += ResVelCost * ResVelWeight;
+							Cost *= PoseFavour;
+							if(Cost < LowestCost)
+							{
+								bNextNaturalChosen = false;
+								LowestCost = Cost;
+								LowestPoseId_SM = PoseIndex;
+								bOutMirrored = bMirrorPass;
+							}
 						}
 					}
 				}
@@ -986,8 +1159,8 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostNextNaturalId(int32 LowestPoseId_
 {
 	//Determine how many valid next naturals there are
 	const int32 NextNaturalStart = CurrentInterpolatedPose.PoseId;
-	const int32 NextNaturalEnd = FMath::Clamp(CurrentInterpolatedPose.PoseId + FMath::CeilToInt32(NextNaturalRange
-		/ InMotionData->PoseInterval), 0, InMotionData->Poses.Num() - 1);
+	const int32 NextNaturalEnd = FMath::Clamp(CurrentInterpolatedPose.PoseId + InMotionData->GetPoseCountInTimeSpan(
+		CurrentInterpolatedPose.PoseId, NextNaturalRange), 0, InMotionData->Poses.Num() - 1);
 	const int32 CurrentAnimId = CurrentInterpolatedPose.AnimId;
 	const EMotionAnimAssetType CurrentAnimType = CurrentInterpolatedPose.AnimType;
 
@@ -1008,6 +1181,8 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostNextNaturalId(int32 LowestPoseId_
 	
 	const int32 AtomCount = InMotionData->LookupPoseMatrix.AtomCount;
 	const TArray<float>& LookupPoseArray = InMotionData->LookupPoseMatrix.PoseArray;
+	const TArray<float>& CurrentQueryArray = bRuntimeMirrored ? MirroredPoseArray : CurrentInterpolatedPoseArray;
+	const TArray<float>& CurrentCalibrationArray = bRuntimeMirrored ? MirroredCalibrationArray : CalibrationArray;
 
 	const float FinalNextNaturalFavour = bFavourNextNatural ? NextNaturalFavour : 1.0f;
 
@@ -1018,8 +1193,8 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostNextNaturalId(int32 LowestPoseId_
 		const int32 MatrixStartIndex = PoseIndex * AtomCount;
 		for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
 		{
-			Cost += FMath::Abs(LookupPoseArray[MatrixStartIndex + AtomIndex] - CurrentInterpolatedPoseArray[AtomIndex])
-				* CalibrationArray[AtomIndex - 1];
+			Cost += FMath::Abs(LookupPoseArray[MatrixStartIndex + AtomIndex] - CurrentQueryArray[AtomIndex])
+				* CurrentCalibrationArray[AtomIndex - 1];
 		}
 
 		Cost *= LookupPoseArray[MatrixStartIndex] * FinalNextNaturalFavour;
@@ -1033,14 +1208,15 @@ int32 FAnimNode_MSMotionMatching::GetLowestCostNextNaturalId(int32 LowestPoseId_
 	return LowestPoseId_LM;
 }
 
-void FAnimNode_MSMotionMatching::TransitionToPose(const int32 PoseId, const FAnimationUpdateContext& Context, const float TimeOffset /*= 0.0f*/)
+void FAnimNode_MSMotionMatching::TransitionToPose(const int32 PoseId, const FAnimationUpdateContext& Context, const float TimeOffset /*= 0.0f*/,
+	const bool bInRuntimeMirrored /*= false*/)
 {
 	switch (TransitionMethod)
 	{
-		case ETransitionMethod::None: { JumpToPose(PoseId, TimeOffset); } break;
+		case ETransitionMethod::None: { JumpToPose(PoseId, TimeOffset, bInRuntimeMirrored); } break;
 		case ETransitionMethod::Inertialization:
 		{
-			JumpToPose(PoseId, TimeOffset);
+			JumpToPose(PoseId, TimeOffset, bInRuntimeMirrored);
 				
 			UE::Anim::IInertializationRequester* InertializationRequester = Context.GetMessage<UE::Anim::IInertializationRequester>();
 			if (InertializationRequester)
@@ -1058,13 +1234,19 @@ void FAnimNode_MSMotionMatching::TransitionToPose(const int32 PoseId, const FAni
 	}
 }
 
-void FAnimNode_MSMotionMatching::JumpToPose(const int32 PoseIdDatabase, const float TimeOffset /*= 0.0f */)
+void FAnimNode_MSMotionMatching::JumpToPose(const int32 PoseIdDatabase, const float TimeOffset /*= 0.0f */,
+	const bool bInRuntimeMirrored /*= false*/)
 {
 	TimeSinceMotionChosen = TimeSinceMotionUpdate;
 	CurrentChosenPoseId = PoseIdDatabase;
 
 	TObjectPtr<const UMotionDataAsset> CurrentMotionData = GetMotionData();
 	const FPoseMotionData& Pose = CurrentMotionData->Poses[PoseIdDatabase];
+	bRuntimeMirrored = bInRuntimeMirrored && CurrentMotionData->UsesRuntimeMirroring();
+	const bool bMirrored = Pose.bMirrored || bRuntimeMirrored;
+
+	//Keep the notify buffer's allocation when the channel state is replaced
+	TArray<FAnimNotifyEventReference> NotifyScratch = MoveTemp(MMAnimState.NotifyScratch);
 
 	switch (Pose.AnimType)
 	{
@@ -1079,7 +1261,7 @@ void FAnimNode_MSMotionMatching::JumpToPose(const int32 PoseIdDatabase, const fl
 			}
 
 			MMAnimState = FAnimChannelState(Pose, MotionAnim->Sequence->GetPlayLength(), MotionAnim->bLoop,
-				MotionAnim->PlayRate, Pose.bMirrored, TimeSinceMotionChosen, TimeOffset);
+				MotionAnim->PlayRate, bMirrored, TimeSinceMotionChosen, TimeOffset);
 
 		} break;
 		//Blend Space Pose
@@ -1093,7 +1275,7 @@ void FAnimNode_MSMotionMatching::JumpToPose(const int32 PoseIdDatabase, const fl
 			}
 
 			MMAnimState = FAnimChannelState(Pose, MotionBlendSpace->GetPlayLength(), MotionBlendSpace->bLoop,
-				MotionBlendSpace->PlayRate, Pose.bMirrored, TimeSinceMotionChosen, TimeOffset);
+				MotionBlendSpace->PlayRate, bMirrored, TimeSinceMotionChosen, TimeOffset);
 				
 			MotionBlendSpace->BlendSpace->GetSamplesFromBlendInput(FVector(
 				Pose.BlendSpacePosition.X, Pose.BlendSpacePosition.Y, 0.0f),
@@ -1111,10 +1293,12 @@ void FAnimNode_MSMotionMatching::JumpToPose(const int32 PoseIdDatabase, const fl
 			}
 
 			MMAnimState = FAnimChannelState(Pose, MotionComposite->AnimComposite->GetPlayLength(),
-				MotionComposite->bLoop, MotionComposite->PlayRate, Pose.bMirrored, TimeSinceMotionChosen, TimeOffset);
+				MotionComposite->bLoop, MotionComposite->PlayRate, bMirrored, TimeSinceMotionChosen, TimeOffset);
 		} break;
 		default: ; 
 	}
+
+	MMAnimState.NotifyScratch = MoveTemp(NotifyScratch);
 }
 
 TObjectPtr<const UMotionDataAsset> FAnimNode_MSMotionMatching::GetMotionData() const
@@ -1129,6 +1313,24 @@ TObjectPtr<const UMotionCalibration> FAnimNode_MSMotionMatching::GetUserCalibrat
 	//return GET_ANIM_NODE_DATA(TObjectPtr<UMotionCalibration>, UserCalibration);
 }
 
+EMotionMatchingPlaybackMode FAnimNode_MSMotionMatching::GetPlaybackMode(const FAnimInstanceProxy* InAnimInstanceProxy) const
+{
+	if(bSearchOnlyOnDedicatedServer && IsRunningDedicatedServer())
+	{
+		return EMotionMatchingPlaybackMode::SearchOnly;
+	}
+
+	if(PlaybackMode == EMotionMatchingPlaybackMode::Full
+		&& RootMotionOnlyLODThreshold > INDEX_NONE
+		&& InAnimInstanceProxy
+		&& InAnimInstanceProxy->GetLODLevel() >= RootMotionOnlyLODThreshold)
+	{
+		return EMotionMatchingPlaybackMode::RootMotionOnly;
+	}
+
+	return PlaybackMode;
+}
+
 UMirrorDataTable* FAnimNode_MSMotionMatching::GetMirrorDataTable() const
 {
 	if(const TObjectPtr<const UMotionDataAsset> ThisMotionData = GetMotionData())
@@ -1168,13 +1370,18 @@ void FAnimNode_MSMotionMatching::CheckValidToEvaluate(const FAnimInstanceProxy*
 	{
 		const int32 PoseArraySize = CurrentMotionData->SearchPoseMatrix.AtomCount;
 
-		CurrentInterpolatedPose = FPoseMotionData();
+		CurrentInterpolatedPose = FRuntimePoseData();
 		CurrentInterpolatedPoseArray.Empty(PoseArraySize + 1);
 		CalibrationArray.Empty(PoseArraySize + 1);
 
 		CurrentInterpolatedPoseArray.SetNumZeroed(PoseArraySize);
 		InputData.DesiredInputArray.SetNumZeroed(PoseArraySize);
 		CalibrationArray.SetNumZeroed(PoseArraySize);
+
+		bRuntimeMirrored = false;
+		MirroredPoseArray.SetNumZeroed(PoseArraySize);
+		MirroredCalibrationArray.SetNumZeroed(PoseArraySize);
+		MirroredDesiredInputArray.SetNumZeroed(PoseArraySize);
 	}
 	else
 	{
@@ -1202,17 +1409,13 @@ void FAnimNode_MSMotionMatching::CheckValidToEvaluate(const FAnimInstanceProxy*
 		}
 	}
 
-	FinalCalibrationSets.Empty(CurrentMotionData->FeatureStandardDeviations.Num() + 1);
-	for (auto& FeatureStdDev : CurrentMotionData->FeatureStandardDeviations)
-	{
-		FinalCalibrationSets.Emplace(FCalibrationData());
-		FinalCalibrationSets.Last().GenerateFinalWeights(MMConfig, FeatureStdDev);
-	}
-	
 	if (UserCalibration)
 	{
 		UserCalibration->ValidateData(MMConfig, false);
 	}
+
+	//Shared runtime data is acquired on the first search so that the user calibration has been initialized
+	RuntimeData.Reset();
 	
 	JumpToPose(0);
 	if (const UAnimSequenceBase* Sequence = GetPrimaryAnim())
@@ -1278,13 +1481,14 @@ bool FAnimNode_MSMotionMatching::NextPoseToleranceTest(const FPoseMotionData& Ne
 
 	TObjectPtr<const UMotionDataAsset> CurrentMotionData = GetMotionData();
 	const int32 NextPoseStartIndex = NextPose.PoseId * CurrentMotionData->LookupPoseMatrix.AtomCount;
+	const TArray<float>& DesiredInputArray = bRuntimeMirrored ? MirroredDesiredInputArray : InputData.DesiredInputArray;
 
 	int32 FeatureOffset = 1; //Start with offset one because we don't use the pose favour for next pose tolerance test
 	for(const TObjectPtr<UMatchFeatureBase> Feature : CurrentMotionData->MotionMatchConfig->Features)
 	{
 		if(Feature->PoseCategory == EPoseCategory::Responsiveness)
 		{
-			if(!Feature->NextPoseToleranceTest(InputData.DesiredInputArray, CurrentMotionData->LookupPoseMatrix.PoseArray,
+			if(!Feature->NextPoseToleranceTest(DesiredInputArray, CurrentMotionData->LookupPoseMatrix.PoseArray,
 				NextPoseStartIndex + FeatureOffset, FeatureOffset, PositionTolerance, RotationTolerance))
 			{
 				return false;
@@ -1316,105 +1520,64 @@ void FAnimNode_MSMotionMatching::ApplyTrajectoryBlending()
 bool FAnimNode_MSMotionMatching::GenerateCalibrationArray()
 {
 	TObjectPtr<const UMotionDataAsset> CurrentMotionData = GetMotionData();
-	const int32 CalibrationIndex = CurrentMotionData->GetMotionTagIndex(RequiredMotionTags);
+	TObjectPtr<const UMotionCalibration> OverrideMotionCalibration = GetUserCalibration();
+
+	if(!RuntimeData.IsValid()
+		|| RuntimeData->IsStale()
+		|| !RuntimeData->IsBuiltFrom(CurrentMotionData, OverrideMotionCalibration))
+	{
+		RuntimeData = FMotionMatchingRuntimeData::FindOrCreate(CurrentMotionData, OverrideMotionCalibration);
 
+		if(!RuntimeData.IsValid())
+		{
+			return false;
+		}
+	}
+	
+	const int32 CalibrationIndex = CurrentMotionData->GetMotionTagIndex(RequiredMotionTags);
 	if(CalibrationIndex < 0
-		|| CalibrationIndex >= FinalCalibrationSets.Num())
+		|| CalibrationIndex >= RuntimeData->CalibrationSets.Num())
 	{
 		return false;
 	}
-	
-	const float OverrideQualityMultiplier = (1.0f - OverrideQualityVsResponsivenessRatio) * 2.0f;
-	const float OverrideResponseMultiplier = OverrideQualityVsResponsivenessRatio * 2.0f;
-	CalibrationArray = FinalCalibrationSets[CalibrationIndex].Weights;
-	
-	int32 AtomIndex = 0;
-	if(TObjectPtr<const UMotionCalibration> OverrideMotionCalibration = GetUserCalibration())
+
+	//The user calibration is already folded into the shared weights so only the node override remains to be applied
+	const TArray<float>& SharedCalibration = RuntimeData->CalibrationSets[CalibrationIndex];
+	const bool bMirrorCalibration = RuntimeData->MirroredCalibrationSets.IsValidIndex(CalibrationIndex);
+	const int32 AtomCount = SharedCalibration.Num();
+	CalibrationArray.SetNumUninitialized(AtomCount, false);
+	MirroredCalibrationArray.SetNumUninitialized(AtomCount, false);
+
+	if(FMath::IsNearlyEqual(OverrideQualityVsResponsivenessRatio, 0.5f))
 	{
-		if(OverrideMotionCalibration->CalibrationType == EMotionCalibrationType::Multiplier)
-		{
-			//Apply Multiplier Calibration
-			for(TObjectPtr<UMatchFeatureBase> FeaturePtr : CurrentMotionData->MotionMatchConfig->Features)
-			{
-				const UMatchFeatureBase* Feature = FeaturePtr.Get();
-				const int32 FeatureSize = Feature->Size();
+		FMemory::Memcpy(CalibrationArray.GetData(), SharedCalibration.GetData(), AtomCount * sizeof(float));
 
-				if(Feature->PoseCategory == EPoseCategory::Quality)
-				{
-					for(int32 i = 0; i < FeatureSize; ++i)
-					{
-						CalibrationArray[AtomIndex] *= OverrideMotionCalibration->AdjustedCalibrationArray[AtomIndex]
-							* OverrideQualityMultiplier;
-						
-						++AtomIndex;
-					}
-				}
-				else
-				{
-					for(int32 i = 0; i < FeatureSize; ++i)
-					{
-						CalibrationArray[AtomIndex] *= OverrideMotionCalibration->AdjustedCalibrationArray[AtomIndex]
-							* OverrideResponseMultiplier;
-						
-						++AtomIndex;
-					}
-				}
-			}
-		}
-		else
+		if(bMirrorCalibration)
 		{
-			//Apply Override Calibration
-			TArray<float> NormalizerArray = CurrentMotionData->FeatureStandardDeviations[CalibrationIndex].Weights;
-			for(TObjectPtr<UMatchFeatureBase> FeaturePtr : CurrentMotionData->MotionMatchConfig->Features)
-			{
-				const UMatchFeatureBase* Feature = FeaturePtr.Get();
-				const int32 FeatureSize = Feature->Size();
-
-				if(Feature->PoseCategory == EPoseCategory::Quality)
-				{
-					for(int32 i = 0; i < FeatureSize; ++i)
-					{
-						CalibrationArray[AtomIndex] = NormalizerArray[AtomIndex] *
-							OverrideMotionCalibration->AdjustedCalibrationArray[AtomIndex] * OverrideQualityMultiplier;
-						++AtomIndex;
-					}
-				}
-				else
-				{
-					for(int32 i = 0; i < FeatureSize; ++i)
-					{
-						CalibrationArray[AtomIndex] = NormalizerArray[AtomIndex] *
-							OverrideMotionCalibration->AdjustedCalibrationArray[AtomIndex] * OverrideResponseMultiplier;
-						++AtomIndex;
-					}
-				}
-			}
+			FMemory::Memcpy(MirroredCalibrationArray.GetData(), RuntimeData->MirroredCalibrationSets[CalibrationIndex].GetData(),
+				AtomCount * sizeof(float));
 		}
+		
+		return true;
 	}
-	else
+	
+	const float OverrideQualityMultiplier = (1.0f - OverrideQualityVsResponsivenessRatio) * 2.0f;
+	const float OverrideResponseMultiplier = OverrideQualityVsResponsivenessRatio * 2.0f;
+	const TBitArray<>& QualityAtomMask = RuntimeData->QualityAtomMask;
+	for(int32 AtomIndex = 0; AtomIndex < AtomCount; ++AtomIndex)
 	{
-		//No Override Motion Calibration used
-		for(TObjectPtr<UMatchFeatureBase> FeaturePtr : CurrentMotionData->MotionMatchConfig->Features)
-		{
-			const UMatchFeatureBase* Feature = FeaturePtr.Get();
-			const int32 FeatureSize = Feature->Size();
+		CalibrationArray[AtomIndex] = SharedCalibration[AtomIndex]
+			* (QualityAtomMask[AtomIndex] ? OverrideQualityMultiplier : OverrideResponseMultiplier);
+	}
 
-			if(Feature->PoseCategory == EPoseCategory::Quality)
-			{
-				for(int32 i = 0; i < FeatureSize; ++i)
-				{
-					CalibrationArray[AtomIndex] *= OverrideQualityMultiplier;
-					++AtomIndex;
-				}
-			}
-			else
-			{
-				for(int32 i = 0; i < FeatureSize; ++i)
-				{
-					CalibrationArray[AtomIndex] *= OverrideResponseMultiplier;
-					++AtomIndex;
-				}
-			}
+	if(bMirrorCalibration)
+	{
+		//Mirror counterparts share a pose category so the same mask applies to the permuted weights
+		const TArray<float>& SharedMirroredCalibration = RuntimeData->MirroredCalibrationSets[CalibrationIndex];
+		for(int32 AtomIndex = 0; AtomIndex < AtomCount; ++AtomIndex)
+		{
+			MirroredCalibrationArray[AtomIndex] = SharedMirroredCalibration[AtomIndex]
+				* (QualityAtomMask[AtomIndex] ? OverrideQualityMultiplier : OverrideResponseMultiplier);
 		}
 	}
 	
@@ -1535,10 +1698,12 @@ void FAnimNode_MSMotionMatching::UpdateAssetPlayer(const FAnimationUpdateContext
 
 		
 		InitializeWithPoseRecorder(Context);
+		InitializeInputProvider(Context);
 		bInitialized = true;
 	}
 	
 	UpdateMotionMatchingState(DeltaTime, Context);
+	UpdatePlaybackModeState(Context.AnimInstanceProxy);
 	CreateTickRecordForNode(Context, PlaybackRate * MMAnimState.PlayRate);
 
 #if ENABLE_ANIM_DEBUG && ENABLE_DRAW_DEBUG
@@ -1592,7 +1757,8 @@ void FAnimNode_MSMotionMatching::Evaluate_AnyThread(FPoseContext& Output)
 	if (!CurrentMotionData 
 	|| !bValidToEvaluate
 	|| !CurrentMotionData->bIsProcessed
-	|| !IsLODEnabled(Output.AnimInstanceProxy))
+	|| !IsLODEnabled(Output.AnimInstanceProxy)
+	|| GetPlaybackMode(Output.AnimInstanceProxy) != EMotionMatchingPlaybackMode::Full)
 	{
 		Output.ResetToRefPose();
 	}
@@ -1697,17 +1863,23 @@ void FAnimNode_MSMotionMatching::EvaluateSinglePose(FPoseContext& Output)
 	const UMirrorDataTable* MirrorTable = CurrentMotionData->MirrorDataTable;
 	if (MMAnimState.bMirrored && MirrorTable)
 	{
-		const FBoneContainer BoneContainer = Output.Pose.GetBoneContainer();
-		const TArray<FBoneIndexType>& RequiredBoneIndices = BoneContainer.GetBoneIndicesArray();
-		const int32 NumReqBones = RequiredBoneIndices.Num();
-		if(CompactPoseMirrorBones.Num() != NumReqBones)
+		//The map is normally acquired in CacheBones. This only catches evaluation before bones were cached for this LOD
+		const FBoneContainer& BoneContainer = Output.Pose.GetBoneContainer();
+		if(!MirrorBoneMap.IsValid()
+			|| MirrorBoneMap->CompactPoseMirrorBones.Num() != BoneContainer.GetBoneIndicesArray().Num())
 		{
 			FillCompactPoseAndComponentRefRotations(BoneContainer);
 		}
+
+		if(!MirrorBoneMap.IsValid())
+		{
+			return;
+		}
 		
-		FAnimationRuntime::MirrorPose(Output.Pose, MirrorTable->MirrorAxis, CompactPoseMirrorBones, ComponentSpaceRefRotations);
+		FAnimationRuntime::MirrorPose(Output.Pose, MirrorTable->MirrorAxis, MirrorBoneMap->CompactPoseMirrorBones,
+			MirrorBoneMap->ComponentSpaceRefRotations);
 		FAnimationRuntime::MirrorCurves(Output.Curve, *MirrorTable);
-		UE::Anim::Attributes::MirrorAttributes(Output.CustomAttributes, *MirrorTable, CompactPoseMirrorBones);
+		UE::Anim::Attributes::MirrorAttributes(Output.CustomAttributes, *MirrorTable, MirrorBoneMap->CompactPoseMirrorBones);
 	}
 }
 
@@ -1940,7 +2112,7 @@ void FAnimNode_MSMotionMatching::DrawAnimDebug(FAnimInstanceProxy* InAnimInstanc
 	FString Message = FString::Printf(TEXT("Pose Id: %02d \nPoseFavour: %f \nMirrored: "),
 		CurrentPose.PoseId, CurrentMotionData->GetPoseFavour(CurrentPose.PoseId));
 	
-	if(CurrentPose.bMirrored)
+	if(CurrentPose.bMirrored || bRuntimeMirrored)
 	{
 		Message += FString(TEXT("True\n"));
 	}
@@ -2018,14 +2190,10 @@ void FAnimNode_MSMotionMatching::FillCompactPoseAndComponentRefRotations(const F
 {
 	if(const UMirrorDataTable* MirrorDataTable = GetMirrorDataTable())
 	{
-		MirrorDataTable->FillCompactPoseAndComponentRefRotations(
-			BoneContainer,
-			CompactPoseMirrorBones,
-			ComponentSpaceRefRotations);
+		MirrorBoneMap = FMirrorBoneMap::FindOrCreate(MirrorDataTable, BoneContainer);
 	}
 	else
 	{
-		CompactPoseMirrorBones.Reset();
-		ComponentSpaceRefRotations.Reset();
+		MirrorBoneMap.Reset();
 	}
 }
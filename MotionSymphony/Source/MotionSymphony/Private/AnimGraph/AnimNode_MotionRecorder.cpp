@@ -3,6 +3,7 @@
 #include "AnimGraph/AnimNode_MotionRecorder.h"
 #include "Animation/Skeleton.h"
 #include "Animation/AnimInstanceProxy.h"
+#include "BoneContainer.h"
 #include "DrawDebugHelpers.h"
 #include "MotionMatchConfig.h"
 
@@ -23,6 +24,13 @@ static TAutoConsoleVariable<int32> CVarMotionSnapshotEnable(
 	TEXT("<=0: Off \n")
 	TEXT("  1: On\n"));
 
+static TAutoConsoleVariable<int32> CVarMotionSnapshotLazyExtraction(
+	TEXT("a.AnimNode.MoSymph.MotionSnapshot.LazyExtraction"),
+	1,
+	TEXT("Turns extraction of motion snapshot features only on frames requested by a search On / Off.\n")
+	TEXT("<=0: Off - Extract every frame \n")
+	TEXT("  1: On\n"));
+
 IMPLEMENT_ANIMGRAPH_MESSAGE(IMotionSnapper);
 const FName IMotionSnapper::Attribute("MotionSnapshot");
 
@@ -64,10 +72,18 @@ private:
 
 
 FMotionRecordData::FMotionRecordData()
+	: bExtractOnRequest(false),
+	bSnapshotRequested(false),
+	bConsumerUpdated(false),
+	bSnapshotCurrent(false)
 {
 }
 
 FMotionRecordData::FMotionRecordData(UMotionMatchConfig* InMotionMatchConfig)
+	: bExtractOnRequest(false),
+	bSnapshotRequested(false),
+	bConsumerUpdated(false),
+	bSnapshotCurrent(false)
 {
 	if(!InMotionMatchConfig)
 	{
@@ -81,6 +97,98 @@ FMotionRecordData::FMotionRecordData(UMotionMatchConfig* InMotionMatchConfig)
 	FeatureCacheData.SetNumZeroed(InMotionMatchConfig->TotalDimensionCount);
 }
 
+FMotionRecorderBoneChain::FMotionRecorderBoneChain()
+	: CompactBoneCount(INDEX_NONE)
+{
+}
+
+void FMotionRecorderBoneChain::Build(const FBoneContainer& BoneContainer, const TArray<TObjectPtr<UMotionMatchConfig>>& InMotionConfigs)
+{
+	Asset = BoneContainer.GetAsset();
+	CompactBoneCount = BoneContainer.GetCompactPoseNumBones();
+	CompactBoneIndices.Reset();
+	InverseCompactRefPose.Reset();
+	SkeletonRefPose.Reset();
+
+	TBitArray<> ChainBones(false, CompactBoneCount);
+	bool bAllBonesRequired = false;
+	for(const TObjectPtr<UMotionMatchConfig> MotionConfig : InMotionConfigs)
+	{
+		if(!MotionConfig || bAllBonesRequired)
+		{
+			continue;
+		}
+		
+		for(const TObjectPtr<UMatchFeatureBase> Feature : MotionConfig->Features)
+		{
+			if(!Feature
+				|| Feature->PoseCategory != EPoseCategory::Quality
+				|| !Feature->UsesRuntimePose())
+			{
+				continue;
+			}
+
+			const FName BoneName = Feature->GetFeatureBoneName();
+			if(BoneName.IsNone())
+			{
+				//The feature reads bones that it does not report so the whole pose must be prepared
+				bAllBonesRequired = true;
+				break;
+			}
+
+			FBoneReference BoneReference(BoneName);
+			BoneReference.Initialize(BoneContainer);
+
+			//Walk up the hierarchy until a bone that is already part of the chain is reached
+			FCompactPoseBoneIndex BoneIndex = BoneReference.GetCompactPoseIndex(BoneContainer);
+			while(BoneIndex.IsValid() && !ChainBones[BoneIndex.GetInt()])
+			{
+				ChainBones[BoneIndex.GetInt()] = true;
+				BoneIndex = BoneContainer.GetParentBoneIndex(BoneIndex);
+			}
+		}
+	}
+
+	if(bAllBonesRequired)
+	{
+		ChainBones.Init(true, CompactBoneCount);
+	}
+
+	const USkeleton* Skeleton = BoneContainer.GetSkeletonAsset();
+	if(!Skeleton)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Motion recorder could not cache the bone chains because the bone container has no skeleton."));
+		return;
+	}
+	
+	const TArray<FTransform>& RefSkeletonRefPose = Skeleton->GetReferenceSkeleton().GetRefBonePose();
+	
+	//Compact pose indices are ordered parents first so iterating the set bits keeps the chain ordered
+	for(TConstSetBitIterator<> BoneIt(ChainBones); BoneIt; ++BoneIt)
+	{
+		const FCompactPoseBoneIndex BoneIndex(BoneIt.GetIndex());
+		const int32 SkeletonPoseIndex = BoneContainer.GetSkeletonPoseIndexFromCompactPoseIndex(BoneIndex).GetInt();
+
+		CompactBoneIndices.Add(BoneIndex);
+		if(RefSkeletonRefPose.IsValidIndex(SkeletonPoseIndex))
+		{
+			InverseCompactRefPose.Add(BoneContainer.GetRefPoseTransform(BoneIndex).Inverse());
+			SkeletonRefPose.Add(RefSkeletonRefPose[SkeletonPoseIndex]);
+		}
+		else
+		{
+			InverseCompactRefPose.Add(FTransform::Identity);
+			SkeletonRefPose.Add(FTransform::Identity);
+		}
+	}
+}
+
+bool FMotionRecorderBoneChain::IsValidFor(const FBoneContainer& BoneContainer) const
+{
+	return CompactBoneCount == BoneContainer.GetCompactPoseNumBones()
+		&& Asset.Get() == BoneContainer.GetAsset();
+}
+
 FAnimNode_MotionRecorder::FAnimNode_MotionRecorder()
 	: bRetargetPose(true),
       PoseDeltaTime(0),
@@ -157,11 +265,31 @@ int32 FAnimNode_MotionRecorder::RegisterMotionMatchConfig(UMotionMatchConfig* In
 
 	MotionRecorderData.Add(FMotionRecordData(CopyConfig));
 
+	//The bone chains depend on the features of every registered config
+	LODBoneChains.Reset();
 	CacheMotionBones(AnimInstanceProxy);
 
 	return MotionConfigs.Num() - 1;
 }
 
+void FAnimNode_MotionRecorder::RequestSnapshot(const int32 ConfigIndex, const bool bExtract)
+{
+	if(!MotionRecorderData.IsValidIndex(ConfigIndex))
+	{
+		return;
+	}
+
+	FMotionRecordData& MotionRecord = MotionRecorderData[ConfigIndex];
+	MotionRecord.bExtractOnRequest = true;
+	MotionRecord.bConsumerUpdated = true;
+	MotionRecord.bSnapshotRequested |= bExtract;
+}
+
+bool FAnimNode_MotionRecorder::IsSnapshotCurrent(const int32 ConfigIndex) const
+{
+	return MotionRecorderData.IsValidIndex(ConfigIndex) && MotionRecorderData[ConfigIndex].bSnapshotCurrent;
+}
+
 void FAnimNode_MotionRecorder::LogRequestError(const FAnimationUpdateContext& Context, const FPoseLinkBase& RequesterPoseLink)
 {
 #if WITH_EDITORONLY_DATA
@@ -196,6 +324,7 @@ void FAnimNode_MotionRecorder::OnInitializeAnimInstance(const FAnimInstanceProxy
 		}
 	}
 	
+	LODBoneChains.Reset();
 	CacheMotionBones(InProxy);
 }
 
@@ -242,6 +371,26 @@ void FAnimNode_MotionRecorder::CacheMotionBones(const FAnimInstanceProxy* InProx
 			}
 		}
 	}
+
+	FindOrCacheBoneChain(InProxy);
+}
+
+const FMotionRecorderBoneChain& FAnimNode_MotionRecorder::FindOrCacheBoneChain(const FAnimInstanceProxy* InProxy)
+{
+	const FBoneContainer& BoneContainer = InProxy->GetRequiredBones();
+	const int32 LODIndex = FMath::Max(0, InProxy->GetLODLevel());
+	if(LODIndex >= LODBoneChains.Num())
+	{
+		LODBoneChains.SetNum(LODIndex + 1);
+	}
+
+	FMotionRecorderBoneChain& BoneChain = LODBoneChains[LODIndex];
+	if(!BoneChain.IsValidFor(BoneContainer))
+	{
+		BoneChain.Build(BoneContainer, CopyConfigs);
+	}
+
+	return BoneChain;
 }
 
 void FAnimNode_MotionRecorder::Update_AnyThread(const FAnimationUpdateContext& Context)
@@ -262,69 +411,79 @@ void FAnimNode_MotionRecorder::Evaluate_AnyThread(FPoseContext& Output)
 
 	Source.Evaluate(Output);
 
-	FComponentSpacePoseContext CS_Output(Output.AnimInstanceProxy);
+	const bool bLazyExtraction = CVarMotionSnapshotLazyExtraction.GetValueOnAnyThread() > 0;
+	const int32 ConfigIterations = FMath::Min(CopyConfigs.Num(), MotionRecorderData.Num());
 
-	if (bRetargetPose)
+	//Only convert the pose to component space if a config will be extracted or has features that track bone history
+	bool bNeedsComponentSpacePose = false;
+	for(int32 ConfigIndex = 0; ConfigIndex < ConfigIterations && !bNeedsComponentSpacePose; ++ConfigIndex)
 	{
-		//Create a new retargeted pose, initialize it from our current pose
-		FCompactPose RetargetedPose(Output.Pose);
-
-		//Pull the bones out so we can use them directly
-		TArray<FTransform> RetargetedToBase;
-		RetargetedPose.CopyBonesTo(RetargetedToBase); //The actual current Pose which is additive to the reference pose of the current skeleton 
-		const TArray<FTransform>& CompactRefPose = RetargetedPose.GetBoneContainer().GetRefPoseArray();
-		
-		const TArray<FTransform>& RefSkeletonRefPose = Output.AnimInstanceProxy->GetSkeleton()->GetReferenceSkeleton().GetRefBonePose();	//The reference pose of the reference skeleton
-
-		for (int32 i = 0; i < FMath::Min(CompactRefPose.Num(), RetargetedToBase.Num()); ++i)
+		const FMotionRecordData& MotionRecord = MotionRecorderData[ConfigIndex];
+		const UMotionMatchConfig* MotionConfig = CopyConfigs[ConfigIndex];
+		if(!MotionConfig)
 		{
-			FTransform& RetargetBoneTransform = RetargetedToBase[i];											//The actual current bone transform					
-			//const FTransform& ModelBoneTransform = CompactRefPose[i];												//The bone transform of the reference pose (current skeleton)
-			
-			const int32 SkeletonPoseIndex = Output.Pose.GetBoneContainer().GetSkeletonPoseIndexFromMeshPoseIndex(FMeshPoseBoneIndex(i)).GetInt(); //Todo:: Test if this is even correct
-			//const FTransform& RefSkeletonBoneTransform = RefSkeletonRefPose[SkeletonPoseIndex];
-
-			//FTransform BoneTransform;
-
-			//(ActualBone / RefPoseBone) * RefSkelRefPoseBone			[For Rotation & Scale]
-			//(ActualBone - RePoseBone) + RefSkelRefPoseBone			[For Translation]
-
-			/*RetargetBoneTransform.SetRotation(RefSkeletonBoneTransform.GetRotation() * ModelBoneTransform.GetRotation().Inverse() *  RetargetBoneTransform.GetRotation());
-			RetargetBoneTransform.SetTranslation(RetargetBoneTransform.GetTranslation() - ModelBoneTransform.GetTranslation() + RefSkeletonBoneTransform.GetTranslation());
-			RetargetBoneTransform.SetScale3D(RetargetBoneTransform.GetScale3D() * ModelBoneTransform.GetSafeScaleReciprocal(ModelBoneTransform.GetScale3D() * (RefSkeletonBoneTransform.GetScale3D())));*/
-
-			RetargetedToBase[i] = (RetargetedToBase[i] * CompactRefPose[i].Inverse()) * RefSkeletonRefPose[SkeletonPoseIndex];
-			RetargetBoneTransform.NormalizeRotation();
+			continue;
 		}
 
-		//Set the bones back
-		RetargetedPose.CopyBonesFrom(RetargetedToBase);
+		if(!bLazyExtraction
+			|| !MotionRecord.bExtractOnRequest
+			|| !MotionRecord.bConsumerUpdated
+			|| MotionRecord.bSnapshotRequested)
+		{
+			bNeedsComponentSpacePose = true;
+			break;
+		}
 
-		//Convert pose to component space
-		CS_Output.Pose.InitPose(RetargetedPose);
+		for(const TObjectPtr<UMatchFeatureBase> Feature : MotionConfig->Features)
+		{
+			if(Feature->PoseCategory == EPoseCategory::Quality
+				&& Feature->HasRuntimeHistory()
+				&& Feature->RuntimeHistoryNeedsPose())
+			{
+				bNeedsComponentSpacePose = true;
+				break;
+			}
+		}
 	}
-	else
+
+	FComponentSpacePoseContext CS_Output(Output.AnimInstanceProxy);
+	if(bNeedsComponentSpacePose)
 	{
-		//Convert pose to component space
-		CS_Output.Pose.InitPose(Output.Pose);
+		ConvertToComponentSpace(Output, CS_Output);
 	}
 	
 	//Record Features
-	const int32 ConfigIterations = FMath::Min(CopyConfigs.Num(), MotionRecorderData.Num());
 	for(int32 ConfigIndex = 0; ConfigIndex < ConfigIterations; ++ConfigIndex)
 	{
 		if(TObjectPtr<UMotionMatchConfig> MotionConfig = CopyConfigs[ConfigIndex])
 		{
 			FMotionRecordData& MotionRecord = MotionRecorderData[ConfigIndex];
+			const bool bExtractThisFrame = !bLazyExtraction
+				|| !MotionRecord.bExtractOnRequest
+				|| !MotionRecord.bConsumerUpdated
+				|| MotionRecord.bSnapshotRequested;
+			
+			MotionRecord.bSnapshotRequested = false;
+			MotionRecord.bConsumerUpdated = false;
+			MotionRecord.bSnapshotCurrent = bExtractThisFrame;
 			
 			int32 FeatureOffset = 0;
 			for(const TObjectPtr<UMatchFeatureBase> Feature : MotionConfig->Features)
 			{
 				if(Feature->PoseCategory == EPoseCategory::Quality)
 				{
-					Feature->ExtractRuntime(CS_Output.Pose, &MotionRecord.RecordedPoseArray[FeatureOffset],
-						&MotionRecord.FeatureCacheData[FeatureOffset],
-						Output.AnimInstanceProxy, PoseDeltaTime);
+					if(bExtractThisFrame)
+					{
+						Feature->ExtractRuntime(CS_Output.Pose, &MotionRecord.RecordedPoseArray[FeatureOffset],
+							&MotionRecord.FeatureCacheData[FeatureOffset],
+							Output.AnimInstanceProxy, PoseDeltaTime);
+					}
+					else if(Feature->HasRuntimeHistory())
+					{
+						//Keep the history up to date so that velocities are correct on the next requested frame
+						Feature->UpdateRuntimeHistory(CS_Output.Pose, &MotionRecord.FeatureCacheData[FeatureOffset],
+							Output.AnimInstanceProxy);
+					}
 				}
 		
 				FeatureOffset += Feature->Size();
@@ -344,6 +503,41 @@ void FAnimNode_MotionRecorder::Evaluate_AnyThread(FPoseContext& Output)
 #endif
 }
 
+void FAnimNode_MotionRecorder::ConvertToComponentSpace(FPoseContext& Output, FComponentSpacePoseContext& CS_Output)
+{
+	if (bRetargetPose)
+	{
+		//Only the bones read by features (and their parents) are retargeted. They are retargeted in place on the output
+		//pose for the copy into component space and then restored, so the pose is only copied once. The component space
+		//pose is lazy so the rest of the bones are never transformed.
+		const FMotionRecorderBoneChain& BoneChain = FindOrCacheBoneChain(Output.AnimInstanceProxy);
+		const int32 ChainLength = BoneChain.CompactBoneIndices.Num();
+		SourceChainTransforms.SetNumUninitialized(ChainLength, false);
+
+		//(ActualBone / RefPoseBone) * RefSkelRefPoseBone
+		for(int32 i = 0; i < ChainLength; ++i)
+		{
+			FTransform& RetargetBoneTransform = Output.Pose[BoneChain.CompactBoneIndices[i]];
+			SourceChainTransforms[i] = RetargetBoneTransform;
+			RetargetBoneTransform = (RetargetBoneTransform * BoneChain.InverseCompactRefPose[i]) * BoneChain.SkeletonRefPose[i];
+			RetargetBoneTransform.NormalizeRotation();
+		}
+
+		//Convert pose to component space
+		CS_Output.Pose.InitPose(Output.Pose);
+
+		for(int32 i = 0; i < ChainLength; ++i)
+		{
+			Output.Pose[BoneChain.CompactBoneIndices[i]] = SourceChainTransforms[i];
+		}
+	}
+	else
+	{
+		//Convert pose to component space
+		CS_Output.Pose.InitPose(Output.Pose);
+	}
+}
+
 void FAnimNode_MotionRecorder::GatherDebugData(FNodeDebugData& DebugData)
 {
 	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(GatherDebugData);
@@ -23,6 +23,16 @@ UAnimSequenceBase* FAnimNode_MultiPoseMatching::FindActiveAnim()
 	return Animations[AnimId];
 }
 
+void FAnimNode_MultiPoseMatching::GatherPoseDatabaseSources(FPoseMatchDatabaseKey& OutKey) const
+{
+	FAnimNode_PoseMatchBase::GatherPoseDatabaseSources(OutKey);
+
+	for(const TObjectPtr<UAnimSequence> CurSequence : Animations)
+	{
+		OutKey.SourceAssets.Add(FObjectKey(CurSequence.Get()));
+	}
+}
+
 #if WITH_EDITOR
 void FAnimNode_MultiPoseMatching::PreProcess()
 {
@@ -90,7 +100,8 @@ void FAnimNode_MultiPoseMatching::InitializeData()
 		{
 			if(UAnimSequence* AnimSequence = Animations[i])
 			{
-				DistanceMatchingModules[i].Setup(AnimSequence, DistanceMatchData.DistanceCurveName);
+				DistanceMatchingModules[i].Setup(AnimSequence, DistanceMatchData.DistanceCurveName,
+					DistanceMatchData.bNegateDistanceCurve);
 			}
 		}
 	}
@@ -197,6 +208,15 @@ int32 FAnimNode_MultiPoseMatching::GetMinimaCostPoseId(const TArray<float>* InCu
 		return Super::GetMinimaCostPoseId(InCurrentPoseArray);
 	}
 
+	if(!InCurrentPoseArray
+		|| !PoseDatabase.IsValid()
+		|| PoseDatabase->Poses.Num() == 0)
+	{
+		return -1;
+	}
+
+	const TArray<FPoseMatchData>& DatabasePoses = PoseDatabase->Poses;
+
 	int32 LastPoseChecked = -1;
 	int32 LowestCostPoseId = -1;
 	float LowestPoseCost = 1000000.0f;
@@ -210,9 +230,9 @@ int32 FAnimNode_MultiPoseMatching::GetMinimaCostPoseId(const TArray<float>* InCu
 		//Find out which pose this time represents in this animation
 		float ClosestPoseTimeDif = 100000.0f;
 		int32 ClosestPoseId = -1;
-		for(int32 j = LastPoseChecked + 1; j < Poses.Num(); ++j)
+		for(int32 j = LastPoseChecked + 1; j < DatabasePoses.Num(); ++j)
 		{
-			const FPoseMatchData& Pose = Poses[j];
+			const FPoseMatchData& Pose = DatabasePoses[j];
 
 			if(Pose.AnimId > i)
 			{
@@ -231,7 +251,7 @@ int32 FAnimNode_MultiPoseMatching::GetMinimaCostPoseId(const TArray<float>* InCu
 		}
 
 		//Now calculate this pose's cost and check if it is the lowest cost overall
-		const float PoseCost = ComputeSinglePoseCost(*InCurrentPoseArray, ClosestPoseId);
+		const float PoseCost = ComputeSinglePoseCost(*InCurrentPoseArray, ClosestPoseId, LowestPoseCost);
 
 		if(PoseCost < LowestPoseCost)
 		{
@@ -240,10 +260,10 @@ int32 FAnimNode_MultiPoseMatching::GetMinimaCostPoseId(const TArray<float>* InCu
 		}
 	}
 
-	LowestCostPoseId = FMath::Clamp(LowestCostPoseId, 0, Poses.Num() - 1);
+	LowestCostPoseId = FMath::Clamp(LowestCostPoseId, 0, DatabasePoses.Num() - 1);
 	
 	//Set the current animation and distance matching module based on the lowest cost pose
-	const int32 AnimId = Poses[LowestCostPoseId].AnimId;
+	const int32 AnimId = DatabasePoses[LowestCostPoseId].AnimId;
 	SetSequence(Animations[AnimId]);
 	MatchDistanceModule = &DistanceMatchingModules[AnimId];
 
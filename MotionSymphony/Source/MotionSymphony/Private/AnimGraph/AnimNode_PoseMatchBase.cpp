@@ -22,23 +22,139 @@ static TAutoConsoleVariable<int32> CVarPoseMatchingDebug(
 	TEXT("  2: On - Show All Poses\n")
 	TEXT("  3: On - Show All Poses With Velocity\n"));
 
-
-FPoseMatchData::FPoseMatchData()
-	: PoseId(-1),
-	AnimId(0),
-	bMirror(false),
-	Time(0.0f)
+namespace
 {
-}
+	/** Atoms are accumulated in fixed size chunks without branching so that the compiler can vectorize each chunk. The
+	 * running cost is only compared against the cost limit between chunks. */
+	constexpr int32 PoseCostChunkSize = 8;
 
-FPoseMatchData::FPoseMatchData(int32 InPoseId, int32 InAnimId, float InTime, bool bInMirror)
-	: PoseId(InPoseId),
-	AnimId(InAnimId),
-	bMirror(bInMirror),
-	Time(InTime)
-{
+	/** Weighted cost of a pose. Stops early and returns a partial cost once the cost limit has been reached. */
+	float ComputeWeightedPoseCost(const float* InQuery, const float* InPose, const float* InWeights,
+		const int32 InAtomCount, const float InCostLimit)
+	{
+		float Cost = 0.0f;
+		int32 AtomIndex = 0;
+		for(; AtomIndex + PoseCostChunkSize <= InAtomCount; AtomIndex += PoseCostChunkSize)
+		{
+			float ChunkCost[PoseCostChunkSize];
+			for(int32 i = 0; i < PoseCostChunkSize; ++i)
+			{
+				ChunkCost[i] = FMath::Abs(InPose[AtomIndex + i] - InQuery[AtomIndex + i]) * InWeights[AtomIndex + i];
+			}
+
+			for(int32 i = 0; i < PoseCostChunkSize; ++i)
+			{
+				Cost += ChunkCost[i];
+			}
+
+			if(Cost >= InCostLimit)
+			{
+				return Cost;
+			}
+		}
+
+		for(; AtomIndex < InAtomCount; ++AtomIndex)
+		{
+			Cost += FMath::Abs(InPose[AtomIndex] - InQuery[AtomIndex]) * InWeights[AtomIndex];
+		}
+
+		return Cost;
+	}
+
+	/** Lowest possible weighted cost of any pose within an AABB (i.e. the cost of the closest point in the box). Stops
+	 * early and returns a partial cost once the cost limit has been reached. */
+	float ComputeWeightedAABBCost(const float* InQuery, const float* InExtents, const float* InWeights,
+		const int32 InAtomCount, const float InCostLimit)
+	{
+		float Cost = 0.0f;
+		int32 AtomIndex = 0;
+		for(; AtomIndex + PoseCostChunkSize <= InAtomCount; AtomIndex += PoseCostChunkSize)
+		{
+			float ChunkCost[PoseCostChunkSize];
+			for(int32 i = 0; i < PoseCostChunkSize; ++i)
+			{
+				const float Query = InQuery[AtomIndex + i];
+				const int32 ExtentIndex = (AtomIndex + i) * 2;
+				const float ClosestPoint = FMath::Clamp(Query, InExtents[ExtentIndex], InExtents[ExtentIndex + 1]);
+				ChunkCost[i] = FMath::Abs(Query - ClosestPoint) * InWeights[AtomIndex + i];
+			}
+
+			for(int32 i = 0; i < PoseCostChunkSize; ++i)
+			{
+				Cost += ChunkCost[i];
+			}
+
+			if(Cost >= InCostLimit)
+			{
+				return Cost;
+			}
+		}
+
+		for(; AtomIndex < InAtomCount; ++AtomIndex)
+		{
+			const float Query = InQuery[AtomIndex];
+			const float ClosestPoint = FMath::Clamp(Query, InExtents[AtomIndex * 2], InExtents[AtomIndex * 2 + 1]);
+			Cost += FMath::Abs(Query - ClosestPoint) * InWeights[AtomIndex];
+		}
+
+		return Cost;
+	}
+
+	/** Finds the lowest cost pose within the inclusive pose range. Outer and then inner AABBs are skipped if even their
+	 * closest point costs more than the best pose found so far. Returns -1 if no pose is cheaper than InOutLowestCost. */
+	int32 SearchPoseDatabase(const FPoseMatchDatabase& InDatabase, const float* InQuery, const int32 InAtomCount,
+		const int32 InStartPoseId, const int32 InEndPoseId, float& InOutLowestCost)
+	{
+		constexpr int32 OuterAABBSize = FPoseMatchDatabase::OuterAABBSize;
+		constexpr int32 InnerAABBSize = FPoseMatchDatabase::InnerAABBSize;
+		constexpr int32 InnerPerOuterAABB = OuterAABBSize / InnerAABBSize;
+
+		const float* PoseArray = InDatabase.PoseMatrix.GetData();
+		const float* Weights = InDatabase.FinalCalibration.Weights.GetData();
+		const TArray<float>& OuterAABBArray = InDatabase.PoseAABBMatrix_Outer.ExtentsArray;
+		const TArray<float>& InnerAABBArray = InDatabase.PoseAABBMatrix_Inner.ExtentsArray;
+		const int32 ExtentsStride = InAtomCount * 2;
+
+		int32 LowestPoseId = -1;
+		for(int32 OuterAABBIndex = InStartPoseId / OuterAABBSize; OuterAABBIndex <= InEndPoseId / OuterAABBSize; ++OuterAABBIndex)
+		{
+			if(ComputeWeightedAABBCost(InQuery, &OuterAABBArray[OuterAABBIndex * ExtentsStride], Weights,
+				InAtomCount, InOutLowestCost) >= InOutLowestCost)
+			{
+				continue;
+			}
+
+			const int32 InnerAABBStartIndex = FMath::Max(OuterAABBIndex * InnerPerOuterAABB, InStartPoseId / InnerAABBSize);
+			const int32 InnerAABBEndIndex = FMath::Min((OuterAABBIndex + 1) * InnerPerOuterAABB - 1, InEndPoseId / InnerAABBSize);
+			for(int32 InnerAABBIndex = InnerAABBStartIndex; InnerAABBIndex <= InnerAABBEndIndex; ++InnerAABBIndex)
+			{
+				if(ComputeWeightedAABBCost(InQuery, &InnerAABBArray[InnerAABBIndex * ExtentsStride], Weights,
+					InAtomCount, InOutLowestCost) >= InOutLowestCost)
+				{
+					continue;
+				}
+
+				const int32 StartPoseIndex = FMath::Max(InnerAABBIndex * InnerAABBSize, InStartPoseId);
+				const int32 EndPoseIndex = FMath::Min((InnerAABBIndex + 1) * InnerAABBSize - 1, InEndPoseId);
+				for(int32 PoseIndex = StartPoseIndex; PoseIndex <= EndPoseIndex; ++PoseIndex)
+				{
+					const float Cost = ComputeWeightedPoseCost(InQuery, PoseArray + PoseIndex * InAtomCount, Weights,
+						InAtomCount, InOutLowestCost);
+
+					if(Cost < InOutLowestCost)
+					{
+						InOutLowestCost = Cost;
+						LowestPoseId = PoseIndex;
+					}
+				}
+			}
+		}
+
+		return LowestPoseId;
+	}
 }
 
+
 FAnimNode_PoseMatchBase::FAnimNode_PoseMatchBase()
 	: PoseInterval(0.1f),
 	  PosesEndTime(5.0f),
@@ -56,6 +172,8 @@ FAnimNode_PoseMatchBase::FAnimNode_PoseMatchBase()
 void FAnimNode_PoseMatchBase::PreProcess()
 {
 	Poses.Empty();
+	PoseMatrix.Empty();
+	PoseBakeId = FGuid::NewGuid();
 	bIsDirtyForPreProcess = false;
 }
 
@@ -122,34 +240,52 @@ void FAnimNode_PoseMatchBase::InitializeData()
 		PoseConfig->Initialize();
 	}
 
-	
-	if(bIsDirtyForPreProcess)
-	{
-		PreProcess();
-	}
+	FPoseMatchDatabaseKey DatabaseKey;
+	GatherPoseDatabaseSources(DatabaseKey);
 
-	//Generate the default weightings for calibration
-	if(Calibration)
+	PoseDatabase = FPoseMatchDatabase::FindOrCreate(DatabaseKey, PoseConfig, [this](FPoseMatchDatabase& OutDatabase)
 	{
-		Calibration->OnGenerateWeightings();
-	}
-	
-	//Calculate feature normalization calibrations
-	StandardDeviation.Initialize(PoseConfig->TotalDimensionCount);
-	StandardDeviation.GenerateStandardDeviationWeights(PoseMatrix, PoseConfig);
+		//Poses are normally baked on compile. Only nodes that were never baked pre-process here
+		if(bIsDirtyForPreProcess)
+		{
+			PreProcess();
+		}
+
+		OutDatabase.Poses = MoveTemp(Poses);
+		OutDatabase.PoseMatrix = MoveTemp(PoseMatrix);
+
+		//Generate the default weightings for calibration
+		if(Calibration)
+		{
+			Calibration->OnGenerateWeightings();
+		}
+	});
+
+	//This instance's copy of the bake is no longer needed once the shared database holds it
+	Poses.Empty();
+	PoseMatrix.Empty();
+}
 
-	//Generate Final Weights
-	FinalCalibration.Initialize(PoseConfig);
-	FinalCalibration.GenerateFinalWeights(PoseConfig, StandardDeviation);
+void FAnimNode_PoseMatchBase::GatherPoseDatabaseSources(FPoseMatchDatabaseKey& OutKey) const
+{
+	OutKey.BakeId = PoseBakeId;
+	OutKey.PoseInterval = PoseInterval;
+	OutKey.PosesEndTime = PosesEndTime;
+	OutKey.bMirroring = bEnableMirroring && MirrorDataTable;
+	OutKey.SourceAssets.Add(FObjectKey(PoseConfig.Get()));
+	OutKey.SourceAssets.Add(FObjectKey(OutKey.bMirroring ? MirrorDataTable.Get() : nullptr));
 }
 
 void FAnimNode_PoseMatchBase::FindMatchPose(const FAnimationUpdateContext& Context)
 {
-	if(Poses.Num() == 0)
+	if(!PoseDatabase.IsValid()
+		|| PoseDatabase->Poses.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FAnimNode_PoseMatchBase: No poses recorded in node"))
 		return;
 	}
+
+	const FPoseMatchDatabase& Database = *PoseDatabase;
 	
 	FAnimNode_MotionRecorder* MotionRecorderNode = nullptr;
 	if (IMotionSnapper* MotionSnapper = Context.GetMessage<IMotionSnapper>())
@@ -166,15 +302,15 @@ void FAnimNode_PoseMatchBase::FindMatchPose(const FAnimationUpdateContext& Conte
 		}
 
 		const TArray<float>* CurrentPoseArray = MotionRecorderNode->GetCurrentPoseArray(PoseRecorderConfigIndex);
-		const int32 MinimaCostPoseId = FMath::Clamp(GetMinimaCostPoseId(CurrentPoseArray), 0, Poses.Num() - 1);
+		const int32 MinimaCostPoseId = FMath::Clamp(GetMinimaCostPoseId(CurrentPoseArray), 0, Database.Poses.Num() - 1);
 
-		MatchPose = &Poses[MinimaCostPoseId];
+		MatchPose = &Database.Poses[MinimaCostPoseId];
 		MatchPoseIndex = MinimaCostPoseId;
 	}
 	else
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FAnimNode_PoseMatchBase: Cannot find Motion Snapshot node to pose match against."))
-		MatchPose = &Poses[0];
+		MatchPose = &Database.Poses[0];
 		MatchPoseIndex = 0;
 	}
 
@@ -191,82 +327,68 @@ UAnimSequenceBase* FAnimNode_PoseMatchBase::FindActiveAnim()
 
 int32 FAnimNode_PoseMatchBase::GetMinimaCostPoseId(const TArray<float>* InCurrentPoseArray)
 {
-	if (!InCurrentPoseArray
-		|| Poses.Num() == 0
-		|| FinalCalibration.Weights.Num() == 0)
+	if(!InCurrentPoseArray)
 	{
 		return -1;
 	}
-	
-	int32 MinimaCostPoseId = 0;
-	float MinimaCost = 10000000.0f;
 
-	const int32 AtomCount = PoseConfig->TotalDimensionCount;
-	for(int32 PoseIndex = 0; PoseIndex < Poses.Num(); ++PoseIndex)
-	{
-		float Cost = 0.0f;
-		const int32 MatrixStartIndex = PoseIndex * AtomCount;
-		for(int32 AtomIndex = 0; AtomIndex < AtomCount; ++AtomIndex)
-		{
-			Cost += FMath::Abs(PoseMatrix[MatrixStartIndex + AtomIndex] - (*InCurrentPoseArray)[AtomIndex])
-				* FinalCalibration.Weights[AtomIndex];
-		}
-
-		if(Cost < MinimaCost)
-		{
-			MinimaCost = Cost;
-			MinimaCostPoseId = PoseIndex;
-		}
-	}
-
-	return MinimaCostPoseId;
+	float MinimaCost = 0.0f;
+	return GetMinimaCostPoseId(*InCurrentPoseArray, MinimaCost, 0, MAX_int32);
 }
 
 int32 FAnimNode_PoseMatchBase::GetMinimaCostPoseId(const TArray<float>& InCurrentPoseArray, float& OutCost,
                                                    int32 InStartPoseId, int32 InEndPoseId)
 {
-	if (Poses.Num() == 0)
+	OutCost = UE_MAX_FLT;
+	
+	if (!PoseDatabase.IsValid()
+		|| !PoseConfig
+		|| PoseDatabase->Poses.Num() == 0)
 	{
 		return -1;
 	}
 
-	InStartPoseId = FMath::Clamp(InStartPoseId, 0, Poses.Num() - 1);
-	InEndPoseId = FMath::Clamp(InEndPoseId, 0, Poses.Num() - 1);
-
-	int32 MinimaCostPoseId = 0;
-	OutCost = 10000000.0f;
+	const FPoseMatchDatabase& Database = *PoseDatabase;
 	const int32 AtomCount = PoseConfig->TotalDimensionCount;
-	for(int32 PoseIndex = InStartPoseId; PoseIndex < InEndPoseId; ++PoseIndex)
+	if(AtomCount <= 0
+		|| InCurrentPoseArray.Num() < AtomCount
+		|| Database.FinalCalibration.Weights.Num() < AtomCount)
 	{
-		float Cost = 0.0f;
-		const int32 MatrixStartIndex = PoseIndex * AtomCount;
-		for(int32 AtomIndex = 0; AtomIndex < AtomCount; ++AtomIndex)
-		{
-			Cost += FMath::Abs(PoseMatrix[MatrixStartIndex + AtomIndex] - InCurrentPoseArray[AtomIndex])
-				* FinalCalibration.Weights[AtomIndex];
-		}
-
-		if(Cost < OutCost)
-		{
-			OutCost = Cost;
-			MinimaCostPoseId = PoseIndex;
-		}
+		return -1;
 	}
 
-	return MinimaCostPoseId;
+	//The pose range is inclusive
+	const int32 LastPoseId = FMath::Min(Database.Poses.Num(), Database.PoseMatrix.Num() / AtomCount) - 1;
+	InStartPoseId = FMath::Clamp(InStartPoseId, 0, LastPoseId);
+	InEndPoseId = FMath::Clamp(InEndPoseId, InStartPoseId, LastPoseId);
+
+	const int32 MinimaCostPoseId = SearchPoseDatabase(Database, InCurrentPoseArray.GetData(), AtomCount,
+		InStartPoseId, InEndPoseId, OutCost);
+
+	return MinimaCostPoseId > -1 ? MinimaCostPoseId : InStartPoseId;
 }
 
-float FAnimNode_PoseMatchBase::ComputeSinglePoseCost(const TArray<float>& InCurrentPoseArray, const int32 InPoseIndex)
+float FAnimNode_PoseMatchBase::ComputeSinglePoseCost(const TArray<float>& InCurrentPoseArray, const int32 InPoseIndex,
+	const float InCostLimit /*= UE_MAX_FLT*/)
 {
-	float Cost = 0.0f;
-	const int32 MatrixStartIndex = InPoseIndex * PoseConfig->TotalDimensionCount;
-	for(int32 AtomIndex = 0; AtomIndex < PoseConfig->TotalDimensionCount; ++AtomIndex)
+	if(!PoseDatabase.IsValid()
+		|| !PoseConfig)
 	{
-		Cost += FMath::Abs(PoseMatrix[MatrixStartIndex + AtomIndex] - InCurrentPoseArray[AtomIndex])
-			* FinalCalibration.Weights[AtomIndex];;
+		return 0.0f;
 	}
 
-	return Cost;
+	const FPoseMatchDatabase& Database = *PoseDatabase;
+	const int32 AtomCount = PoseConfig->TotalDimensionCount;
+	if(InCurrentPoseArray.Num() < AtomCount
+		|| Database.FinalCalibration.Weights.Num() < AtomCount
+		|| !Database.PoseMatrix.IsValidIndex((InPoseIndex + 1) * AtomCount - 1)
+		|| InPoseIndex < 0)
+	{
+		return UE_MAX_FLT;
+	}
+	
+	return ComputeWeightedPoseCost(InCurrentPoseArray.GetData(), &Database.PoseMatrix[InPoseIndex * AtomCount],
+		Database.FinalCalibration.Weights.GetData(), AtomCount, InCostLimit);
 }
 
 int32 FAnimNode_PoseMatchBase::ComputePoseCountForSingleAnimation(TObjectPtr<UAnimSequence> Anim) const
@@ -386,17 +508,23 @@ void FAnimNode_PoseMatchBase::Evaluate_AnyThread(FPoseContext& Output)
 		&& MirrorDataTable
 		&& IsLODEnabled(Output.AnimInstanceProxy))
 	{
-		const FBoneContainer BoneContainer = Output.Pose.GetBoneContainer();
-		const TArray<FBoneIndexType>& RequiredBoneIndices = BoneContainer.GetBoneIndicesArray();
-		const int32 NumReqBones = RequiredBoneIndices.Num();
-		if(CompactPoseMirrorBones.Num() != NumReqBones)
+		//The map is normally acquired in CacheBones. This only catches evaluation before bones were cached for this LOD
+		const FBoneContainer& BoneContainer = Output.Pose.GetBoneContainer();
+		if(!MirrorBoneMap.IsValid()
+			|| MirrorBoneMap->CompactPoseMirrorBones.Num() != BoneContainer.GetBoneIndicesArray().Num())
 		{
 			FillCompactPoseAndComponentRefRotations(BoneContainer);
 		}
+
+		if(!MirrorBoneMap.IsValid())
+		{
+			return;
+		}
 	
-		FAnimationRuntime::MirrorPose(Output.Pose, MirrorDataTable->MirrorAxis, CompactPoseMirrorBones, ComponentSpaceRefRotations);
+		FAnimationRuntime::MirrorPose(Output.Pose, MirrorDataTable->MirrorAxis, MirrorBoneMap->CompactPoseMirrorBones,
+			MirrorBoneMap->ComponentSpaceRefRotations);
 		FAnimationRuntime::MirrorCurves(Output.Curve, *MirrorDataTable);
-		UE::Anim::Attributes::MirrorAttributes(Output.CustomAttributes, *MirrorDataTable, CompactPoseMirrorBones);
+		UE::Anim::Attributes::MirrorAttributes(Output.CustomAttributes, *MirrorDataTable, MirrorBoneMap->CompactPoseMirrorBones);
 	}
 }
 
@@ -436,15 +564,11 @@ void FAnimNode_PoseMatchBase::FillCompactPoseAndComponentRefRotations(const FBon
 {
 	if(MirrorDataTable)
 	{
-		MirrorDataTable->FillCompactPoseAndComponentRefRotations(
-			BoneContainer,
-			CompactPoseMirrorBones,
-			ComponentSpaceRefRotations);
+		MirrorBoneMap = FMirrorBoneMap::FindOrCreate(MirrorDataTable, BoneContainer);
 	}
 	else
 	{
-		CompactPoseMirrorBones.Reset();
-		ComponentSpaceRefRotations.Reset();
+		MirrorBoneMap.Reset();
 	}
 }
 
@@ -31,4 +31,10 @@ void FAnimNode_PoseMatching::PreProcess()
 	{
 		PreProcessAnimation(LocalSequence, 0);
 	}
-}
\ No newline at end of file
+}
+
+void FAnimNode_PoseMatching::GatherPoseDatabaseSources(FPoseMatchDatabaseKey& OutKey) const
+{
+	FAnimNode_PoseMatchBase::GatherPoseDatabaseSources(OutKey);
+	OutKey.SourceAssets.Add(FObjectKey(GetSequence()));
+}
@@ -37,12 +37,136 @@ FTransitionAnimData::FTransitionAnimData(const FTransitionAnimData& CopyTransiti
 	}
 }
 
+FTransitionDirectionIndex::FTransitionDirectionIndex()
+	: BucketCount(0),
+	TransitionCount(0),
+	MirroredTransitionCount(0)
+{
+}
+
+void FTransitionDirectionIndex::Build(const TArray<FTransitionAnimData>& InTransitions,
+	const TArray<FTransitionAnimData>& InMirroredTransitions, const int32 InBucketCount)
+{
+	BucketCount = FMath::Max(InBucketCount, 4);
+	TransitionCount = InTransitions.Num();
+	MirroredTransitionCount = InMirroredTransitions.Num();
+
+	const int32 CandidateCount = TransitionCount + MirroredTransitionCount;
+	const int32 CellCount = (BucketCount + 1) * (BucketCount + 1);
+
+	//Find the cell of every transition and count the transitions in each cell
+	TArray<int32> CandidateCells;
+	CandidateCells.SetNumUninitialized(CandidateCount);
+	CellStarts.Init(0, CellCount + 1);
+	for(int32 CandidateIndex = 0; CandidateIndex < CandidateCount; ++CandidateIndex)
+	{
+		const FTransitionAnimData& TransitionData = CandidateIndex < TransitionCount ? InTransitions[CandidateIndex]
+			: InMirroredTransitions[CandidateIndex - TransitionCount];
+
+		const int32 CellIndex = GetCellIndex(FindBucket(TransitionData.CurrentMove), FindBucket(TransitionData.DesiredMove));
+		CandidateCells[CandidateIndex] = CellIndex;
+		++CellStarts[CellIndex + 1];
+	}
+
+	for(int32 CellIndex = 0; CellIndex < CellCount; ++CellIndex)
+	{
+		CellStarts[CellIndex + 1] += CellStarts[CellIndex];
+	}
+
+	//Place the transitions in their cells, keeping them in ascending order within each cell
+	TArray<int32> CellFill(CellStarts);
+	CellEntries.SetNumUninitialized(CandidateCount);
+	for(int32 CandidateIndex = 0; CandidateIndex < CandidateCount; ++CandidateIndex)
+	{
+		CellEntries[CellFill[CandidateCells[CandidateIndex]]++] = CandidateIndex;
+	}
+}
+
+bool FTransitionDirectionIndex::IsBuiltFor(const int32 InTransitionCount, const int32 InMirroredTransitionCount,
+	const int32 InBucketCount) const
+{
+	return BucketCount == FMath::Max(InBucketCount, 4)
+		&& TransitionCount == InTransitionCount
+		&& MirroredTransitionCount == InMirroredTransitionCount
+		&& CellStarts.Num() == (BucketCount + 1) * (BucketCount + 1) + 1
+		&& CellEntries.Num() == TransitionCount + MirroredTransitionCount;
+}
+
+void FTransitionDirectionIndex::GatherCandidates(const FVector& InCurrentMove, const FVector& InDesiredMove,
+	const bool bInIncludeMirrored, TArray<int32>& OutCandidates) const
+{
+	if(BucketCount < 4)
+	{
+		return;
+	}
+
+	//On each axis search the still bin and the bins either side of the query direction. A query with no direction is
+	//equally far from every direction so all bins on that axis are searched.
+	auto GatherAxisBuckets = [this](const int32 InBucket, TArray<int32, TInlineAllocator<33>>& OutBuckets)
+	{
+		OutBuckets.Add(BucketCount);
+		if(InBucket == BucketCount)
+		{
+			for(int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+			{
+				OutBuckets.Add(Bucket);
+			}
+		}
+		else
+		{
+			OutBuckets.Add((InBucket + BucketCount - 1) % BucketCount);
+			OutBuckets.Add(InBucket);
+			OutBuckets.Add((InBucket + 1) % BucketCount);
+		}
+	};
+
+	TArray<int32, TInlineAllocator<33>> CurrentBuckets;
+	TArray<int32, TInlineAllocator<33>> DesiredBuckets;
+	GatherAxisBuckets(FindBucket(InCurrentMove), CurrentBuckets);
+	GatherAxisBuckets(FindBucket(InDesiredMove), DesiredBuckets);
+
+	const int32 CandidateLimit = bInIncludeMirrored ? TransitionCount + MirroredTransitionCount : TransitionCount;
+	for(const int32 CurrentBucket : CurrentBuckets)
+	{
+		for(const int32 DesiredBucket : DesiredBuckets)
+		{
+			const int32 CellIndex = GetCellIndex(CurrentBucket, DesiredBucket);
+			for(int32 EntryIndex = CellStarts[CellIndex]; EntryIndex < CellStarts[CellIndex + 1]; ++EntryIndex)
+			{
+				if(CellEntries[EntryIndex] < CandidateLimit)
+				{
+					OutCandidates.Add(CellEntries[EntryIndex]);
+				}
+			}
+		}
+	}
+}
+
+int32 FTransitionDirectionIndex::FindBucket(const FVector& InMove) const
+{
+	if(InMove.SizeSquared2D() < StillMoveThreshold * StillMoveThreshold)
+	{
+		return BucketCount;
+	}
+
+	//Bins are centred on the forward direction (+X) so that cardinal and diagonal moves do not sit on a bin edge
+	const float Yaw = FMath::Atan2(InMove.Y, InMove.X) / UE_TWO_PI;
+	const int32 Bucket = FMath::RoundToInt32(Yaw * BucketCount) % BucketCount;
+	return Bucket < 0 ? Bucket + BucketCount : Bucket;
+}
+
+int32 FTransitionDirectionIndex::GetCellIndex(const int32 InCurrentBucket, const int32 InDesiredBucket) const
+{
+	return InCurrentBucket * (BucketCount + 1) + InDesiredBucket;
+}
+
 FAnimNode_TransitionMatching::FAnimNode_TransitionMatching()
 	: CurrentMoveVector(FVector(0.0f)),
 	  DesiredMoveVector(FVector(0.0f)),
 	  TransitionMatchingOrder(ETransitionMatchingOrder::TransitionPriority),
 	  StartDirectionWeight(1.0f),
 	  EndDirectionWeight(1.0f),
+	  DirectionBucketCount(8),
 	  DistanceMatchingUseCase(EDistanceMatchingUseCase::None),
 	  DesiredDistance(0.0f),
 	  MatchDistanceModule(nullptr)
@@ -51,12 +175,15 @@ FAnimNode_TransitionMatching::FAnimNode_TransitionMatching()
 
 void FAnimNode_TransitionMatching::FindMatchPose(const FAnimationUpdateContext& Context)
 {
-	if (Poses.Num() == 0)
+	if (!PoseDatabase.IsValid()
+		|| PoseDatabase->Poses.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FAnimNode_TransitionMatching: No poses recorded in node"))
 			return;
 	}
 
+	const TArray<FPoseMatchData>& DatabasePoses = PoseDatabase->Poses;
+
 	if (TransitionAnimData.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FAnimNode_TransitionMatching: No TransitionAnimData, cannot find a pose"))
@@ -91,37 +218,18 @@ void FAnimNode_TransitionMatching::FindMatchPose(const FAnimationUpdateContext&
 				} break;
 			}
 
-			MinimaCostPoseId = FMath::Clamp(MinimaCostPoseId, 0, Poses.Num() - 1);
+			MinimaCostPoseId = FMath::Clamp(MinimaCostPoseId, 0, DatabasePoses.Num() - 1);
 		}
 
-		MatchPose = &Poses[MinimaCostPoseId];
+		MatchPose = &DatabasePoses[MinimaCostPoseId];
 	}
 	else
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FAnimNode_PoseMatchBase: Cannot find Motion Snapshot node to pose match against."))
 
-		int32 MinimaTransitionId = 0;
-		float MinimaTransitionCost = 10000000.0f;
-		for (int32 i = 0; i < TransitionAnimData.Num(); ++i)
-		{
-			FTransitionAnimData& TransitionData = TransitionAnimData[i];
-
-			const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-			const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
-
-			const float Cost = (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight)
-				* TransitionData.CostMultiplier;
-
-			if (Cost < MinimaTransitionCost)
-			{
-				MinimaTransitionCost = Cost;
-				MinimaTransitionId = i;
-			}
-		}
-
-		MinimaTransitionId = FMath::Clamp(MinimaTransitionId, 0, TransitionAnimData.Num() - 1);
-		const int32 MatchPoseId = FMath::Clamp(TransitionAnimData[MinimaTransitionId].StartPose, 0, Poses.Num() - 1);
-		MatchPose = &Poses[MatchPoseId];
+		const FTransitionAnimData* MinimaCostSet = FindMinimaCostTransition();
+		const int32 MatchPoseId = FMath::Clamp(MinimaCostSet ? MinimaCostSet->StartPose : 0, 0, DatabasePoses.Num() - 1);
+		MatchPose = &DatabasePoses[MatchPoseId];
 	}
 	
 	SetSequence(FindActiveAnim());
@@ -146,42 +254,10 @@ UAnimSequenceBase* FAnimNode_TransitionMatching::FindActiveAnim()
 int32 FAnimNode_TransitionMatching::GetMinimaCostPoseId_TransitionPriority(const TArray<float>& InCurrentPoseArray)
 {
 	//First find out which transition set is the best match
-	FTransitionAnimData* MinimaCostSet = nullptr;
-	float MinimaCost = 10000000.0f;
-	for(FTransitionAnimData& TransitionData : TransitionAnimData)
-	{
-		const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-		const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
-
-		float SetCost = (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
-
-		SetCost *= TransitionData.CostMultiplier;
-
-		if (SetCost < MinimaCost)
-		{
-			MinimaCost = SetCost;
-			MinimaCostSet = &TransitionData;
-		}
-	}
-
-	//Search mirrored transitions as well if mirroring is enabled
-	if(bEnableMirroring)
+	const FTransitionAnimData* MinimaCostSet = FindMinimaCostTransition();
+	if(!MinimaCostSet)
 	{
-		for (FTransitionAnimData& TransitionData : MirroredTransitionAnimData)
-		{
-			const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-			const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
-
-			float SetCost = (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
-
-			SetCost *= TransitionData.CostMultiplier;
-
-			if (SetCost < MinimaCost)
-			{
-				MinimaCost = SetCost;
-				MinimaCostSet = &TransitionData;
-			}
-		}
+		return 0;
 	}
 
 	//Within the chosen transition (MinimaCostSet) Find the best pose to match to
@@ -191,21 +267,21 @@ int32 FAnimNode_TransitionMatching::GetMinimaCostPoseId_TransitionPriority(const
 
 int32 FAnimNode_TransitionMatching::GetMinimaCostPoseId_PoseTransitionWeighted(const TArray<float>& InCurrentPoseArray)
 {
+	GatherTransitionCandidates();
+	
 	int32 MinimaCostPoseId = 0;
 	float MinimaCost = 10000000.0f;
-	for (FTransitionAnimData& TransitionData : TransitionAnimData)
+	for(const int32 CandidateIndex : TransitionCandidates)
 	{
-		const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-		const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
+		const FTransitionAnimData& TransitionData = GetCandidateTransition(CandidateIndex);
 
 		//Find the Lowest Cost Pose from this transition anim data 
-		int32 SetMinimaPoseId = -1;
 		float SetMinimaCost = 10000000.0f;
-
-		SetMinimaPoseId = GetMinimaCostPoseId(InCurrentPoseArray, SetMinimaCost, TransitionData.StartPose, TransitionData.EndPose);
+		const int32 SetMinimaPoseId = GetMinimaCostPoseId(InCurrentPoseArray, SetMinimaCost,
+		                                                  TransitionData.StartPose, TransitionData.EndPose);
 
 		//Add Transition direction cost
-		SetMinimaCost += (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
+		SetMinimaCost += ComputeTransitionDirectionCost(TransitionData);
 
 		//Apply CostMultiplier
 		SetMinimaCost *= TransitionData.CostMultiplier;
@@ -217,75 +293,13 @@ int32 FAnimNode_TransitionMatching::GetMinimaCostPoseId_PoseTransitionWeighted(c
 		}
 	}
 
-	if(bEnableMirroring)
-	{
-		for (FTransitionAnimData& TransitionData : MirroredTransitionAnimData)
-		{
-			const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-			const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
-
-			//Find the Lowest Cost Pose from this transition anim data 
-			float SetMinimaCost = 10000000.0f;
-			const int32 SetMinimaPoseId = GetMinimaCostPoseId(InCurrentPoseArray, SetMinimaCost,
-																TransitionData.StartPose, TransitionData.EndPose);
-
-			//Add Transition direction cost
-			SetMinimaCost += (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
-
-			//Apply CostMultiplier
-			SetMinimaCost *= TransitionData.CostMultiplier;
-
-			if (SetMinimaCost < MinimaCost)
-			{
-				MinimaCost = SetMinimaCost;
-				MinimaCostPoseId = SetMinimaPoseId;
-			}
-		}
-	}
-
 	return MinimaCostPoseId;
 }
 
 int32 FAnimNode_TransitionMatching::GetMinimaCostPoseId_TransitionPriority_Distance()
 {
 	//First find out which transition set is the best match
-	FTransitionAnimData* MinimaCostSet = nullptr;
-	float MinimaCost = 10000000.0f;
-	for(FTransitionAnimData& TransitionData : TransitionAnimData)
-	{
-		const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-		const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
-
-		float SetCost = (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
-
-		SetCost *= TransitionData.CostMultiplier;
-
-		if (SetCost < MinimaCost)
-		{
-			MinimaCost = SetCost;
-			MinimaCostSet = &TransitionData;
-		}
-	}
-
-	//Search mirrored transitions as well if mirroring is enabled
-	if(bEnableMirroring)
-	{
-		for (FTransitionAnimData& TransitionData : MirroredTransitionAnimData)
-		{
-			const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-			const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
-
-			float SetCost = (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
-
-			SetCost *= TransitionData.CostMultiplier;
-
-			if (SetCost < MinimaCost)
-			{
-				MinimaCost = SetCost;
-				MinimaCostSet = &TransitionData;
-			}
-		}
-	}
+	FTransitionAnimData* MinimaCostSet = FindMinimaCostTransition();
 
 	//Within the chosen transition (MinimaCostSet) Find the best pose to match to
 	if(!MinimaCostSet)
@@ -305,57 +319,74 @@ int32 FAnimNode_TransitionMatching::GetMinimaCostPoseId_TransitionPriority_Dista
 
 int32 FAnimNode_TransitionMatching::GetMinimaCostPoseId_PoseTransitionWeighted_Distance()
 {
-	float MinimaCost = 100000.0f;
-	FTransitionAnimData*  MinimaCostTransition = nullptr;
-
-	for (FTransitionAnimData& TransitionData : TransitionAnimData)
+	const FTransitionAnimData* MinimaCostTransition = FindMinimaCostTransition();
+	if(!MinimaCostTransition)
 	{
-		const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-		const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
+		return 0;
+	}
 
-		//Add Transition direction cost
-		float Cost = (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
+	const float AnimTime = MinimaCostTransition->DistanceMatchModule.FindMatchingTime(DesiredDistance, DistanceMatchData.bNegateDistanceCurve);
+	const int32 PoseId = FMath::RoundHalfToZero(AnimTime / PoseInterval);
+	
+	return FMath::Clamp(PoseId, MinimaCostTransition->StartPose, MinimaCostTransition->EndPose);
+}
 
-		//Apply CostMultiplier
-		Cost *= TransitionData.CostMultiplier;
+void FAnimNode_TransitionMatching::GatherTransitionCandidates()
+{
+	TransitionCandidates.Reset();
 
-		if (Cost < MinimaCost)
-		{
-			MinimaCost = Cost;
-			MinimaCostTransition = &TransitionData;
-		}
+	if(DirectionIndex.IsBuiltFor(TransitionAnimData.Num(), MirroredTransitionAnimData.Num(), DirectionBucketCount))
+	{
+		DirectionIndex.GatherCandidates(CurrentMoveVector, DesiredMoveVector, bEnableMirroring, TransitionCandidates);
+
+		//Keep the original transition order so that ties resolve the same way as a full search
+		TransitionCandidates.Sort();
 	}
 
-	if(bEnableMirroring)
+	//Nothing authored near the requested directions, fall back to searching every transition
+	if(TransitionCandidates.Num() == 0)
 	{
-		for (FTransitionAnimData& TransitionData : MirroredTransitionAnimData)
+		const int32 CandidateCount = TransitionAnimData.Num() + (bEnableMirroring ? MirroredTransitionAnimData.Num() : 0);
+		for(int32 CandidateIndex = 0; CandidateIndex < CandidateCount; ++CandidateIndex)
 		{
-			const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, TransitionData.CurrentMove);
-			const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, TransitionData.DesiredMove);
+			TransitionCandidates.Add(CandidateIndex);
+		}
+	}
+}
 
-			//Add Transition direction cost
-			float Cost = (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
+FTransitionAnimData& FAnimNode_TransitionMatching::GetCandidateTransition(const int32 InCandidateIndex)
+{
+	return InCandidateIndex < TransitionAnimData.Num() ? TransitionAnimData[InCandidateIndex]
+		: MirroredTransitionAnimData[InCandidateIndex - TransitionAnimData.Num()];
+}
 
-			//Apply CostMultiplier
-			Cost *= TransitionData.CostMultiplier;
+float FAnimNode_TransitionMatching::ComputeTransitionDirectionCost(const FTransitionAnimData& InTransitionData) const
+{
+	const float CurrentVectorDelta = FVector::DistSquared(CurrentMoveVector, InTransitionData.CurrentMove);
+	const float DesiredVectorDelta = FVector::DistSquared(DesiredMoveVector, InTransitionData.DesiredMove);
 
-			if (Cost < MinimaCost)
-			{
-				MinimaCost = Cost;
-				MinimaCostTransition = &TransitionData;
-			}
-		}
-	}
+	return (CurrentVectorDelta * StartDirectionWeight) + (DesiredVectorDelta * EndDirectionWeight);
+}
 
-	if(!MinimaCostTransition)
+FTransitionAnimData* FAnimNode_TransitionMatching::FindMinimaCostTransition()
+{
+	GatherTransitionCandidates();
+	
+	FTransitionAnimData* MinimaCostSet = nullptr;
+	float MinimaCost = 10000000.0f;
+	for(const int32 CandidateIndex : TransitionCandidates)
 	{
-		return 0;
+		FTransitionAnimData& TransitionData = GetCandidateTransition(CandidateIndex);
+		const float SetCost = ComputeTransitionDirectionCost(TransitionData) * TransitionData.CostMultiplier;
+
+		if (SetCost < MinimaCost)
+		{
+			MinimaCost = SetCost;
+			MinimaCostSet = &TransitionData;
+		}
 	}
 
-	const float AnimTime = MinimaCostTransition->DistanceMatchModule.FindMatchingTime(DesiredDistance, DistanceMatchData.bNegateDistanceCurve);
-	const int32 PoseId = FMath::RoundHalfToZero(AnimTime / PoseInterval);
-	
-	return FMath::Clamp(PoseId, MinimaCostTransition->StartPose, MinimaCostTransition->EndPose);
+	return MinimaCostSet;
 }
 
 int32 FAnimNode_TransitionMatching::GetAnimationIndex(UAnimSequence* AnimSequence)
@@ -394,10 +425,21 @@ USkeleton* FAnimNode_TransitionMatching::GetNodeSkeleton()
 	return nullptr;
 }
 
+void FAnimNode_TransitionMatching::GatherPoseDatabaseSources(FPoseMatchDatabaseKey& OutKey) const
+{
+	FAnimNode_PoseMatchBase::GatherPoseDatabaseSources(OutKey);
+
+	for(const FTransitionAnimData& TransitionData : TransitionAnimData)
+	{
+		OutKey.SourceAssets.Add(FObjectKey(TransitionData.AnimSequence));
+	}
+}
+
 #if WITH_EDITOR
 void FAnimNode_TransitionMatching::PreProcess()
 {
 	FAnimNode_PoseMatchBase::PreProcess();
+	MirroredTransitionAnimData.Empty();
 
 	//Find First valid animation
 	FTransitionAnimData* FirstValidTransitionData = nullptr;
@@ -410,7 +452,7 @@ void FAnimNode_TransitionMatching::PreProcess()
 		}
 	}
 
-	if (FirstValidTransitionData)
+	if (!FirstValidTransitionData)
 	{
 		return;
 	}
@@ -490,6 +532,8 @@ void FAnimNode_TransitionMatching::PreProcess()
 			TransitionData.EndPose = Poses.Num() - 1;
 		}
 	}
+
+	DirectionIndex.Build(TransitionAnimData, MirroredTransitionAnimData, DirectionBucketCount);
 }
 #endif
 
@@ -503,16 +547,22 @@ void FAnimNode_TransitionMatching::InitializeData()
 		return;
 	}
 	
+	//Nodes baked before the direction index existed (or with a changed bucket count) build it on initialization instead
+	if(!DirectionIndex.IsBuiltFor(TransitionAnimData.Num(), MirroredTransitionAnimData.Num(), DirectionBucketCount))
+	{
+		DirectionIndex.Build(TransitionAnimData, MirroredTransitionAnimData, DirectionBucketCount);
+	}
+	
 	if(DistanceMatchingUseCase == EDistanceMatchingUseCase::Strict)
 	{
-		for(int32 i = 0; i < TransitionAnimData.Num(); ++i)
-			for(FTransitionAnimData& TransitionData : TransitionAnimData)
+		for(FTransitionAnimData& TransitionData : TransitionAnimData)
+		{
+			if(TransitionData.AnimSequence)
 			{
-				if(TransitionData.AnimSequence)
-				{
-					TransitionData.DistanceMatchModule.Setup(TransitionData.AnimSequence, DistanceMatchData.DistanceCurveName);
-				}
+				TransitionData.DistanceMatchModule.Setup(TransitionData.AnimSequence, DistanceMatchData.DistanceCurveName,
+					DistanceMatchData.bNegateDistanceCurve);
 			}
+		}
 	}
 }
 
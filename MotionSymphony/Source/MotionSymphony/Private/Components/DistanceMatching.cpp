@@ -3,7 +3,6 @@
 #include "Components/DistanceMatching.h"
 #include "DrawDebugHelpers.h"
 #include "MatchFeatures/MatchFeature_Distance.h"
-#include "Runtime/Launch/Resources/Version.h"
 
 #define LOCTEXT_NAMESPACE "MotionSymphony"
 
@@ -398,117 +397,32 @@ void UDistanceMatching::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 
 FDistanceMatchingModule::FDistanceMatchingModule()
 	: AnimSequence(nullptr),
-	LastKeyChecked(0),
-	MaxDistance(0.0f)
+	bLookupNegated(false)
 {
 
 }
 
-void FDistanceMatchingModule::Setup(UAnimSequenceBase* InAnimSequence, const FName& DistanceCurveName)
+void FDistanceMatchingModule::Setup(UAnimSequenceBase* InAnimSequence, const FName& DistanceCurveName, const bool bNegateCurve)
 {
 	AnimSequence = InAnimSequence;
-
-	if(!AnimSequence)
-	{
-		return;
-	}
-
-	
-#if ENGINE_MINOR_VERSION > 2	
-	const FRawCurveTracks& RawCurves = InAnimSequence->GetCurveData();
-	if(const FFloatCurve* DistanceCurve = static_cast<const FFloatCurve*>(RawCurves.GetCurveData(DistanceCurveName)))
-	{
-		CurveKeys = DistanceCurve->FloatCurve.GetCopyOfKeys();
-
-		for (const FRichCurveKey& Key : CurveKeys)
-		{
-			if (FMath::Abs(Key.Value) > MaxDistance)
-			{
-				MaxDistance = FMath::Abs(Key.Value);
-			}
-		}
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Distance matching curve could not be found. Distance matching node will not operate as expected."));
-	}
-#else
-	FSmartName CurveName;
-	InAnimSequence->GetSkeleton()->GetSmartNameByName(USkeleton::AnimCurveMappingName, DistanceCurveName, CurveName);
-	if (CurveName.IsValid())
-	{
-		const FRawCurveTracks& RawCurves = InAnimSequence->GetCurveData();
-		if(const FFloatCurve* DistanceCurve = static_cast<const FFloatCurve*>(RawCurves.GetCurveData(CurveName.UID)))
-		{
-			CurveKeys = DistanceCurve->FloatCurve.GetCopyOfKeys();
-
-			for (const FRichCurveKey& Key : CurveKeys)
-			{
-				if (FMath::Abs(Key.Value) > MaxDistance)
-				{
-					MaxDistance = FMath::Abs(Key.Value);
-				}
-			}
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Distance matching curve could not be found. Distance matching node will not operate as expected."));
-		}
-	}
-#endif
+	CurveName = DistanceCurveName;
+	bLookupNegated = bNegateCurve;
+	LookupTable = FDistanceTimeLookupTable::FindOrCreate(AnimSequence, CurveName, bLookupNegated);
 }
 
 void FDistanceMatchingModule::Initialize()
 {
-	LastKeyChecked = 0;
 }
 
 float FDistanceMatchingModule::FindMatchingTime(float DesiredDistance, bool bNegateCurve)
 {
-	if(CurveKeys.Num() < 2
-	|| FMath::Abs(DesiredDistance) > FMath::Abs(MaxDistance))
-	{
-		return -1.0f;
-	}
-
-	//Find the time in the animation with the matching distance
-	LastKeyChecked = FMath::Clamp(LastKeyChecked, 0, CurveKeys.Num() - 1);
-	FRichCurveKey* PKey = &CurveKeys[LastKeyChecked];
-	FRichCurveKey* SKey = nullptr;
-
-	const float Negator = bNegateCurve ? -1.0f : 1.0f;
-
-	for (int32 i = LastKeyChecked; i < CurveKeys.Num(); ++i)
-	{
-		FRichCurveKey& Key = CurveKeys[i];
-
-		if (Key.Value * Negator > DesiredDistance)
-		{
-			PKey = &Key;
-			//LastKeyChecked = i;
-		}
-		else
-		{
-			SKey = &Key;
-			break;
-		}
-	}
-
-	if (!SKey)
-	{
-		return PKey->Time;
-	}
-
-	const float DV = (SKey->Value * Negator) - (PKey->Value * Negator);
-
-	if(DV < 0.000001f)
+	if(bNegateCurve != bLookupNegated)
 	{
-		return PKey->Time;
+		bLookupNegated = bNegateCurve;
+		LookupTable = FDistanceTimeLookupTable::FindOrCreate(AnimSequence, CurveName, bLookupNegated);
 	}
 
-	const float DT = SKey->Time - PKey->Time;
-
-	return ((DT / DV) * (DesiredDistance - (PKey->Value * Negator))) + PKey->Time;
+	return LookupTable ? LookupTable->FindMatchingTime(DesiredDistance) : -1.0f;
 }
 
 bool UDistanceMatching::CalculateStartLocation(FVector& OutStartLocation, const float DeltaTime, const int32 MaxIterations) const
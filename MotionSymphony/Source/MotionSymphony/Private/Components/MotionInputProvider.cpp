@@ -0,0 +1,138 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Components/MotionInputProvider.h"
+#include "Objects/MatchFeatures/MatchFeatureBase.h"
+#include "Components/SkeletalMeshComponent.h"
+
+UMotionInputProvider::UMotionInputProvider()
+	: MotionMatchConfig(nullptr),
+	  ResponseDimensionCount(0),
+	  bInputSourcesResolved(false),
+	  InputSequence(0)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UMotionInputProvider::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ResolveInputSources();
+}
+
+void UMotionInputProvider::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if(!bInputSourcesResolved)
+	{
+		return;
+	}
+
+	InputBuffer.SetNumUninitialized(ResponseDimensionCount, false);
+	for(int32 i = 0; i < InputFeatures.Num(); ++i)
+	{
+		InputFeatures[i]->SourceResolvedInputData(InputBuffer, InputFeatureOffsets[i], InputSources[i]);
+	}
+
+	//Zero is reserved for a buffer that has never been written
+	InputSequence = FMath::Max(InputSequence + 1, 1u);
+}
+
+void UMotionInputProvider::ResolveInputSources()
+{
+	bInputSourcesResolved = false;
+	InputSources.Empty();
+	InputFeatures.Empty();
+	InputFeatureOffsets.Empty();
+	ResponseDimensionCount = 0;
+	
+	if(!MotionMatchConfig)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MotionInputProvider: Cannot resolve input sources with a null MotionMatchConfig, please make sure it is set on the component."));
+		return;
+	}
+
+	AActor* OwningActor = GetOwner();
+	if(!OwningActor)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MotionInputProvider: Cannot resolve input sources with a null OwningActor."));
+		return;
+	}
+
+	if(MotionMatchConfig->NeedsInitialization())
+	{
+		MotionMatchConfig->Initialize();
+	}
+	
+	//Input is copied during the animation update so the buffer must be written before the skeletal meshes tick
+	TArray<USkeletalMeshComponent*> SkelMeshComponents;
+	OwningActor->GetComponents<USkeletalMeshComponent>(SkelMeshComponents);
+	for(USkeletalMeshComponent* SkelMeshComponent : SkelMeshComponents)
+	{
+		if(SkelMeshComponent)
+		{
+			SkelMeshComponent->AddTickPrerequisiteComponent(this);
+		}
+	}
+
+	const int32 FeatureCount = MotionMatchConfig->InputResponseFeatures.Num();
+	InputSources.Reserve(FeatureCount);
+	InputFeatures.Reserve(FeatureCount);
+	InputFeatureOffsets.Reserve(FeatureCount);
+	
+	int32 FeatureOffset = 0;
+	for(const TObjectPtr<UMatchFeatureBase> MatchFeature : MotionMatchConfig->InputResponseFeatures)
+	{
+		if(!MatchFeature || !MatchFeature->IsSetupValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("MotionInputProvider: Match feature has an invalid setup and cannot be processed."));
+			continue;
+		}
+
+		UObject* InputSource = MatchFeature->ResolveInputSource(OwningActor);
+		
+		//The source must finish ticking before its input is written to the buffer
+		UActorComponent* SourceComponent = Cast<UActorComponent>(InputSource);
+		if(SourceComponent
+			&& SourceComponent != this
+			&& SourceComponent->PrimaryComponentTick.bCanEverTick)
+		{
+			AddTickPrerequisiteComponent(SourceComponent);
+		}
+
+		InputSources.Add(InputSource);
+		InputFeatures.Add(MatchFeature);
+		InputFeatureOffsets.Add(FeatureOffset);
+		FeatureOffset += MatchFeature->Size();
+	}
+
+	ResponseDimensionCount = FeatureOffset;
+	bInputSourcesResolved = true;
+}
+
+bool UMotionInputProvider::CopyInputArray(TArray<float>& OutDesiredInputArray, uint32& InOutSequence) const
+{
+	if(InputSequence == 0
+		|| InputSequence == InOutSequence
+		|| InputBuffer.Num() != ResponseDimensionCount
+		|| OutDesiredInputArray.Num() < ResponseDimensionCount)
+	{
+		return false;
+	}
+
+	FMemory::Memcpy(OutDesiredInputArray.GetData(), InputBuffer.GetData(), ResponseDimensionCount * sizeof(float));
+	InOutSequence = InputSequence;
+	return true;
+}
+
+int32 UMotionInputProvider::GetResponseDimensionCount() const
+{
+	return ResponseDimensionCount;
+}
+
+bool UMotionInputProvider::IsReady() const
+{
+	return bInputSourcesResolved;
+}
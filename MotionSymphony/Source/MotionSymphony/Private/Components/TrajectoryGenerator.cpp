@@ -9,10 +9,25 @@
 #include "Navigation/PathFollowingComponent.h"
 #include "AIController.h"
 #include "Quaternion.h"
+#include "Subsystems/TrajectoryPredictionSubsystem.h"
 #include "WorldPartition/RuntimeSpatialHash/RuntimeSpatialHashGridHelper.h"
 
 #define EPSILON 0.0001f
 
+FTrajectoryCapsuleInput::FTrajectoryCapsuleInput()
+	: Velocity(FVector::ZeroVector),
+	Acceleration(FVector::ZeroVector),
+	Friction(0.0f),
+	BrakingDeceleration(0.0f),
+	MaxSpeed(0.0f),
+	StartYaw(0.0f),
+	DesiredYaw(0.0f),
+	MaxYawStep(0.0f),
+	bOrientRotationToMovement(false),
+	SampleInterval(0.0f)
+{
+}
+
 UTrajectoryGenerator::UTrajectoryGenerator()
 	: StrafeDirection(FVector(0.0f)),
 	  MaxSpeed(400.0f), 
@@ -22,26 +37,68 @@ UTrajectoryGenerator::UTrajectoryGenerator()
       TrajectoryModel(ETrajectoryModel::Spring),
 	  TrajectoryBehaviour(ETrajectoryMoveMode::Standard),
 	  TrajectoryControlMode(ETrajectoryControlMode::PlayerControlled),
+	  bUseBatchedPrediction(false),
 	  LastDesiredOrientation(0.0f),
       MoveResponse_Remapped(15.0f),
-	  TurnResponse_Remapped(15.0f)
+	  TurnResponse_Remapped(15.0f),
+	  bPathArcLengthCacheDirty(true)
 {
 }
 
-void UTrajectoryGenerator::UpdatePrediction(float DeltaTime)
+void UTrajectoryGenerator::BeginPlay()
 {
-	if(TrajectoryControlMode == ETrajectoryControlMode::AIControlled
-		&& !bUsePathAsTrajectoryForAI)
+	Super::BeginPlay();
+
+	if(!bUseBatchedPrediction)
 	{
-		CalculateInputVectorFromAINavAgent();
+		return;
 	}
+
+	const UWorld* World = GetWorld();
+	if(UTrajectoryPredictionSubsystem* PredictionSubsystem = World ? World->GetSubsystem<UTrajectoryPredictionSubsystem>() : nullptr)
+	{
+		if(PredictionSubsystem->RegisterGenerator(this))
+		{
+			SetComponentTickEnabled(false);
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TrajectoryGenerator: Batched prediction is not supported in this world. The generator will tick on its own."));
+	}
+}
+
+bool UTrajectoryGenerator::SupportsBatchedPrediction() const
+{
+	//Blueprint subclasses cannot override the prediction functions so only the nearest native class is checked
+	const UClass* NativeClass = GetClass();
+	while(NativeClass && !NativeClass->HasAnyClassFlags(CLASS_Native))
+	{
+		NativeClass = NativeClass->GetSuperClass();
+	}
+
+	return NativeClass == UTrajectoryGenerator::StaticClass();
+}
+
+void UTrajectoryGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseCachedPath();
+
+	const UWorld* World = GetWorld();
+	if(UTrajectoryPredictionSubsystem* PredictionSubsystem = World ? World->GetSubsystem<UTrajectoryPredictionSubsystem>() : nullptr)
+	{
+		PredictionSubsystem->UnregisterGenerator(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTrajectoryGenerator::UpdatePrediction(float DeltaTime)
+{
+	FVector DesiredLinearDisplacement;
+	CalculateDesiredLinearDisplacement(DesiredLinearDisplacement);
 	
-	FVector DesiredLinearVelocity;
-	CalculateDesiredLinearVelocity(DesiredLinearVelocity);
-	const FVector DesiredLinearDisplacement = DesiredLinearVelocity / FMath::Max(EPSILON, SampleRate);
-	
-	if(TrajectoryControlMode == ETrajectoryControlMode::AIControlled
-		&& bUsePathAsTrajectoryForAI)
+	if(UsesPathFollowPrediction())
 	{
 		PathFollowPrediction(DeltaTime, TrajectoryIterations, DesiredLinearDisplacement);
 	}
@@ -57,87 +114,120 @@ void UTrajectoryGenerator::UpdatePrediction(float DeltaTime)
 			{
 				CapsulePrediction(DeltaTime);
 			} break;
+		case ETrajectoryModel::CriticallyDampedSpring:
+			{
+				CriticallyDampedSpringPrediction(DesiredLinearDisplacement);
+			} break;
 		}
 	}
 
 	Super::UpdatePrediction(DeltaTime); //Need this for debug drawing
 }
 
-void UTrajectoryGenerator::PathFollowPrediction(const float DeltaTime, const int32 Iterations, const FVector& DesiredLinearDisplacement)
+bool UTrajectoryGenerator::UsesPathFollowPrediction() const
 {
-	const FVector RefLocation = OwningActor->GetActorLocation();
-	if(APawn* Pawn = Cast<APawn>(OwningActor))
+	return TrajectoryControlMode == ETrajectoryControlMode::AIControlled
+		&& bUsePathAsTrajectoryForAI;
+}
+
+void UTrajectoryGenerator::CalculateDesiredLinearDisplacement(FVector& OutDisplacement)
+{
+	if(TrajectoryControlMode == ETrajectoryControlMode::AIControlled
+		&& !bUsePathAsTrajectoryForAI)
 	{
-		if(AAIController* Controller = Pawn->GetController<AAIController>())
-		{
-			if(UPathFollowingComponent* PathComponent = Controller->GetPathFollowingComponent())
-			{
-				if(const FNavigationPath* PathPtr = PathComponent->GetPath().Get())
-				{
-					const TArray<FNavPathPoint>& Points = PathPtr->GetPathPoints();
-					
-					if(Points.Num() > 0)
-					{
-						const float Step = DesiredLinearDisplacement.Size();
-						float Overflow = Step;
-
-						const int32 PathStartIndex = PathComponent->GetCurrentPathIndex() + 1;
-						int32 TrajectoryPointIndex = 1;
-						bool bTrajectoryEnded = Step <= 0;
-						for(int32 PathPointIndex = PathStartIndex; !bTrajectoryEnded && PathPointIndex < Points.Num(); ++PathPointIndex)
-						{
-							FVector StartLocation = Points[PathPointIndex - 1].Location;
-							FVector EndLocation = Points[PathPointIndex].Location;
-							if(PathPointIndex == PathStartIndex)
-							{
-								StartLocation = FMath::ClosestPointOnLine(StartLocation, EndLocation, RefLocation);
-							}
-
-							const FVector Segment = EndLocation - StartLocation;
-							const FVector SegmentDir = Segment.GetSafeNormal();
-							const float Yaw = SegmentDir.Rotation().Yaw;
-							const float SegmentLength = Segment.Size();
-
-							float Length = Overflow;
-							Overflow = 0.0f;
-							FVector Ref = StartLocation - RefLocation;
-							Ref.Z = 0.0f;
-							while(!bTrajectoryEnded&& Length < SegmentLength)
-							{
-								TrajPositions[TrajectoryPointIndex] = Ref + SegmentDir * Length;
-								TrajPositions[TrajectoryPointIndex].Z = 0;
-								TrajRotations[TrajectoryPointIndex] = Yaw;
-								Length += Step;
-
-								bTrajectoryEnded = ++TrajectoryPointIndex == Iterations;
-							}
-							Overflow = Length - SegmentLength;
-						}
-						if(!bTrajectoryEnded)
-						{
-							while(TrajectoryPointIndex < Iterations)
-							{
-								TrajPositions[TrajectoryPointIndex] = TrajPositions[TrajectoryPointIndex - 1];
-								TrajRotations[TrajectoryPointIndex] = TrajRotations[TrajectoryPointIndex - 1];
-								++TrajectoryPointIndex;
-							}
-						}
-						
-						TrajRotations[0] = OwningActor->GetActorRotation().Yaw;
-					}
-				}
-			}
-		}
+		CalculateInputVectorFromAINavAgent();
 	}
+	
+	FVector DesiredLinearVelocity;
+	CalculateDesiredLinearVelocity(DesiredLinearVelocity);
+	OutDisplacement = DesiredLinearVelocity / FMath::Max(EPSILON, SampleRate);
 }
 
-void UTrajectoryGenerator::InputPrediction(const float DeltaTime, const FVector& DesiredLinearDisplacement)
+void UTrajectoryGenerator::FinishBatchedPrediction(float DeltaTime)
 {
-	if(NewTrajPosition.Num() == 0)
+	Super::UpdatePrediction(DeltaTime); //Need this for debug drawing
+	FinalizeTrajectoryUpdate();
+}
+
+void UTrajectoryGenerator::PathFollowPrediction(const float DeltaTime, const int32 Iterations, const FVector& DesiredLinearDisplacement)
+{
+	const APawn* Pawn = Cast<APawn>(OwningActor);
+	const AAIController* Controller = Pawn ? Pawn->GetController<AAIController>() : nullptr;
+	const UPathFollowingComponent* PathComponent = Controller ? Controller->GetPathFollowingComponent() : nullptr;
+	if(!PathComponent || !PathComponent->GetPath().IsValid())
 	{
+		ReleaseCachedPath();
 		return;
 	}
+
+	UpdatePathArcLengthCache(PathComponent->GetPath());
+	if(PathArcLengthCache.IsEmpty())
+	{
+		return;
+	}
+
+	TrajRotations[0] = OwningActor->GetActorRotation().Yaw;
 	
+	const float Step = DesiredLinearDisplacement.Size();
+	if(Step <= 0.0f)
+	{
+		return;
+	}
+
+	//Each trajectory point is a fixed arc length further along the path than the last, starting from the closest
+	//point on the current path segment
+	const FVector RefLocation = OwningActor->GetActorLocation();
+	const float StartArcLength = PathArcLengthCache.ProjectOntoSegment(PathComponent->GetCurrentPathIndex(), RefLocation);
+	for(int32 TrajectoryPointIndex = 1; TrajectoryPointIndex < Iterations; ++TrajectoryPointIndex)
+	{
+		FVector PathLocation;
+		PathArcLengthCache.SampleForward(StartArcLength + Step * TrajectoryPointIndex, PathLocation, TrajRotations[TrajectoryPointIndex]);
+
+		TrajPositions[TrajectoryPointIndex] = PathLocation - RefLocation;
+		TrajPositions[TrajectoryPointIndex].Z = 0.0f;
+	}
+}
+
+void UTrajectoryGenerator::UpdatePathArcLengthCache(const FNavPathSharedPtr& InPath)
+{
+	if(CachedPath != InPath)
+	{
+		ReleaseCachedPath();
+
+		CachedPath = InPath;
+		CachedPathObserverHandle = InPath->AddObserver(FNavigationPath::FPathObserverDelegate::FDelegate::CreateUObject(
+			this, &UTrajectoryGenerator::OnCachedPathEvent));
+		bPathArcLengthCacheDirty = true;
+	}
+
+	if(bPathArcLengthCacheDirty)
+	{
+		PathArcLengthCache.Build(InPath->GetPathPoints());
+		bPathArcLengthCacheDirty = false;
+	}
+}
+
+void UTrajectoryGenerator::ReleaseCachedPath()
+{
+	if(const FNavPathSharedPtr Path = CachedPath.Pin())
+	{
+		Path->RemoveObserver(CachedPathObserverHandle);
+	}
+
+	CachedPath.Reset();
+	CachedPathObserverHandle.Reset();
+	PathArcLengthCache.Reset();
+	bPathArcLengthCacheDirty = true;
+}
+
+void UTrajectoryGenerator::OnCachedPathEvent(FNavigationPath* InPath, ENavPathEvent::Type InEvent)
+{
+	//Any event can change the path points (e.g. repath, goal moved, meta path waypoint switch)
+	bPathArcLengthCacheDirty = true;
+}
+
+float UTrajectoryGenerator::CalculateDesiredOrientation(const FVector& DesiredLinearDisplacement)
+{
 	float DesiredOrientation;
 	if (TrajectoryBehaviour != ETrajectoryMoveMode::Standard)
 	{
@@ -164,29 +254,47 @@ void UTrajectoryGenerator::InputPrediction(const float DeltaTime, const FVector&
 	}
 
 	LastDesiredOrientation = DesiredOrientation;
+	return DesiredOrientation;
+}
+
+void UTrajectoryGenerator::InputPrediction(const float DeltaTime, const FVector& DesiredLinearDisplacement)
+{
+	if(NewTrajPosition.Num() == 0)
+	{
+		return;
+	}
+	
+	const float DesiredOrientation = CalculateDesiredOrientation(DesiredLinearDisplacement);
 
 	NewTrajPosition[0] = FVector::ZeroVector;
 	TrajRotations[0] = 0.0f;
 
 	const int32 Iterations = TrajPositions.Num();
-	//float CumRotation = 0.0f;
+	
+	//The spring progress at each iteration is 1 - Exp(-Response * DeltaTime * Percentage). Percentage grows linearly
+	//so the exponential term is a geometric series that is accumulated with one multiply per iteration.
+	const float PercentageStep = 1.0f / FMath::Max(1.0f, static_cast<float>(Iterations - 1));
+	const float MoveDecayStep = FMath::Exp(-MoveResponse_Remapped * DeltaTime * PercentageStep);
+	const float TurnDecayStep = FMath::Exp(-TurnResponse_Remapped * DeltaTime * PercentageStep);
+	const float DesiredOrientationRad = FMath::DegreesToRadians(DesiredOrientation);
+	float MoveDecay = 1.0f;
+	float TurnDecay = 1.0f;
 	
 	for (int32 i = 1; i < Iterations; ++i)
 	{
-		const float Percentage = static_cast<float>(i) / FMath::Max(1.0f, static_cast<float>(Iterations - 1));
+		MoveDecay *= MoveDecayStep;
+		TurnDecay *= TurnDecayStep;
+		
 		FVector TrajDisplacement = TrajPositions[i] - TrajPositions[i-1];
 
-		FVector AdjustedTrajDisplacement = FMath::Lerp(TrajDisplacement, DesiredLinearDisplacement,
-			1.0f - FMath::Exp((-MoveResponse_Remapped * DeltaTime) * Percentage));
+		FVector AdjustedTrajDisplacement = FMath::Lerp(TrajDisplacement, DesiredLinearDisplacement, 1.0f - MoveDecay);
 
 		NewTrajPosition[i] = NewTrajPosition[i - 1] + AdjustedTrajDisplacement;
 
-		//TrajRotations[i] = DesiredOrientation;
-
 		TrajRotations[i] = FMath::RadiansToDegrees(FMotionMatchingUtils::LerpAngle(
 			FMath::DegreesToRadians(TrajRotations[i]),
-			FMath::DegreesToRadians(DesiredOrientation) ,
-			1.0f - FMath::Exp((-TurnResponse_Remapped * DeltaTime) * Percentage)));
+			DesiredOrientationRad,
+			1.0f - TurnDecay));
 	}
 
 	for (int32 i = 0; i < Iterations; ++i)
@@ -195,56 +303,133 @@ void UTrajectoryGenerator::InputPrediction(const float DeltaTime, const FVector&
 	}
 }
 
+void UTrajectoryGenerator::CriticallyDampedSpringPrediction(const FVector& DesiredLinearDisplacement)
+{
+	if(TrajPositions.Num() == 0)
+	{
+		return;
+	}
+	
+	const float DesiredOrientation = CalculateDesiredOrientation(DesiredLinearDisplacement);
+
+	//The desired displacement is per trajectory iteration
+	const FVector DesiredVelocity = DesiredLinearDisplacement * SampleRate;
+	FVector CurrentVelocity = OwningActor->GetVelocity();
+	CurrentVelocity.Z = 0.0f;
+
+	//The velocity is sprung towards the desired velocity and integrated for position while the facing is sprung
+	//towards the desired orientation. The responses act as the spring damping (y = damping / 2).
+	const float MoveY = FMath::Max(MoveResponse_Remapped * 0.5f, EPSILON);
+	const float TurnY = FMath::Max(TurnResponse_Remapped * 0.5f, EPSILON);
+	const FVector J0 = CurrentVelocity - DesiredVelocity;
+	const FVector J1 = J0 * MoveY;
+	const FVector PositionOffset = J1 / (MoveY * MoveY) + J0 / MoveY;
+	const float FacingError = FRotator::NormalizeAxis(CurFacingAngle + CharacterFacingOffset - DesiredOrientation);
+
+	auto EvaluateSpring = [&](const int32 Index, const float Time)
+	{
+		const float MoveDecay = FMath::Exp(-MoveY * Time);
+		TrajPositions[Index] = MoveDecay * (-J1 / (MoveY * MoveY) + (-J0 - J1 * Time) / MoveY)
+			+ PositionOffset + DesiredVelocity * Time;
+		TrajRotations[Index] = DesiredOrientation + FacingError * (1.0f + TurnY * Time) * FMath::Exp(-TurnY * Time);
+	};
+
+#if WITH_EDITORONLY_DATA
+	//Every point is only needed for debug drawing
+	if(bDrawTrajectory)
+	{
+		for(int32 i = 1; i < TrajPositions.Num(); ++i)
+		{
+			EvaluateSpring(i, i / SampleRate);
+		}
+	}
+#endif
+
+	//Otherwise only the points that are extracted are evaluated. Each is evaluated at the time its sample index
+	//represents so that it is in phase with the other trajectory models.
+	for(const float TimeDelay : TrajTimes)
+	{
+		if(TimeDelay > 0.0f)
+		{
+			const int32 SampleIndex = GetFutureSampleIndex(TimeDelay);
+			EvaluateSpring(SampleIndex, SampleIndex / SampleRate);
+		}
+	}
+
+	TrajPositions[0] = FVector::ZeroVector;
+	TrajRotations[0] = 0.0f;
+}
+
 void UTrajectoryGenerator::CapsulePrediction(const float DeltaTime)
 {
+	FTrajectoryCapsuleInput CapsuleInput;
+	if(GatherCapsuleInput(DeltaTime, CapsuleInput))
+	{
+		SolveCapsulePrediction(CapsuleInput, TrajPositions.GetData(), TrajRotations.GetData(), TrajectoryIterations);
+	}
+}
+
+bool UTrajectoryGenerator::GatherCapsuleInput(const float DeltaTime, FTrajectoryCapsuleInput& OutInput) const
+{
+	if(!CharacterMovement)
+	{
+		return false;
+	}
+	
 	//Movement
-	const FVector CurrentLocation = OwningActor->GetActorLocation();
-	FVector Velocity = CharacterMovement->Velocity;
-	const FVector Acceleration = CharacterMovement->GetCurrentAcceleration();
-	const bool bZeroAcceleration = Acceleration.IsZero();
-	float Friction = CharacterMovement->GroundFriction;
-	const float BrakingDeceleration = CharacterMovement->BrakingDecelerationWalking;
+	OutInput.Velocity = CharacterMovement->Velocity;
+	OutInput.Acceleration = CharacterMovement->GetCurrentAcceleration();
+	OutInput.Friction = CharacterMovement->GroundFriction;
+	OutInput.BrakingDeceleration = CharacterMovement->BrakingDecelerationWalking;
+	OutInput.MaxSpeed = CharacterMovement->GetMaxSpeed();
+	OutInput.SampleInterval = 1.0f / SampleRate;
 
 	//Rotation
-	FRotator CurrentRotation = OwningActor->GetActorRotation();
-	FRotator DeltaRot = CharacterMovement->GetDeltaRotation(DeltaTime);
-	FRotator DesiredRotation = CharacterMovement->ComputeOrientToMovementRotation(CurrentRotation, 1.0f / SampleRate, DeltaRot);
-	//DesiredRotation.Pitch = 0.0f;
-	//DesiredRotation.Roll = 0.0f;
-	DesiredRotation.Yaw = FRotator::NormalizeAxis(DesiredRotation.Yaw);
-	const float AngleTolerance = 1e-3f;
+	const FRotator CurrentRotation = OwningActor->GetActorRotation();
+	const FRotator DeltaRot = CharacterMovement->GetDeltaRotation(DeltaTime);
+	const FRotator DesiredRotation = CharacterMovement->ComputeOrientToMovementRotation(CurrentRotation, 1.0f / SampleRate, DeltaRot);
+	OutInput.StartYaw = CurrentRotation.Yaw;
+	OutInput.DesiredYaw = FRotator::NormalizeAxis(DesiredRotation.Yaw);
+	OutInput.MaxYawStep = DeltaRot.Yaw;
+	OutInput.bOrientRotationToMovement = CharacterMovement->bOrientRotationToMovement;
 	
 	if(!HasMoveInput())
 	{
-		Friction = CharacterMovement->BrakingFriction * CharacterMovement->BrakingFrictionFactor;
+		OutInput.Friction = CharacterMovement->BrakingFriction * CharacterMovement->BrakingFrictionFactor;
 	}
 
-	Friction = FMath::Max(Friction, 0.0f);
-	const bool bZeroFriction = (Friction < 0.00001f);
-	const bool bZeroBraking = (BrakingDeceleration < 0.00001f);
-	
-	if(bZeroAcceleration
-		&& bZeroFriction
-		&& bZeroBraking)
-	{
-		return;
-	}
+	OutInput.Friction = FMath::Max(OutInput.Friction, 0.0f);
 	
-	FVector LastLocation = CurrentLocation;
-	float LastYaw = CurrentRotation.Yaw;
-	TrajPositions[0] = FVector::ZeroVector;
-	TrajRotations[0] = 0.0f;
+	return !OutInput.Acceleration.IsZero()
+		|| OutInput.Friction >= 0.00001f
+		|| OutInput.BrakingDeceleration >= 0.00001f;
+}
 
-	FVector AccelDir = Acceleration.GetSafeNormal();
+void UTrajectoryGenerator::SolveCapsulePrediction(const FTrajectoryCapsuleInput& InInput, FVector* OutPositions,
+	float* OutRotations, const int32 InIterations)
+{
+	const bool bZeroAcceleration = InInput.Acceleration.IsZero();
+	const bool bZeroBraking = (InInput.BrakingDeceleration < 0.00001f);
+	const float Friction = InInput.Friction;
+	const float AngleTolerance = 1e-3f;
+	
+	FVector LastLocation = FVector::ZeroVector;
+	float LastYaw = InInput.StartYaw;
+	float CurrentYaw = InInput.StartYaw;
+	OutPositions[0] = FVector::ZeroVector;
+	OutRotations[0] = 0.0f;
+
+	FVector Velocity = InInput.Velocity;
+	FVector AccelDir = InInput.Acceleration.GetSafeNormal();
 	AccelDir.Z = 0.0f;
 	Velocity.Z = 0.0f;
 	constexpr float MaxDeltaTime = 1.0f / 33.0f;
-	for(int32 TrajectoryIndex = 1; TrajectoryIndex < TrajectoryIterations; ++TrajectoryIndex)
+	for(int32 TrajectoryIndex = 1; TrajectoryIndex < InIterations; ++TrajectoryIndex)
 	{
 		const FVector OldVel = Velocity;
-		const FVector BrakeDeceleration (bZeroBraking ? FVector::ZeroVector : (-BrakingDeceleration * Velocity.GetSafeNormal()));
+		const FVector BrakeDeceleration (bZeroBraking ? FVector::ZeroVector : (-InInput.BrakingDeceleration * Velocity.GetSafeNormal()));
 		
-		float RemainingTime = 1.0 / SampleRate;
+		float RemainingTime = InInput.SampleInterval;
 		constexpr float MIN_TICK_TIME = 1e-6;
 		while(RemainingTime >= MIN_TICK_TIME)
 		{
@@ -260,7 +445,7 @@ void UTrajectoryGenerator::CapsulePrediction(const float DeltaTime)
 				  if((Velocity | OldVel) <= 0.0f)
 				  {
 				  	Velocity = FVector::ZeroVector;
-				  	TrajPositions[TrajectoryIndex] = LastLocation - CurrentLocation;
+				  	OutPositions[TrajectoryIndex] = LastLocation;
 				  	break;
 				  }
 			}
@@ -271,8 +456,8 @@ void UTrajectoryGenerator::CapsulePrediction(const float DeltaTime)
 				Velocity = Velocity - (Velocity - AccelDir * VelSize) * FMath::Min(DT * Friction, 1.0f);
 
 				//Apply Acceleration
-				Velocity += Acceleration * DT;
-				Velocity = Velocity.GetClampedToMaxSize(CharacterMovement->GetMaxSpeed());
+				Velocity += InInput.Acceleration * DT;
+				Velocity = Velocity.GetClampedToMaxSize(InInput.MaxSpeed);
 			}
 		}
 
@@ -283,20 +468,20 @@ void UTrajectoryGenerator::CapsulePrediction(const float DeltaTime)
 			Velocity = FVector::ZeroVector;
 		}
 		
-		LastLocation += Velocity * (1.0f / SampleRate);
+		LastLocation += Velocity * InInput.SampleInterval;
 
-		TrajPositions[TrajectoryIndex] = LastLocation - CurrentLocation;
+		OutPositions[TrajectoryIndex] = LastLocation;
 
 		//Rotation
-		if(CharacterMovement->bOrientRotationToMovement)
+		if(InInput.bOrientRotationToMovement)
 		{
-			if(!FMath::IsNearlyEqual(LastYaw, DesiredRotation.Yaw, AngleTolerance))
+			if(!FMath::IsNearlyEqual(LastYaw, InInput.DesiredYaw, AngleTolerance))
 			{
-				CurrentRotation.Yaw = FMath::FixedTurn(LastYaw, DesiredRotation.Yaw, DeltaRot.Yaw);
+				CurrentYaw = FMath::FixedTurn(LastYaw, InInput.DesiredYaw, InInput.MaxYawStep);
 			}
-			LastYaw = CurrentRotation.Yaw;
+			LastYaw = CurrentYaw;
 
-			TrajRotations[TrajectoryIndex] = CurrentRotation.Yaw;
+			OutRotations[TrajectoryIndex] = CurrentYaw;
 		}
 	}
 }
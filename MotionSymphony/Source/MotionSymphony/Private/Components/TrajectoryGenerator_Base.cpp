@@ -5,6 +5,7 @@
 #include "EMotionMatchingEnums.h"
 #include "Utility/MotionMatchingUtils.h"
 #include "Data/InputProfile.h"
+#include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "Objects/MatchFeatures/MatchFeature_Trajectory2D.h"
 #include "Objects/MatchFeatures/MatchFeature_Trajectory3D.h"
@@ -13,6 +14,29 @@
 #define EPSILON 0.0001f
 #define THIRTY_HZ 1.0f / 30.0f
 
+FTrajectoryCollisionPlane::FTrajectoryCollisionPlane(const FVector& InLocation, const FVector& InNormal,
+	const float InHalfWidth, const int32 InSegmentIndex)
+	: Location(InLocation),
+	Normal(InNormal),
+	Tangent(FVector(-InNormal.Y, InNormal.X, 0.0f)),
+	HalfWidth(InHalfWidth),
+	SegmentIndex(InSegmentIndex)
+{
+}
+
+void FTrajectoryCollisionPlane::Clip(FVector& InOutPosition) const
+{
+	const FVector Offset = InOutPosition - Location;
+	const float Penetration = FVector::DotProduct(Offset, Normal);
+
+	//Points past the ends of the swept stretch of surface (e.g. around a corner) are not blocked by it
+	if(Penetration < 0.0f
+		&& FMath::Abs(FVector::DotProduct(Offset, Tangent)) <= HalfWidth)
+	{
+		InOutPosition -= Normal * Penetration;
+	}
+}
+
 // Sets default values for this component's properties
 UTrajectoryGenerator_Base::UTrajectoryGenerator_Base()
 	: MotionMatchConfig(nullptr) ,
@@ -21,6 +45,9 @@ UTrajectoryGenerator_Base::UTrajectoryGenerator_Base()
 	  bFlattenTrajectory(false),
 	  bDebugRandomInput(false),
 	  DebugTimeIntervalRange(FVector2D(1.5f, 5.0f)),
+	  bEnableTrajectoryCollision(false),
+	  TrajectoryCollisionChannel(ECC_Pawn),
+	  TrajectoryCollisionRadius(30.0f),
 	  Trajectory(FTrajectory()),
 	  InputVector(FVector(0.0f)),
 	  MaxRecordTime(1.0f),
@@ -113,20 +140,20 @@ void UTrajectoryGenerator_Base::BeginPlay()
 		RecordingFrequency = THIRTY_HZ;
 	}
 
+	//Records are taken on the first frame after the recording frequency has elapsed so the real interval can be up to a
+	//frame longer. Twice the nominal number of recordings is kept so that the full past horizon is always covered.
 	const int32 MaxPastRecordings = FMath::CeilToInt(MaxRecordTime / RecordingFrequency);
-	RecordedPastPositions.Empty(MaxPastRecordings + 1);
-	RecordedPastRotations.Empty(MaxPastRecordings + 1);
-	RecordedPastTimes.Empty(MaxPastRecordings + 1);
+	RecordedPastTrajectory.Initialize(2 * MaxPastRecordings + 1);
 	CumActiveTime = 0.0f;
 	TimeSinceLastRecord = 0.0f;
 
-	FVector StartPos = OwningActor->GetActorLocation();
-	float StartRot = OwningActor->GetActorRotation().Euler().Z;
-	for (int32 i = 0; i < MaxPastRecordings; ++i)
+	//Fill the history as if the character had been standing still before play began
+	const FVector StartPos = OwningActor->GetActorLocation();
+	const float StartRot = OwningActor->GetActorRotation().Euler().Z;
+	const int32 PastRecordingCapacity = RecordedPastTrajectory.Capacity();
+	for (int32 i = 0; i < PastRecordingCapacity; ++i)
 	{
-		RecordedPastPositions.Emplace(StartPos); 
-		RecordedPastRotations.Emplace(StartRot); 
-		RecordedPastTimes.Emplace(TimeStep * i);
+		RecordedPastTrajectory.Record(StartPos, StartRot, -RecordingFrequency * (PastRecordingCapacity - i));
 	}
 
 	//Setup containers for storing future trajectory
@@ -223,12 +250,23 @@ void UTrajectoryGenerator_Base::SetCharacterSkeletalMeshComponent(USkeletalMeshC
 // Called every frame
 void UTrajectoryGenerator_Base::TickComponent(float DeltaTime, ELevelTick TickType, 
 	FActorComponentTickFunction* ThisTickFunction)
+{
+	if(!PrepareTrajectoryUpdate(DeltaTime))
+	{
+		return;
+	}
+
+	UpdatePrediction(DeltaTime);
+	FinalizeTrajectoryUpdate();
+}
+
+bool UTrajectoryGenerator_Base::PrepareTrajectoryUpdate(float DeltaTime)
 {
 	if(!MotionMatchConfig
 		|| !SkelMeshComponent
 		|| !IsValidToUpdatePrediction())
 	{
-		return;
+		return false;
 	}
 
 	bExtractedThisFrame = false;
@@ -243,10 +281,96 @@ void UTrajectoryGenerator_Base::TickComponent(float DeltaTime, ELevelTick TickTy
 		ApplyDebugInput(DeltaTime);
 	}
 
-	UpdatePrediction(DeltaTime);
+	return true;
+}
+
+void UTrajectoryGenerator_Base::FinalizeTrajectoryUpdate()
+{
+	if(bEnableTrajectoryCollision)
+	{
+		UpdateTrajectoryCollision();
+	}
+	else
+	{
+		PendingCollisionTraces.Empty();
+		PendingCollisionSegments.Empty();
+		CollisionPlanes.Empty();
+	}
+	
 	ExtractTrajectory();
 }
 
+void UTrajectoryGenerator_Base::UpdateTrajectoryCollision()
+{
+	UWorld* World = GetWorld();
+	if(!World || !OwningActor)
+	{
+		return;
+	}
+
+	//Async traces complete during the frame they are issued so last frame's results are ready now. A trace that is
+	//not ready or has expired is skipped rather than waited on.
+	CollisionPlanes.Reset();
+	for(int32 SegmentIndex = 0; SegmentIndex < PendingCollisionTraces.Num(); ++SegmentIndex)
+	{
+		FTraceDatum TraceDatum;
+		if(!World->QueryTraceData(PendingCollisionTraces[SegmentIndex], TraceDatum))
+		{
+			continue;
+		}
+
+		const FVector SweptSegment = PendingCollisionSegments[SegmentIndex * 2 + 1] - PendingCollisionSegments[SegmentIndex * 2];
+		for(const FHitResult& Hit : TraceDatum.OutHits)
+		{
+			if(!Hit.bBlockingHit || Hit.bStartPenetrating)
+			{
+				continue;
+			}
+
+			//Walkable surfaces are not obstacles
+			FVector Normal = Hit.Normal;
+			Normal.Z = 0.0f;
+			if(Normal.SizeSquared() < 0.25f)
+			{
+				continue;
+			}
+
+			Normal.Normalize();
+
+			//The surface is only known to block where the segment swept against it
+			const FVector Tangent(-Normal.Y, Normal.X, 0.0f);
+			const float HalfWidth = FMath::Abs(FVector::DotProduct(SweptSegment, Tangent)) + TrajectoryCollisionRadius;
+
+			CollisionPlanes.Emplace(Hit.Location, Normal, HalfWidth, SegmentIndex);
+		}
+	}
+
+	//Sweep the raw prediction between consecutive future trajectory points. The prediction is never clipped itself so
+	//the clipping does not feed back into the prediction or next frame's traces.
+	const FVector ActorLocation = OwningActor->GetActorLocation();
+	const FCollisionShape CollisionShape = FCollisionShape::MakeSphere(TrajectoryCollisionRadius);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TrajectoryCollision), false, OwningActor);
+	
+	PendingCollisionTraces.Reset();
+	PendingCollisionSegments.Reset();
+	FVector SegmentStart = ActorLocation;
+	for(const float TimeDelay : TrajTimes)
+	{
+		if(TimeDelay <= 0.0f)
+		{
+			continue;
+		}
+
+		const FVector SegmentEnd = ActorLocation + TrajPositions[GetFutureSampleIndex(TimeDelay)];
+		PendingCollisionTraces.Add(World->AsyncSweepByChannel(EAsyncTraceType::Single, SegmentStart, SegmentEnd,
+			FQuat::Identity, TrajectoryCollisionChannel, CollisionShape, QueryParams));
+		PendingCollisionSegments.Add(SegmentStart);
+		PendingCollisionSegments.Add(SegmentEnd);
+
+		SegmentStart = SegmentEnd;
+	}
+}
+
 void UTrajectoryGenerator_Base::RecordPastTrajectory(float DeltaTime)
 {
 	if(!OwningActor)
@@ -259,24 +383,23 @@ void UTrajectoryGenerator_Base::RecordPastTrajectory(float DeltaTime)
 
 	if (TimeSinceLastRecord > RecordingFrequency)
 	{
-		if (CumActiveTime > MaxRecordTime + RecordingFrequency)
-		{
-			RecordedPastPositions.Pop();
-			RecordedPastRotations.Pop();
-			RecordedPastTimes.Pop();
-		}
-		
 		FVector CachedCompLocation = CacheCharacterTransform.GetLocation();
 		CachedCompLocation.Z = OwningActor->GetActorLocation().Z;
-		
-		RecordedPastPositions.Insert(CachedCompLocation, 0);
-		RecordedPastRotations.Insert(CacheCharacterTransform.Rotator().Yaw + CharacterFacingOffset, 0);
-		RecordedPastTimes.Insert(CumActiveTime, 0);
+
+		//The ring buffer overwrites the oldest recording once it is full
+		RecordedPastTrajectory.Record(CachedCompLocation, CacheCharacterTransform.Rotator().Yaw + CharacterFacingOffset,
+			CumActiveTime);
 		
 		TimeSinceLastRecord = 0.0f;
 	}
 }
 
+int32 UTrajectoryGenerator_Base::GetFutureSampleIndex(const float TimeDelay) const
+{
+	const int32 Index = FMath::RoundToInt(TimeDelay / TimeHorizon * TrajPositions.Num() - 1);
+	return FMath::Clamp(Index, 0, TrajPositions.Num() - 1);
+}
+
 void UTrajectoryGenerator_Base::ExtractTrajectory()
 {
 	if(!OwningActor)
@@ -286,6 +409,7 @@ void UTrajectoryGenerator_Base::ExtractTrajectory()
 
 	const FVector ActorPosition = OwningActor->GetActorTransform().GetLocation();
 
+	int32 FutureSegmentIndex = 0;
 	for (int32 i = 0; i < Trajectory.TrajectoryPoints.Num(); ++i)
 	{
 		const float TimeDelay = TrajTimes[i];
@@ -293,35 +417,10 @@ void UTrajectoryGenerator_Base::ExtractTrajectory()
 		if (TimeDelay < 0.0f)
 		{
 			//Past trajectory extraction
-			int32 CurrentIndex = 1;
-			float Lerp = 0.0f;
-			const float CurrentTime = CumActiveTime;
-
-			for (int32 k = 1; k < RecordedPastTimes.Num(); ++k)
+			FVector Position;
+			float FacingAngle;
+			if (RecordedPastTrajectory.SampleAtTime(CumActiveTime + TimeDelay, Position, FacingAngle))
 			{
-				const float Time = RecordedPastTimes[k];
-
-				if (Time < CurrentTime + TimeDelay)
-				{
-					CurrentIndex = k;
-
-					const float TimeError = (CurrentTime + TimeDelay) - Time;
-					const float DeltaTime = FMath::Max( 0.00001f, RecordedPastTimes[k - 1] - Time);
-
-					Lerp = TimeError / DeltaTime;
-					break;
-				}
-			}
-
-			if (CurrentIndex < RecordedPastTimes.Num())
-			{
-				FVector Position = FMath::Lerp(RecordedPastPositions[CurrentIndex], RecordedPastPositions[CurrentIndex - 1], Lerp);
-
-				FQuat QuatA = FQuat(FVector::UpVector, FMath::DegreesToRadians(RecordedPastRotations[CurrentIndex]));
-				FQuat QuatB = FQuat(FVector::UpVector, FMath::DegreesToRadians(RecordedPastRotations[CurrentIndex - 1.0f]));
-
-				const float FacingAngle = FQuat::FastLerp(QuatA, QuatB, Lerp).Euler().Z;
-
 				if(bFlattenTrajectory)
 				{
 					Position.Z = ActorPosition.Z;
@@ -329,20 +428,34 @@ void UTrajectoryGenerator_Base::ExtractTrajectory()
 
 				Trajectory.TrajectoryPoints[i] = FTrajectoryPoint(Position - ActorPosition, FacingAngle);
 			}
-			else
-			{
-				Trajectory.TrajectoryPoints[i] = FTrajectoryPoint(RecordedPastPositions.Last(), RecordedPastRotations.Last());
-			}
 		}
 		else
 		{
 			//Future trajectory extraction
-			int32 Index = FMath::RoundToInt(TimeDelay / TimeHorizon * TrajPositions.Num() - 1);
-
-			Index = FMath::Clamp(Index, 0, TrajPositions.Num() - 1);
+			const int32 Index = GetFutureSampleIndex(TimeDelay);
 
 			FVector Position = TrajPositions[Index];
 
+			//Slide the extracted copy of points that pass through a blocking surface back onto it
+			if(TimeDelay > 0.0f)
+			{
+				if(CollisionPlanes.Num() > 0)
+				{
+					FVector WorldPosition = ActorPosition + Position;
+					for(const FTrajectoryCollisionPlane& CollisionPlane : CollisionPlanes)
+					{
+						if(CollisionPlane.SegmentIndex <= FutureSegmentIndex)
+						{
+							CollisionPlane.Clip(WorldPosition);
+						}
+					}
+
+					Position = WorldPosition - ActorPosition;
+				}
+
+				++FutureSegmentIndex;
+			}
+
 			if(bFlattenTrajectory)
 			{
 				Position.Z = 0.0f;
@@ -395,11 +508,11 @@ bool UTrajectoryGenerator_Base::IsValidToUpdatePrediction()
 void UTrajectoryGenerator_Base::DebugDrawTrajectory(const float InDeltaTime)
 {
 	const FVector RefLocation = OwningActor->GetActorLocation();
-	const int32 Iterations = FMath::Min(RecordedPastPositions.Num(), RecordedPastRotations.Num());
-	for(int32 i = 0; i < Iterations; ++i)
+	for(int32 i = 0; i < RecordedPastTrajectory.Num(); ++i)
 	{
-		DrawDebugCoordinateSystem(GetWorld(), RecordedPastPositions[i],
-			FRotator(0.0f, RecordedPastRotations[i], 0.0f), 10, false, InDeltaTime * 1.2f);
+		const FPastTrajectorySample& PastSample = RecordedPastTrajectory[i];
+		DrawDebugCoordinateSystem(GetWorld(), PastSample.Position,
+			FRotator(0.0f, PastSample.RotationZ, 0.0f), 10, false, InDeltaTime * 1.2f);
 	}
 }
 #endif
@@ -14,6 +14,8 @@ FAnimChannelState::FAnimChannelState()
 	  PlayRate(1.0f),
 	  bMirrored(false),
 	  AnimLength(0.0f),
+	  bUseBakedRootMotion(false),
+	  bSkipNotifies(false),
 	  CachedTriangulationIndex(-1)
 { 
 }
@@ -30,6 +32,8 @@ FAnimChannelState::FAnimChannelState(const FPoseMotionData & InPose, float InAni
 	PlayRate(InPlayRate),
 	bMirrored(bInMirrored),
 	AnimLength(InAnimLength),
+	bUseBakedRootMotion(false),
+	bSkipNotifies(false),
 	CachedTriangulationIndex(-1)
 {
 	if(AnimTime > AnimLength)
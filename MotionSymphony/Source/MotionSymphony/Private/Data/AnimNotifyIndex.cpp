@@ -0,0 +1,151 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Data/AnimNotifyIndex.h"
+#include "AnimationRuntime.h"
+#include "Algo/BinarySearch.h"
+#include "Animation/AnimNotifyQueue.h"
+#include "Animation/AnimSequenceBase.h"
+
+FAnimNotifyInterval::FAnimNotifyInterval()
+	: StartTime(0.0f),
+	EndTime(0.0f),
+	NotifyIndex(INDEX_NONE),
+	bIsState(false)
+{
+}
+
+FAnimNotifyInterval::FAnimNotifyInterval(const float InStartTime, const float InEndTime, const int32 InNotifyIndex, const bool bInIsState)
+	: StartTime(InStartTime),
+	EndTime(InEndTime),
+	NotifyIndex(InNotifyIndex),
+	bIsState(bInIsState)
+{
+}
+
+FAnimNotifyIndex::FAnimNotifyIndex()
+	: MaxStateDuration(0.0f),
+	SourceNotifyCount(0),
+	SourceNotifyHash(0)
+{
+}
+
+FAnimNotifyIndex::FAnimNotifyIndex(const UAnimSequenceBase* InSourceAnim)
+	: MaxStateDuration(0.0f),
+	SourceNotifyCount(0),
+	SourceNotifyHash(0)
+{
+	if(!InSourceAnim)
+	{
+		return;
+	}
+
+	const TArray<FAnimNotifyEvent>& Notifies = InSourceAnim->Notifies;
+	SourceNotifyCount = Notifies.Num();
+	SourceNotifyHash = HashNotifies(Notifies);
+	Intervals.Reserve(Notifies.Num());
+	
+	for(int32 i = 0; i < Notifies.Num(); ++i)
+	{
+		const FAnimNotifyEvent& NotifyEvent = Notifies[i];
+		const float StartTime = NotifyEvent.GetTriggerTime();
+		const float EndTime = NotifyEvent.GetEndTriggerTime();
+
+		Intervals.Emplace(StartTime, EndTime, i, NotifyEvent.NotifyStateClass != nullptr);
+		MaxStateDuration = FMath::Max(MaxStateDuration, EndTime - StartTime);
+	}
+
+	Intervals.StableSort([](const FAnimNotifyInterval& A, const FAnimNotifyInterval& B)
+	{
+		return A.StartTime < B.StartTime;
+	});
+}
+
+bool FAnimNotifyIndex::IsValidFor(const UAnimSequenceBase* InSourceAnim) const
+{
+	if(!InSourceAnim
+		|| InSourceAnim->Notifies.Num() != SourceNotifyCount)
+	{
+		return false;
+	}
+
+#if WITH_EDITOR
+	return HashNotifies(InSourceAnim->Notifies) == SourceNotifyHash;
+#else
+	return true;
+#endif
+}
+
+uint32 FAnimNotifyIndex::HashNotifies(const TArray<FAnimNotifyEvent>& InNotifies)
+{
+	uint32 Hash = GetTypeHash(InNotifies.Num());
+	for(const FAnimNotifyEvent& NotifyEvent : InNotifies)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(NotifyEvent.GetTriggerTime()));
+		Hash = HashCombine(Hash, GetTypeHash(NotifyEvent.GetEndTriggerTime()));
+		Hash = HashCombine(Hash, GetTypeHash(NotifyEvent.Notify.Get()));
+		Hash = HashCombine(Hash, GetTypeHash(NotifyEvent.NotifyStateClass.Get()));
+	}
+
+	return Hash;
+}
+
+void FAnimNotifyIndex::GetAnimNotifies(const UAnimSequenceBase* InSourceAnim, const float StartTime, const float DeltaTime,
+	const bool bLooping, TArray<FAnimNotifyEventReference>& OutNotifies) const
+{
+	const float PlayLength = InSourceAnim->GetPlayLength();
+	if(DeltaTime == 0.0f
+		|| Intervals.Num() == 0
+		|| PlayLength <= 0.0f)
+	{
+		return;
+	}
+
+	const bool bPlayingBackwards = DeltaTime < 0.0f;
+	float PreviousPosition = StartTime;
+	float CurrentPosition = StartTime;
+	float DesiredDeltaMove = DeltaTime;
+
+	//Same stepping as the engine. Advance to the end of the animation and keep going from the other end if looping
+	while(true)
+	{
+		const ETypeAdvanceAnim AdvanceType = FAnimationRuntime::AdvanceTime(false, DesiredDeltaMove, CurrentPosition, PlayLength);
+		GetAnimNotifiesFromDeltaPositions(InSourceAnim, PreviousPosition, CurrentPosition, OutNotifies);
+
+		if(AdvanceType != ETAA_Finished || !bLooping)
+		{
+			break;
+		}
+
+		DesiredDeltaMove -= CurrentPosition - PreviousPosition;
+		PreviousPosition = bPlayingBackwards ? PlayLength : 0.0f;
+		CurrentPosition = PreviousPosition;
+	}
+}
+
+void FAnimNotifyIndex::GetAnimNotifiesFromDeltaPositions(const UAnimSequenceBase* InSourceAnim, const float PreviousPosition,
+	const float CurrentPosition, TArray<FAnimNotifyEventReference>& OutNotifies) const
+{
+	const TArray<FAnimNotifyEvent>& Notifies = InSourceAnim->Notifies;
+	const bool bPlayingBackwards = CurrentPosition < PreviousPosition;
+
+	//Only intervals starting between MaxStateDuration before the range and the end of the range can overlap it
+	const float RangeStart = (bPlayingBackwards ? CurrentPosition : PreviousPosition) - MaxStateDuration;
+	const float RangeEnd = bPlayingBackwards ? PreviousPosition : CurrentPosition;
+	
+	const int32 FirstIndex = Algo::LowerBoundBy(Intervals, RangeStart, &FAnimNotifyInterval::StartTime);
+	const int32 EndIndex = Algo::UpperBoundBy(Intervals, RangeEnd, &FAnimNotifyInterval::StartTime);
+
+	for(int32 i = FirstIndex; i < EndIndex; ++i)
+	{
+		const FAnimNotifyInterval& Interval = Intervals[i];
+		
+		const bool bTriggered = bPlayingBackwards
+			? Interval.StartTime < PreviousPosition && Interval.EndTime >= CurrentPosition
+			: Interval.StartTime <= CurrentPosition && Interval.EndTime > PreviousPosition;
+
+		if(bTriggered)
+		{
+			OutNotifies.Emplace(&Notifies[Interval.NotifyIndex], InSourceAnim);
+		}
+	}
+}
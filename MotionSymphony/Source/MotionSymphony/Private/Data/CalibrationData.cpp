@@ -3,6 +3,60 @@
 #include "Data/CalibrationData.h"
 #include "Objects/Assets/MotionDataAsset.h"
 #include "Objects/Assets/MotionMatchConfig.h"
+#include "Async/ParallelFor.h"
+
+/** Number of poses processed by a single task when generating standard deviations */
+static constexpr int32 StandardDeviationChunkSize = 1024;
+
+FStandardDeviationAccumulator::FStandardDeviationAccumulator()
+	: Count(0)
+{
+}
+
+FStandardDeviationAccumulator::FStandardDeviationAccumulator(const int32 AtomCount)
+	: Count(0)
+{
+	Mean.SetNumZeroed(FMath::Max(0, AtomCount));
+	DistToMeanSqr.SetNumZeroed(FMath::Max(0, AtomCount));
+}
+
+void FStandardDeviationAccumulator::AddSample(const float* Atoms)
+{
+	++Count;
+	const double InvCount = 1.0 / static_cast<double>(Count);
+	for(int32 i = 0; i < Mean.Num(); ++i)
+	{
+		const double Delta = Atoms[i] - Mean[i];
+		Mean[i] += Delta * InvCount;
+		DistToMeanSqr[i] += Delta * (Atoms[i] - Mean[i]);
+	}
+}
+
+void FStandardDeviationAccumulator::Merge(const FStandardDeviationAccumulator& Other)
+{
+	if(Other.Count == 0)
+	{
+		return;
+	}
+
+	if(Count == 0)
+	{
+		*this = Other;
+		return;
+	}
+
+	const double CountA = static_cast<double>(Count);
+	const double CountB = static_cast<double>(Other.Count);
+	const double CombinedCount = CountA + CountB;
+	for(int32 i = 0; i < Mean.Num(); ++i)
+	{
+		const double Delta = Other.Mean[i] - Mean[i];
+		Mean[i] += Delta * CountB / CombinedCount;
+		DistToMeanSqr[i] += Other.DistToMeanSqr[i] + Delta * Delta * CountA * CountB / CombinedCount;
+	}
+
+	Count += Other.Count;
+}
 
 FCalibrationData::FCalibrationData()
 {
@@ -80,6 +134,18 @@ bool FCalibrationData::IsValidWithConfig(const UMotionMatchConfig* MotionConfig)
 }
 
 void FCalibrationData::GenerateStandardDeviationWeights(const UMotionDataAsset* SourceMotionData, const FGameplayTagContainer& MotionTags)
+{
+	TArray<FCalibrationData> CalibrationSets;
+	GenerateStandardDeviationWeights(SourceMotionData, TArray<FGameplayTagContainer>{ MotionTags }, CalibrationSets);
+
+	if(CalibrationSets.Num() > 0)
+	{
+		Weights = MoveTemp(CalibrationSets[0].Weights);
+	}
+}
+
+void FCalibrationData::GenerateStandardDeviationWeights(const UMotionDataAsset* SourceMotionData,
+	const TArray<FGameplayTagContainer>& MotionTagSets, TArray<FCalibrationData>& OutCalibrationSets)
 {
 	if (!SourceMotionData || !SourceMotionData->MotionMatchConfig)
 	{
@@ -87,136 +153,138 @@ void FCalibrationData::GenerateStandardDeviationWeights(const UMotionDataAsset*
 	}
 
 	UMotionMatchConfig* MMConfig = SourceMotionData->MotionMatchConfig;
-	Initialize(MMConfig);
-	
-	int32 SdPoseCount = 0;		//Sd means 'standard deviation'
-	int32 LookupMatrixPoseId = 0;
+	const int32 TagSetCount = MotionTagSets.Num();
+	OutCalibrationSets.SetNum(TagSetCount);
 
-	//Determine the total for each atom
 	const int32 AtomCount = SourceMotionData->LookupPoseMatrix.AtomCount; //Actual number of matching atoms
 	const int32 MeasuredAtomCount = AtomCount - 1; //Atom count excluding cost multiplier
-	TArray<float> TotalsArray;
-	TotalsArray.SetNumZeroed(MeasuredAtomCount);
-	const TArray<float>& PoseArray = SourceMotionData->LookupPoseMatrix.PoseArray;
-	for(const FPoseMotionData& Pose : SourceMotionData->Poses)
+	if(TagSetCount == 0 || MeasuredAtomCount < 1)
 	{
-		++LookupMatrixPoseId;
-		
-		if(Pose.SearchFlag == EPoseSearchFlag::Searchable
-			|| Pose.MotionTags != MotionTags)
-		{
-			continue;
-		}
-
-		++SdPoseCount;
-		
-		const int32 PoseStartIndex = (LookupMatrixPoseId - 1) * AtomCount + 1; //+1 to make room for Pose Cost Multiplier
-		for(int32 i = 0; i < MeasuredAtomCount; ++i)
-		{
-			TotalsArray[i] += PoseArray[PoseStartIndex + i];
-		}
+		return;
 	}
-	
-	SdPoseCount = FMath::Max(SdPoseCount, 1);
 
-	//Determine the Mean for each atom
-	TArray<float> MeanArray;
-	MeanArray.SetNumZeroed(MeasuredAtomCount);
-	for(int32 i = 0; i < MeasuredAtomCount; ++i)
-	{
-		MeanArray[i] = TotalsArray[i] / SdPoseCount;
-	}
+	const TArray<float>& PoseArray = SourceMotionData->LookupPoseMatrix.PoseArray;
+	const TArray<FPoseMotionData>& Poses = SourceMotionData->Poses;
+	const int32 PoseCount = FMath::Min(Poses.Num(), PoseArray.Num() / AtomCount);
+	const int32 ChunkCount = FMath::DivideAndRoundUp(PoseCount, StandardDeviationChunkSize);
 
-	LookupMatrixPoseId = 0;
+	//Each chunk of poses gets its own accumulator per tag set so that chunks can be processed in parallel
+	TArray<FStandardDeviationAccumulator> ChunkAccumulators;
+	ChunkAccumulators.Init(FStandardDeviationAccumulator(MeasuredAtomCount), ChunkCount * TagSetCount);
 
-	//Determine the distance to the mean squared for each atom
-	TArray<float> TotalDistanceSqrArray;
-	TotalDistanceSqrArray.SetNumZeroed(MeasuredAtomCount);
-	for (const FPoseMotionData& Pose : SourceMotionData->Poses)
+	ParallelFor(ChunkCount, [&](const int32 ChunkIndex)
 	{
-		++LookupMatrixPoseId;
-		
-		if(Pose.SearchFlag == EPoseSearchFlag::DoNotUse
-			|| Pose.MotionTags != MotionTags)
+		FStandardDeviationAccumulator* Accumulators = &ChunkAccumulators[ChunkIndex * TagSetCount];
+		const int32 StartPoseId = ChunkIndex * StandardDeviationChunkSize;
+		const int32 EndPoseId = FMath::Min(StartPoseId + StandardDeviationChunkSize, PoseCount);
+
+		//Consecutive poses almost always share the same tags (they come from the same animation) so the last
+		//tag set lookup is cached to avoid comparing tag containers for every pose.
+		const FGameplayTagContainer* LastMotionTags = nullptr;
+		int32 TagSetIndex = INDEX_NONE;
+		for(int32 PoseId = StartPoseId; PoseId < EndPoseId; ++PoseId)
 		{
-			continue;
+			const FPoseMotionData& Pose = Poses[PoseId];
+			if(Pose.SearchFlag == EPoseSearchFlag::DoNotUse)
+			{
+				continue;
+			}
+
+			if(!LastMotionTags || Pose.MotionTags != *LastMotionTags)
+			{
+				LastMotionTags = &Pose.MotionTags;
+				TagSetIndex = MotionTagSets.IndexOfByKey(Pose.MotionTags);
+			}
+
+			if(TagSetIndex != INDEX_NONE)
+			{
+				Accumulators[TagSetIndex].AddSample(&PoseArray[PoseId * AtomCount + 1]); //+1 to skip the Pose Cost Multiplier
+			}
 		}
-		
-		const int32 PoseStartIndex = (LookupMatrixPoseId - 1) * AtomCount + 1; //+1 to make room for Pose Cost Multiplier
-		int32 FeatureOffset = 0; //Since the standard deviation array does not include a pose cost multiplier the feature offset does not have a +1
-		for(const TObjectPtr<UMatchFeatureBase> FeaturePtr : MMConfig->Features)
+	});
+
+	for(int32 TagSetIndex = 0; TagSetIndex < TagSetCount; ++TagSetIndex)
+	{
+		FStandardDeviationAccumulator TagSetAccumulator(MeasuredAtomCount);
+		for(int32 ChunkIndex = 0; ChunkIndex < ChunkCount; ++ChunkIndex)
 		{
-			const int32 FeatureSize = FeaturePtr->Size();
-			
-			FeaturePtr->CalculateDistanceSqrToMeanArrayForStandardDeviations(TotalDistanceSqrArray,
-				MeanArray, PoseArray, FeatureOffset, PoseStartIndex);
-		
-			FeatureOffset += FeatureSize;
+			TagSetAccumulator.Merge(ChunkAccumulators[ChunkIndex * TagSetCount + TagSetIndex]);
 		}
-	}
 
-	//Calculate the standard deviation and final standard deviation weight
-	for(int32 i = 0; i < MeasuredAtomCount; ++i)
-	{
-		const float StandardDeviation = TotalDistanceSqrArray[i] / SdPoseCount;
-		Weights[i] = FMath::IsNearlyZero(StandardDeviation)? 0.0f : 1.0f / StandardDeviation;
+		OutCalibrationSets[TagSetIndex].GenerateWeightsFromAccumulator(TagSetAccumulator, MMConfig);
 	}
 }
 
 void FCalibrationData::GenerateStandardDeviationWeights(const TArray<float>& PoseMatrix, UMotionMatchConfig* InMMConfig)
 {
-	if(InMMConfig == nullptr && PoseMatrix.Num() == 0)
+	if(InMMConfig == nullptr)
 	{
 		return;
 	}
 
 	Initialize(InMMConfig);
 
-	//Determine the total for each atom
 	const int32 AtomCount = InMMConfig->TotalDimensionCount;
-	TArray<float> TotalsArray;
-	TotalsArray.SetNumZeroed(AtomCount);
+	if(AtomCount < 1 || PoseMatrix.Num() == 0)
+	{
+		return;
+	}
+	
 	const int32 PoseCount = PoseMatrix.Num() / AtomCount;
-	for(int32 PoseId = 0; PoseId < PoseCount; ++PoseId)
+	const int32 ChunkCount = FMath::DivideAndRoundUp(PoseCount, StandardDeviationChunkSize);
+
+	TArray<FStandardDeviationAccumulator> ChunkAccumulators;
+	ChunkAccumulators.Init(FStandardDeviationAccumulator(AtomCount), ChunkCount);
+
+	ParallelFor(ChunkCount, [&](const int32 ChunkIndex)
 	{
-		const int32 PoseStartIndex = PoseId * AtomCount; 
-		for(int32 i = 0; i < AtomCount; ++i)
+		const int32 StartPoseId = ChunkIndex * StandardDeviationChunkSize;
+		const int32 EndPoseId = FMath::Min(StartPoseId + StandardDeviationChunkSize, PoseCount);
+		for(int32 PoseId = StartPoseId; PoseId < EndPoseId; ++PoseId)
 		{
-			TotalsArray[i] += PoseMatrix[PoseStartIndex + i];
+			ChunkAccumulators[ChunkIndex].AddSample(&PoseMatrix[PoseId * AtomCount]);
 		}
-	}
+	});
 
-	//Determine the Mean for each atom
-	TArray<float> MeanArray;
-	MeanArray.SetNumZeroed(AtomCount);
-	for(int32 i = 0; i < AtomCount; ++i)
+	FStandardDeviationAccumulator Accumulator(AtomCount);
+	for(const FStandardDeviationAccumulator& ChunkAccumulator : ChunkAccumulators)
 	{
-		MeanArray[i] = TotalsArray[i] / PoseCount;
+		Accumulator.Merge(ChunkAccumulator);
 	}
 
-	//Determine the distance to the mean squared for each atom
+	GenerateWeightsFromAccumulator(Accumulator, InMMConfig);
+}
+
+void FCalibrationData::GenerateWeightsFromAccumulator(const FStandardDeviationAccumulator& Accumulator, UMotionMatchConfig* InMMConfig)
+{
+	Initialize(InMMConfig);
+
+	const int32 MeasuredAtomCount = FMath::Min(Weights.Num(), Accumulator.DistToMeanSqr.Num());
 	TArray<float> TotalDistanceSqrArray;
-	TotalDistanceSqrArray.SetNumZeroed(AtomCount);
-	//for (const FPoseMotionData& Pose : SourceMotionData->Poses)
-	for(int32 PoseId = 0; PoseId < PoseCount; ++PoseId)
+	TotalDistanceSqrArray.SetNumZeroed(MeasuredAtomCount);
+	for(int32 i = 0; i < MeasuredAtomCount; ++i)
+	{
+		TotalDistanceSqrArray[i] = static_cast<float>(Accumulator.DistToMeanSqr[i]);
+	}
+
+	//Features measured as vectors combine the distances of their atoms
+	int32 FeatureOffset = 0; //Since the standard deviation array does not include a pose cost multiplier the feature offset does not have a +1
+	for(const TObjectPtr<UMatchFeatureBase> FeaturePtr : InMMConfig->Features)
 	{
-		const int32 PoseStartIndex = PoseId * AtomCount; //+1 to make room for Pose Cost Multiplier
-		int32 FeatureOffset = 0;
-		for(const TObjectPtr<UMatchFeatureBase> FeaturePtr : InMMConfig->Features)
+		if(!FeaturePtr)
 		{
-			const int32 FeatureSize = FeaturePtr->Size();
-			
-			FeaturePtr->CalculateDistanceSqrToMeanArrayForStandardDeviations(TotalDistanceSqrArray,
-				MeanArray, PoseMatrix, FeatureOffset, PoseStartIndex);
-		
-			FeatureOffset += FeatureSize;
+			continue;
 		}
+		
+		FeaturePtr->ReduceDistanceSqrToMeanForStandardDeviations(TotalDistanceSqrArray, FeatureOffset);
+		FeatureOffset += FeaturePtr->Size();
 	}
 
 	//Calculate the standard deviation and final standard deviation weight
-	for(int32 i = 0; i < AtomCount; ++i)
+	const float SdPoseCount = static_cast<float>(FMath::Max(Accumulator.Count, 1)); //Sd means 'standard deviation'
+	for(int32 i = 0; i < MeasuredAtomCount; ++i)
 	{
-		const float StandardDeviation = TotalDistanceSqrArray[i] / PoseCount;
+		const float StandardDeviation = TotalDistanceSqrArray[i] / SdPoseCount;
 		Weights[i] = FMath::IsNearlyZero(StandardDeviation)? 0.0f : 1.0f / StandardDeviation;
 	}
 }
@@ -0,0 +1,197 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Data/DistanceTimeLookupTable.h"
+#include "Animation/AnimSequenceBase.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	/** Table resolution per curve key. The curve is piecewise linear between keys so this bounds the interpolation
+	 * error around each key */
+	constexpr int32 LookupSamplesPerKey = 8;
+	constexpr int32 MinLookupSamples = 64;
+	constexpr int32 MaxLookupSamples = 4096;
+
+	/** Sequence, curve name, negation and a hash of the curve keys so that an edited curve never matches a table baked
+	 * from its old keys, even while a module still holds that table */
+	typedef TTuple<FObjectKey, FName, bool, uint32> FLookupTableKey;
+	typedef TSharedPtr<FDistanceTimeLookupTable, ESPMode::ThreadSafe> FLookupTablePtr;
+
+	/** Registry of all lookup tables currently held by at least one module. Entries are weak so that the table is
+	 * freed when the last module releases it. */
+	struct FLookupTableRegistry
+	{
+		FCriticalSection CriticalSection;
+		TMap<FLookupTableKey, TWeakPtr<FDistanceTimeLookupTable, ESPMode::ThreadSafe>> Entries;
+	};
+
+	FLookupTableRegistry& GetLookupTableRegistry()
+	{
+		static FLookupTableRegistry Registry;
+		return Registry;
+	}
+
+	const FFloatCurve* FindDistanceCurve(const UAnimSequenceBase* InAnimSequence, const FName& InDistanceCurveName)
+	{
+		const FRawCurveTracks& RawCurves = InAnimSequence->GetCurveData();
+#if ENGINE_MINOR_VERSION > 2
+		return static_cast<const FFloatCurve*>(RawCurves.GetCurveData(InDistanceCurveName));
+#else
+		FSmartName CurveName;
+		InAnimSequence->GetSkeleton()->GetSmartNameByName(USkeleton::AnimCurveMappingName, InDistanceCurveName, CurveName);
+		return CurveName.IsValid() ? static_cast<const FFloatCurve*>(RawCurves.GetCurveData(CurveName.UID)) : nullptr;
+#endif
+	}
+
+	/** Hashes the parts of the curve keys that the table is baked from */
+	uint32 HashCurveKeys(const TArray<FRichCurveKey>& InCurveKeys)
+	{
+		uint32 Hash = GetTypeHash(InCurveKeys.Num());
+		for(const FRichCurveKey& Key : InCurveKeys)
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(Key.Time), GetTypeHash(Key.Value)));
+		}
+
+		return Hash;
+	}
+
+	/** The reference search: the time at which the curve first reaches the distance, interpolated from the key before */
+	float ScanMatchingTime(const TArray<FRichCurveKey>& InCurveKeys, const float InNegator, const float InDesiredDistance)
+	{
+		const FRichCurveKey* PKey = &InCurveKeys[0];
+		const FRichCurveKey* SKey = nullptr;
+		for(const FRichCurveKey& Key : InCurveKeys)
+		{
+			if(Key.Value * InNegator > InDesiredDistance)
+			{
+				PKey = &Key;
+			}
+			else
+			{
+				SKey = &Key;
+				break;
+			}
+		}
+
+		if(!SKey)
+		{
+			return PKey->Time;
+		}
+
+		const float DV = (SKey->Value * InNegator) - (PKey->Value * InNegator);
+		if(DV < 0.000001f)
+		{
+			return PKey->Time;
+		}
+
+		const float DT = SKey->Time - PKey->Time;
+		return ((DT / DV) * (InDesiredDistance - (PKey->Value * InNegator))) + PKey->Time;
+	}
+}
+
+FDistanceTimeLookupTable::FDistanceTimeLookupTable()
+	: MinDistance(0.0f),
+	DistanceStep(0.0f),
+	InvDistanceStep(0.0f),
+	MaxAbsDistance(0.0f),
+	EndTime(0.0f)
+{
+}
+
+TSharedPtr<const FDistanceTimeLookupTable, ESPMode::ThreadSafe> FDistanceTimeLookupTable::FindOrCreate(
+	const UAnimSequenceBase* InAnimSequence, const FName& InDistanceCurveName, const bool bInNegateCurve)
+{
+	if(!InAnimSequence)
+	{
+		return nullptr;
+	}
+
+	const FFloatCurve* DistanceCurve = FindDistanceCurve(InAnimSequence, InDistanceCurveName);
+	if(!DistanceCurve)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Distance matching curve could not be found. Distance matching node will not operate as expected."));
+		return nullptr;
+	}
+
+	const TArray<FRichCurveKey>& CurveKeys = DistanceCurve->FloatCurve.GetConstRefOfKeys();
+	if(CurveKeys.Num() < 2)
+	{
+		return nullptr;
+	}
+
+	const FLookupTableKey Key(FObjectKey(InAnimSequence), InDistanceCurveName, bInNegateCurve, HashCurveKeys(CurveKeys));
+	FLookupTableRegistry& Registry = GetLookupTableRegistry();
+
+	FScopeLock ScopeLock(&Registry.CriticalSection);
+	if(TWeakPtr<FDistanceTimeLookupTable, ESPMode::ThreadSafe>* ExistingEntry = Registry.Entries.Find(Key))
+	{
+		if(FLookupTablePtr ExistingTable = ExistingEntry->Pin())
+		{
+			return ExistingTable;
+		}
+	}
+
+	FLookupTablePtr NewTable = MakeShared<FDistanceTimeLookupTable, ESPMode::ThreadSafe>();
+	NewTable->Build(CurveKeys, bInNegateCurve);
+
+	Registry.Entries.Add(Key, NewTable);
+
+	//Drop registry entries whose table has already been released by every module, including tables of edited curves
+	for(auto EntryIt = Registry.Entries.CreateIterator(); EntryIt; ++EntryIt)
+	{
+		if(!EntryIt->Value.IsValid())
+		{
+			EntryIt.RemoveCurrent();
+		}
+	}
+
+	return NewTable;
+}
+
+void FDistanceTimeLookupTable::Build(const TArray<FRichCurveKey>& InCurveKeys, const bool bInNegateCurve)
+{
+	const float Negator = bInNegateCurve ? -1.0f : 1.0f;
+
+	MinDistance = UE_BIG_NUMBER;
+	float MaxDistance = -UE_BIG_NUMBER;
+	MaxAbsDistance = 0.0f;
+	for(const FRichCurveKey& Key : InCurveKeys)
+	{
+		MinDistance = FMath::Min(MinDistance, Key.Value * Negator);
+		MaxDistance = FMath::Max(MaxDistance, Key.Value * Negator);
+		MaxAbsDistance = FMath::Max(MaxAbsDistance, FMath::Abs(Key.Value));
+	}
+
+	EndTime = InCurveKeys.Last().Time;
+
+	const int32 SampleCount = FMath::Clamp(InCurveKeys.Num() * LookupSamplesPerKey, MinLookupSamples, MaxLookupSamples);
+	DistanceStep = (MaxDistance - MinDistance) / (SampleCount - 1);
+	InvDistanceStep = DistanceStep > UE_KINDA_SMALL_NUMBER ? 1.0f / DistanceStep : 0.0f;
+
+	//Distances above the curve maximum match the first key and distances below the minimum the last key, so only the
+	//range of the curve needs to be baked
+	Times.SetNumUninitialized(SampleCount);
+	for(int32 i = 0; i < SampleCount; ++i)
+	{
+		Times[i] = ScanMatchingTime(InCurveKeys, Negator, MinDistance + DistanceStep * i);
+	}
+}
+
+float FDistanceTimeLookupTable::FindMatchingTime(const float InDesiredDistance) const
+{
+	if(Times.Num() == 0
+		|| FMath::Abs(InDesiredDistance) > MaxAbsDistance)
+	{
+		return -1.0f;
+	}
+
+	if(InDesiredDistance < MinDistance)
+	{
+		return EndTime;
+	}
+
+	const float SamplePosition = FMath::Min((InDesiredDistance - MinDistance) * InvDistanceStep, static_cast<float>(Times.Num() - 1));
+	const int32 SampleIndex = FMath::Min(FMath::FloorToInt(SamplePosition), Times.Num() - 2);
+	return FMath::Lerp(Times[SampleIndex], Times[SampleIndex + 1], SamplePosition - SampleIndex);
+}
@@ -0,0 +1,68 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Data/MirrorBoneMap.h"
+#include "Animation/MirrorDataTable.h"
+#include "UObject/ObjectKey.h"
+
+namespace
+{
+	typedef TPair<FObjectKey, FObjectKey> FMirrorBoneMapKey;
+	typedef TSharedPtr<FMirrorBoneMap, ESPMode::ThreadSafe> FMirrorBoneMapPtr;
+
+	/** Registry of all mirror bone maps currently held by at least one node. Each mirror table and asset pair may
+	 * have one map per LOD. Entries are weak so that the maps are freed when the last node releases them. */
+	struct FMirrorBoneMapRegistry
+	{
+		FCriticalSection CriticalSection;
+		TMap<FMirrorBoneMapKey, TArray<TWeakPtr<FMirrorBoneMap, ESPMode::ThreadSafe>>> Entries;
+	};
+
+	FMirrorBoneMapRegistry& GetMirrorBoneMapRegistry()
+	{
+		static FMirrorBoneMapRegistry Registry;
+		return Registry;
+	}
+}
+
+TSharedPtr<const FMirrorBoneMap, ESPMode::ThreadSafe> FMirrorBoneMap::FindOrCreate(const UMirrorDataTable* InMirrorDataTable,
+	const FBoneContainer& BoneContainer)
+{
+	if(!InMirrorDataTable
+		|| !BoneContainer.IsValid())
+	{
+		return nullptr;
+	}
+
+	const FMirrorBoneMapKey Key(FObjectKey(InMirrorDataTable), FObjectKey(BoneContainer.GetAsset()));
+	FMirrorBoneMapRegistry& Registry = GetMirrorBoneMapRegistry();
+
+	FScopeLock ScopeLock(&Registry.CriticalSection);
+	TArray<TWeakPtr<FMirrorBoneMap, ESPMode::ThreadSafe>>& LODMaps = Registry.Entries.FindOrAdd(Key);
+	for(int32 i = LODMaps.Num() - 1; i > -1; --i)
+	{
+		const FMirrorBoneMapPtr ExistingMap = LODMaps[i].Pin();
+		if(!ExistingMap.IsValid())
+		{
+			LODMaps.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		if(ExistingMap->IsValidFor(BoneContainer))
+		{
+			return ExistingMap;
+		}
+	}
+
+	FMirrorBoneMapPtr NewMap = MakeShared<FMirrorBoneMap, ESPMode::ThreadSafe>();
+	NewMap->RequiredBoneIndices = BoneContainer.GetBoneIndicesArray();
+	InMirrorDataTable->FillCompactPoseAndComponentRefRotations(BoneContainer,
+		NewMap->CompactPoseMirrorBones, NewMap->ComponentSpaceRefRotations);
+
+	LODMaps.Add(NewMap);
+	return NewMap;
+}
+
+bool FMirrorBoneMap::IsValidFor(const FBoneContainer& BoneContainer) const
+{
+	return RequiredBoneIndices == BoneContainer.GetBoneIndicesArray();
+}
@@ -0,0 +1,207 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Data/MotionMatchingRuntimeData.h"
+#include "Data/CalibrationData.h"
+#include "Objects/Assets/MotionCalibration.h"
+#include "Objects/Assets/MotionDataAsset.h"
+#include "Objects/Assets/MotionMatchConfig.h"
+#include "MotionSymphony.h"
+
+namespace
+{
+	typedef TTuple<FObjectKey, FObjectKey, FObjectKey> FRuntimeDataKey;
+	typedef TSharedPtr<FMotionMatchingRuntimeData, ESPMode::ThreadSafe> FRuntimeDataPtr;
+
+	/** Registry of all runtime data currently held by at least one node. Entries are weak so that the data is freed
+	 * when the last node releases it. */
+	struct FRuntimeDataRegistry
+	{
+		FCriticalSection CriticalSection;
+		TMap<FRuntimeDataKey, TWeakPtr<FMotionMatchingRuntimeData, ESPMode::ThreadSafe>> Entries;
+	};
+
+	FRuntimeDataRegistry& GetRuntimeDataRegistry()
+	{
+		static FRuntimeDataRegistry Registry;
+		return Registry;
+	}
+}
+
+FMotionMatchingRuntimeData::FMotionMatchingRuntimeData()
+	: bStale(false)
+{
+}
+
+TSharedPtr<const FMotionMatchingRuntimeData, ESPMode::ThreadSafe> FMotionMatchingRuntimeData::FindOrCreate(
+	const UMotionDataAsset* InMotionData, const UMotionCalibration* InUserCalibration)
+{
+	if(!InMotionData
+		|| !InMotionData->bIsProcessed
+		|| !InMotionData->MotionMatchConfig)
+	{
+		return nullptr;
+	}
+
+	const UMotionMatchConfig* MMConfig = InMotionData->MotionMatchConfig;
+	for(const FCalibrationData& FeatureStdDev : InMotionData->FeatureStandardDeviations)
+	{
+		if(FeatureStdDev.Weights.Num() != MMConfig->TotalDimensionCount)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to build motion matching runtime data. Internal calibration sets atom count does not match the motion config. Did you change the motion config and forget to pre-process?"));
+			return nullptr;
+		}
+	}
+
+	const FRuntimeDataKey Key(FObjectKey(InMotionData), FObjectKey(MMConfig), FObjectKey(InUserCalibration));
+	FRuntimeDataRegistry& Registry = GetRuntimeDataRegistry();
+
+	FScopeLock ScopeLock(&Registry.CriticalSection);
+	if(TWeakPtr<FMotionMatchingRuntimeData, ESPMode::ThreadSafe>* ExistingEntry = Registry.Entries.Find(Key))
+	{
+		if(FRuntimeDataPtr ExistingData = ExistingEntry->Pin())
+		{
+			if(!ExistingData->IsStale())
+			{
+				return ExistingData;
+			}
+		}
+	}
+
+	FRuntimeDataPtr NewData = MakeShared<FMotionMatchingRuntimeData, ESPMode::ThreadSafe>();
+	NewData->MotionDataKey = Key.Get<0>();
+	NewData->MotionMatchConfigKey = Key.Get<1>();
+	NewData->UserCalibrationKey = Key.Get<2>();
+	NewData->Build(InMotionData, InUserCalibration);
+
+	Registry.Entries.Add(Key, NewData);
+
+	//Drop registry entries whose data has already been released by every node
+	for(auto EntryIt = Registry.Entries.CreateIterator(); EntryIt; ++EntryIt)
+	{
+		if(!EntryIt->Value.IsValid())
+		{
+			EntryIt.RemoveCurrent();
+		}
+	}
+
+	return NewData;
+}
+
+void FMotionMatchingRuntimeData::Invalidate(const UObject* InSourceAsset)
+{
+	if(!InSourceAsset)
+	{
+		return;
+	}
+
+	const FObjectKey SourceKey(InSourceAsset);
+	FRuntimeDataRegistry& Registry = GetRuntimeDataRegistry();
+
+	FScopeLock ScopeLock(&Registry.CriticalSection);
+	for(auto EntryIt = Registry.Entries.CreateIterator(); EntryIt; ++EntryIt)
+	{
+		const FRuntimeDataKey& Key = EntryIt->Key;
+		if(Key.Get<0>() != SourceKey
+			&& Key.Get<1>() != SourceKey
+			&& Key.Get<2>() != SourceKey)
+		{
+			continue;
+		}
+
+		if(FRuntimeDataPtr Data = EntryIt->Value.Pin())
+		{
+			Data->bStale = true;
+		}
+
+		EntryIt.RemoveCurrent();
+	}
+}
+
+bool FMotionMatchingRuntimeData::IsBuiltFrom(const UMotionDataAsset* InMotionData, const UMotionCalibration* InUserCalibration) const
+{
+	return InMotionData
+		&& MotionDataKey == FObjectKey(InMotionData)
+		&& MotionMatchConfigKey == FObjectKey(InMotionData->MotionMatchConfig.Get())
+		&& UserCalibrationKey == FObjectKey(InUserCalibration);
+}
+
+void FMotionMatchingRuntimeData::Build(const UMotionDataAsset* InMotionData, const UMotionCalibration* InUserCalibration)
+{
+	UMotionMatchConfig* MMConfig = InMotionData->MotionMatchConfig;
+	const int32 AtomCount = MMConfig->TotalDimensionCount;
+
+	if(InUserCalibration && InUserCalibration->AdjustedCalibrationArray.Num() != AtomCount)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Motion matching runtime data ignored the user calibration as it does not match the motion match config. Please initialize the calibration data."));
+		InUserCalibration = nullptr;
+	}
+
+	QualityAtomMask.Init(false, AtomCount);
+	int32 AtomIndex = 0;
+	for(TObjectPtr<UMatchFeatureBase> FeaturePtr : MMConfig->Features)
+	{
+		const UMatchFeatureBase* Feature = FeaturePtr.Get();
+		if(!Feature)
+		{
+			continue;
+		}
+
+		const bool bQualityFeature = Feature->PoseCategory == EPoseCategory::Quality;
+		for(int32 i = 0; i < Feature->Size() && AtomIndex < AtomCount; ++i)
+		{
+			QualityAtomMask[AtomIndex] = bQualityFeature;
+			++AtomIndex;
+		}
+	}
+
+	//Fold the user calibration into the final weights of each tag set
+	const TArray<FCalibrationData>& FeatureStandardDeviations = InMotionData->FeatureStandardDeviations;
+	CalibrationSets.SetNum(FeatureStandardDeviations.Num());
+	for(int32 SetIndex = 0; SetIndex < FeatureStandardDeviations.Num(); ++SetIndex)
+	{
+		const FCalibrationData& FeatureStdDev = FeatureStandardDeviations[SetIndex];
+		TArray<float>& Weights = CalibrationSets[SetIndex];
+
+		if(InUserCalibration && InUserCalibration->CalibrationType == EMotionCalibrationType::Override)
+		{
+			Weights.SetNumUninitialized(AtomCount);
+			for(int32 i = 0; i < AtomCount; ++i)
+			{
+				Weights[i] = FeatureStdDev.Weights[i] * InUserCalibration->AdjustedCalibrationArray[i];
+			}
+		}
+		else
+		{
+			FCalibrationData FinalCalibration;
+			FinalCalibration.GenerateFinalWeights(MMConfig, FeatureStdDev);
+			Weights = MoveTemp(FinalCalibration.Weights);
+
+			if(InUserCalibration)
+			{
+				for(int32 i = 0; i < AtomCount; ++i)
+				{
+					Weights[i] *= InUserCalibration->AdjustedCalibrationArray[i];
+				}
+			}
+		}
+	}
+
+	//Runtime mirroring compares atoms with their mirror counterpart so the weights must be permuted to match
+	MirroredCalibrationSets.Empty();
+	if(InMotionData->UsesRuntimeMirroring())
+	{
+		const TArray<int32>& MirrorAtomSourceIndices = InMotionData->MirrorAtomSourceIndices;
+		MirroredCalibrationSets.SetNum(CalibrationSets.Num());
+		for(int32 SetIndex = 0; SetIndex < CalibrationSets.Num(); ++SetIndex)
+		{
+			const TArray<float>& Weights = CalibrationSets[SetIndex];
+			TArray<float>& MirroredWeights = MirroredCalibrationSets[SetIndex];
+			MirroredWeights.SetNumUninitialized(Weights.Num());
+			for(int32 i = 0; i < Weights.Num(); ++i)
+			{
+				const int32 SourceIndex = MirrorAtomSourceIndices.IsValidIndex(i + 1) ? MirrorAtomSourceIndices[i + 1] - 1 : i;
+				MirroredWeights[i] = Weights.IsValidIndex(SourceIndex) ? Weights[SourceIndex] : Weights[i];
+			}
+		}
+	}
+}
@@ -0,0 +1,109 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Data/PastTrajectoryBuffer.h"
+
+FPastTrajectorySample::FPastTrajectorySample()
+	: Position(FVector::ZeroVector),
+	RotationZ(0.0f),
+	Time(0.0f)
+{
+}
+
+FPastTrajectorySample::FPastTrajectorySample(const FVector& InPosition, const float InRotationZ, const float InTime)
+	: Position(InPosition),
+	RotationZ(InRotationZ),
+	Time(InTime)
+{
+}
+
+FPastTrajectoryBuffer::FPastTrajectoryBuffer()
+	: Head(0),
+	Count(0)
+{
+}
+
+void FPastTrajectoryBuffer::Initialize(const int32 InCapacity)
+{
+	Samples.SetNum(FMath::Max(InCapacity, 1));
+	Head = 0;
+	Count = 0;
+}
+
+void FPastTrajectoryBuffer::Record(const FVector& InPosition, const float InRotationZ, const float InTime)
+{
+	if(Samples.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 Capacity = Samples.Num();
+	if(Count < Capacity)
+	{
+		Samples[(Head + Count) % Capacity] = FPastTrajectorySample(InPosition, InRotationZ, InTime);
+		++Count;
+	}
+	else
+	{
+		//Full, the oldest sample is overwritten and the next one becomes the oldest
+		Samples[Head] = FPastTrajectorySample(InPosition, InRotationZ, InTime);
+		Head = (Head + 1) % Capacity;
+	}
+}
+
+const FPastTrajectorySample& FPastTrajectoryBuffer::operator[](const int32 Index) const
+{
+	check(Index >= 0 && Index < Count);
+	return Samples[(Head + Index) % Samples.Num()];
+}
+
+int32 FPastTrajectoryBuffer::FindSampleBefore(const float InTime) const
+{
+	//Binary search for the first sample at or after InTime. The sample before it is the one we want.
+	int32 Low = 0;
+	int32 High = Count;
+	while(Low < High)
+	{
+		const int32 Middle = Low + (High - Low) / 2;
+		if((*this)[Middle].Time < InTime)
+		{
+			Low = Middle + 1;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	return Low - 1;
+}
+
+bool FPastTrajectoryBuffer::SampleAtTime(const float InTime, FVector& OutPosition, float& OutRotationZ) const
+{
+	if(Count == 0)
+	{
+		return false;
+	}
+
+	const int32 BeforeIndex = FindSampleBefore(InTime);
+	if(Count == 1 || BeforeIndex == INDEX_NONE)
+	{
+		const FPastTrajectorySample& OldestSample = (*this)[0];
+		OutPosition = OldestSample.Position;
+		OutRotationZ = OldestSample.RotationZ;
+		return true;
+	}
+
+	//A time after the newest sample is extrapolated along the last two samples
+	const int32 FromIndex = FMath::Min(BeforeIndex, Count - 2);
+	const FPastTrajectorySample& FromSample = (*this)[FromIndex];
+	const FPastTrajectorySample& ToSample = (*this)[FromIndex + 1];
+
+	const float Lerp = (InTime - FromSample.Time) / FMath::Max(0.00001f, ToSample.Time - FromSample.Time);
+	OutPosition = FMath::Lerp(FromSample.Position, ToSample.Position, Lerp);
+
+	const FQuat QuatA = FQuat(FVector::UpVector, FMath::DegreesToRadians(FromSample.RotationZ));
+	const FQuat QuatB = FQuat(FVector::UpVector, FMath::DegreesToRadians(ToSample.RotationZ));
+	OutRotationZ = FQuat::FastLerp(QuatA, QuatB, Lerp).Euler().Z;
+
+	return true;
+}
@@ -0,0 +1,79 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Data/PathArcLengthCache.h"
+#include "NavigationData.h"
+
+FPathArcLengthCache::FPathArcLengthCache()
+	: Cursor(0)
+{
+}
+
+void FPathArcLengthCache::Build(const TArray<FNavPathPoint>& InPathPoints)
+{
+	Reset();
+
+	const int32 PointCount = InPathPoints.Num();
+	if(PointCount < 2)
+	{
+		return;
+	}
+
+	Points.SetNumUninitialized(PointCount);
+	CumulativeLengths.SetNumUninitialized(PointCount);
+	SegmentDirections.SetNumUninitialized(PointCount - 1);
+	SegmentYaws.SetNumUninitialized(PointCount - 1);
+
+	Points[0] = InPathPoints[0].Location;
+	CumulativeLengths[0] = 0.0f;
+	for(int32 i = 1; i < PointCount; ++i)
+	{
+		Points[i] = InPathPoints[i].Location;
+
+		const FVector Segment = Points[i] - Points[i - 1];
+		SegmentDirections[i - 1] = Segment.GetSafeNormal();
+		SegmentYaws[i - 1] = SegmentDirections[i - 1].Rotation().Yaw;
+		CumulativeLengths[i] = CumulativeLengths[i - 1] + Segment.Size();
+	}
+}
+
+void FPathArcLengthCache::Reset()
+{
+	Points.Reset();
+	CumulativeLengths.Reset();
+	SegmentDirections.Reset();
+	SegmentYaws.Reset();
+	Cursor = 0;
+}
+
+float FPathArcLengthCache::ProjectOntoSegment(const int32 InSegmentIndex, const FVector& InLocation)
+{
+	if(IsEmpty())
+	{
+		return 0.0f;
+	}
+
+	Cursor = FMath::Clamp(InSegmentIndex, 0, SegmentDirections.Num() - 1);
+
+	const float SegmentLength = CumulativeLengths[Cursor + 1] - CumulativeLengths[Cursor];
+	const float DistanceAlong = FVector::DotProduct(InLocation - Points[Cursor], SegmentDirections[Cursor]);
+	return CumulativeLengths[Cursor] + FMath::Clamp(DistanceAlong, 0.0f, SegmentLength);
+}
+
+void FPathArcLengthCache::SampleForward(const float InArcLength, FVector& OutLocation, float& OutYaw)
+{
+	if(IsEmpty())
+	{
+		return;
+	}
+
+	const float ArcLength = FMath::Clamp(InArcLength, 0.0f, GetTotalLength());
+
+	const int32 LastSegment = SegmentDirections.Num() - 1;
+	while(Cursor < LastSegment && ArcLength > CumulativeLengths[Cursor + 1])
+	{
+		++Cursor;
+	}
+
+	OutLocation = Points[Cursor] + SegmentDirections[Cursor] * (ArcLength - CumulativeLengths[Cursor]);
+	OutYaw = SegmentYaws[Cursor];
+}
@@ -0,0 +1,152 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Data/PoseMatchDatabase.h"
+#include "Objects/Assets/MotionMatchConfig.h"
+
+namespace
+{
+	typedef TSharedPtr<FPoseMatchDatabase, ESPMode::ThreadSafe> FPoseMatchDatabasePtr;
+
+	/** The database of a single key. Baking is serialized per key so that nodes with the same key wait for one bake
+	 * while nodes with other keys bake in parallel. */
+	struct FPoseMatchDatabaseSlot
+	{
+		FCriticalSection BakeCriticalSection;
+		TWeakPtr<FPoseMatchDatabase, ESPMode::ThreadSafe> Database;
+	};
+
+	typedef TSharedPtr<FPoseMatchDatabaseSlot, ESPMode::ThreadSafe> FPoseMatchDatabaseSlotPtr;
+
+	/** Registry of the slots of all pose databases currently held or being baked by at least one node. Databases are
+	 * weak so that they are freed when the last node releases them. */
+	struct FPoseMatchDatabaseRegistry
+	{
+		FCriticalSection CriticalSection;
+		TMap<FPoseMatchDatabaseKey, FPoseMatchDatabaseSlotPtr> Entries;
+	};
+
+	FPoseMatchDatabaseRegistry& GetPoseMatchDatabaseRegistry()
+	{
+		static FPoseMatchDatabaseRegistry Registry;
+		return Registry;
+	}
+
+	FPoseMatchDatabasePtr BakeDatabase(UMotionMatchConfig* InPoseConfig, TFunctionRef<void(FPoseMatchDatabase&)> InBakeDatabase)
+	{
+		FPoseMatchDatabasePtr NewDatabase = MakeShared<FPoseMatchDatabase, ESPMode::ThreadSafe>();
+		InBakeDatabase(*NewDatabase);
+
+		//Calculate feature normalization calibrations
+		NewDatabase->StandardDeviation.Initialize(InPoseConfig->TotalDimensionCount);
+		NewDatabase->StandardDeviation.GenerateStandardDeviationWeights(NewDatabase->PoseMatrix, InPoseConfig);
+
+		//Generate Final Weights
+		NewDatabase->FinalCalibration.Initialize(InPoseConfig);
+		NewDatabase->FinalCalibration.GenerateFinalWeights(InPoseConfig, NewDatabase->StandardDeviation);
+
+		//Generate search bounds
+		NewDatabase->PoseAABBMatrix_Outer = FPoseAABBMatrix(NewDatabase->PoseMatrix, InPoseConfig->TotalDimensionCount,
+			FPoseMatchDatabase::OuterAABBSize);
+		NewDatabase->PoseAABBMatrix_Inner = FPoseAABBMatrix(NewDatabase->PoseMatrix, InPoseConfig->TotalDimensionCount,
+			FPoseMatchDatabase::InnerAABBSize);
+
+		return NewDatabase;
+	}
+}
+
+FPoseMatchData::FPoseMatchData()
+	: PoseId(-1),
+	AnimId(0),
+	bMirror(false),
+	Time(0.0f)
+{
+}
+
+FPoseMatchData::FPoseMatchData(int32 InPoseId, int32 InAnimId, float InTime, bool bInMirror)
+	: PoseId(InPoseId),
+	AnimId(InAnimId),
+	bMirror(bInMirror),
+	Time(InTime)
+{
+}
+
+FPoseMatchDatabaseKey::FPoseMatchDatabaseKey()
+	: PoseInterval(0.0f),
+	PosesEndTime(0.0f),
+	bMirroring(false)
+{
+}
+
+bool FPoseMatchDatabaseKey::operator==(const FPoseMatchDatabaseKey& Other) const
+{
+	return BakeId == Other.BakeId
+		&& PoseInterval == Other.PoseInterval
+		&& PosesEndTime == Other.PosesEndTime
+		&& bMirroring == Other.bMirroring
+		&& SourceAssets == Other.SourceAssets;
+}
+
+uint32 GetTypeHash(const FPoseMatchDatabaseKey& Key)
+{
+	uint32 Hash = HashCombine(GetTypeHash(Key.BakeId), GetTypeHash(Key.PoseInterval));
+	Hash = HashCombine(Hash, GetTypeHash(Key.PosesEndTime));
+	Hash = HashCombine(Hash, static_cast<uint32>(Key.bMirroring));
+	for(const FObjectKey& SourceAsset : Key.SourceAssets)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(SourceAsset));
+	}
+
+	return Hash;
+}
+
+TSharedPtr<const FPoseMatchDatabase, ESPMode::ThreadSafe> FPoseMatchDatabase::FindOrCreate(const FPoseMatchDatabaseKey& InKey,
+	UMotionMatchConfig* InPoseConfig, TFunctionRef<void(FPoseMatchDatabase&)> InBakeDatabase)
+{
+	if(!InPoseConfig)
+	{
+		return nullptr;
+	}
+
+	//Un-baked nodes are only keyed on the identity of their sources, which cannot tell whether a source has been edited
+	//since another instance built its database. They are never shared.
+	if(!InKey.BakeId.IsValid())
+	{
+		return BakeDatabase(InPoseConfig, InBakeDatabase);
+	}
+
+	FPoseMatchDatabaseRegistry& Registry = GetPoseMatchDatabaseRegistry();
+
+	FPoseMatchDatabaseSlotPtr Slot;
+	{
+		FScopeLock ScopeLock(&Registry.CriticalSection);
+
+		//Drop slots whose database has been released by every node and that no other node is currently baking
+		for(auto EntryIt = Registry.Entries.CreateIterator(); EntryIt; ++EntryIt)
+		{
+			if(EntryIt->Value.IsUnique()
+				&& !EntryIt->Value->Database.IsValid())
+			{
+				EntryIt.RemoveCurrent();
+			}
+		}
+
+		FPoseMatchDatabaseSlotPtr& Entry = Registry.Entries.FindOrAdd(InKey);
+		if(!Entry.IsValid())
+		{
+			Entry = MakeShared<FPoseMatchDatabaseSlot, ESPMode::ThreadSafe>();
+		}
+
+		Slot = Entry;
+	}
+
+	//Only nodes with the same key wait here while the database is baked
+	FScopeLock BakeScopeLock(&Slot->BakeCriticalSection);
+	if(FPoseMatchDatabasePtr ExistingDatabase = Slot->Database.Pin())
+	{
+		return ExistingDatabase;
+	}
+
+	FPoseMatchDatabasePtr NewDatabase = BakeDatabase(InPoseConfig, InBakeDatabase);
+	Slot->Database = NewDatabase;
+	return NewDatabase;
+}
@@ -10,13 +10,24 @@ FPoseAABBMatrix::FPoseAABBMatrix()
 }
 
 FPoseAABBMatrix::FPoseAABBMatrix(const FPoseMatrix& InSearchMatrix, const int32 InBoxSize)
+	: FPoseAABBMatrix(InSearchMatrix.PoseArray, InSearchMatrix.AtomCount, InBoxSize)
+{
+}
+
+FPoseAABBMatrix::FPoseAABBMatrix(const TArray<float>& InPoseArray, const int32 InAtomCount, const int32 InBoxSize)
 	: DimCount(0),
       AABBCount(0)
 {
-	const float AtomCount = InSearchMatrix.AtomCount;
-	const float PoseCount = InSearchMatrix.PoseCount;
-	const TArray<float>& PoseArray_SM = InSearchMatrix.PoseArray;
+	if(InAtomCount <= 0 || InBoxSize <= 0)
+	{
+		return;
+	}
+	
+	const int32 AtomCount = InAtomCount;
+	const int32 PoseCount = InPoseArray.Num() / InAtomCount;
+	const TArray<float>& PoseArray_SM = InPoseArray;
 
+	DimCount = AtomCount;
 	AABBCount = FMath::CeilToInt32(PoseCount / static_cast<float>(InBoxSize));
 
 	//Initialize the extents array so that the first pose to be checked will become the AABB bounds
@@ -31,14 +42,13 @@ FPoseAABBMatrix::FPoseAABBMatrix(const FPoseMatrix& InSearchMatrix, const int32
 	for (int32 AABBIndex = 0; AABBIndex < AABBCount; ++AABBIndex)
 	{
 		const int32 StartPoseIndex = AABBIndex * InBoxSize;
-		const int32 EndPoseIndex = FMath::Min(StartPoseIndex + InBoxSize, PoseCount - 1);
-		const float AABBPoseIndex = AABBIndex * InBoxSize;
+		const int32 EndPoseIndex = FMath::Min(StartPoseIndex + InBoxSize, PoseCount); //Exclusive
 
 		//Iterate through Poses
 		for (int32 PoseIndex = StartPoseIndex; PoseIndex < EndPoseIndex; ++PoseIndex)
 		{
-			const float StartAtomIndex = PoseIndex * AtomCount;
-			const float EndAtomIndex = StartAtomIndex + AtomCount;
+			const int32 StartAtomIndex = PoseIndex * AtomCount;
+			const int32 EndAtomIndex = StartAtomIndex + AtomCount;
 
 			//Iterate through atoms
 			int32 ExtentsAtomIndex = AABBIndex * (AtomCount * 2);
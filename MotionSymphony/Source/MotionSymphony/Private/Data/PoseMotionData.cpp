@@ -42,4 +42,53 @@ void FPoseMotionData::Clear()
 	bMirrored = false;
 	SearchFlag = EPoseSearchFlag::Searchable;
 	MotionTags = FGameplayTagContainer::EmptyContainer;
-}
\ No newline at end of file
+}
+
+FRuntimePoseData::FRuntimePoseData()
+	: PoseId(0),
+	  AnimId(0),
+	  NextPoseId(0),
+	  LastPoseId(0),
+	  Time(0.0f),
+	  TagSectionIndex(INDEX_NONE),
+	  UsablePoseCount(0),
+	  UsableEndTime(0.0f),
+	  AnimType(EMotionAnimAssetType::None),
+	  SearchFlag(EPoseSearchFlag::Searchable),
+	  bMirrored(false)
+{
+}
+
+FRuntimePoseData::FRuntimePoseData(const FPoseMotionData& InPose, const int32 InTagSectionIndex)
+	: PoseId(InPose.PoseId),
+	  AnimId(InPose.AnimId),
+	  NextPoseId(InPose.NextPoseId),
+	  LastPoseId(InPose.LastPoseId),
+	  Time(InPose.Time),
+	  TagSectionIndex(InTagSectionIndex),
+	  UsablePoseCount(0),
+	  UsableEndTime(InPose.Time),
+	  AnimType(InPose.AnimType),
+	  SearchFlag(InPose.SearchFlag),
+	  bMirrored(InPose.bMirrored)
+{
+}
+
+FPoseRootMotion::FPoseRootMotion()
+	: Translation(FVector3f::ZeroVector),
+	Yaw(0.0f),
+	Duration(0.0f)
+{
+}
+
+FPoseRootMotion::FPoseRootMotion(const FTransform& InRootMotion, const float InDuration)
+	: Translation(InRootMotion.GetTranslation()),
+	Yaw(InRootMotion.Rotator().Yaw),
+	Duration(InDuration)
+{
+}
+
+FTransform FPoseRootMotion::GetRootMotion(const float Fraction) const
+{
+	return FTransform(FRotator(0.0f, Yaw * Fraction, 0.0f), FVector(Translation * Fraction));
+}
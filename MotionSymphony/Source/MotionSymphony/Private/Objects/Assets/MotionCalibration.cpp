@@ -1,6 +1,7 @@
 //Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
 
 #include "Objects/Assets/MotionCalibration.h"
+#include "Data/MotionMatchingRuntimeData.h"
 
 #define LOCTEXT_NAMESPACE "MotionCalibration"
 
@@ -23,6 +24,7 @@ void UMotionCalibration::Initialize()
 		OnGenerateWeightings();
 	}
 
+	const TArray<float> PreviousAdjustedCalibrationArray = MoveTemp(AdjustedCalibrationArray);
 	AdjustedCalibrationArray = CalibrationArray;
 
 	int32 AtomIndex = 0;
@@ -50,6 +52,12 @@ void UMotionCalibration::Initialize()
 		}
 	}
 
+	//Nodes share runtime data with this calibration folded in so it must be rebuilt if the weights changed
+	if(AdjustedCalibrationArray != PreviousAdjustedCalibrationArray)
+	{
+		FMotionMatchingRuntimeData::Invalidate(this);
+	}
+
 	Modify(); 
 }
 
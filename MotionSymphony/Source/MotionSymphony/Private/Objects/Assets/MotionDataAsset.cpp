@@ -14,6 +14,7 @@
 #include "Utility/MMBlueprintFunctionLibrary.h"
 #include "Animation/MirrorDataTable.h"
 #include "Data/MotionAnimAsset.h"
+#include "Data/MotionMatchingRuntimeData.h"
 
 #if WITH_EDITOR
 #include "AnimationEditorUtils.h"
@@ -26,10 +27,18 @@
 UMotionDataAsset::UMotionDataAsset(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer),
 	PoseInterval(0.1f),
+	PoseSamplingMode(EPoseSamplingMode::Uniform),
+	AdaptiveSamplingMaxError(0.1f),
+	AdaptiveSamplingMaxStride(4),
+	RedundantPoseThreshold(0.0f),
+	RedundantPoseThresholdUsed(0.0f),
+	UnprunedSearchPoseCount(0),
+	RedundantPoseCount(0),
 	MotionMatchConfig(nullptr),
 	JointVelocityCalculationMethod(EJointVelocityCalculationMethod::BodyDependent),
 	NotifyTriggerMode(ENotifyTriggerMode::HighestWeightedAnimation),
-	bIsProcessed(false)
+	bIsProcessed(false),
+	bVariablePoseSpacing(false)
 #if WITH_EDITORONLY_DATA
 	, AnimPreviewIndex(-1),
 	AnimMetaPreviewType(EMotionAnimAssetType::None)
@@ -399,6 +408,7 @@ void UMotionDataAsset::PreProcess()
 
 	//Setup mirroring data
 	ClearPoses();
+	const bool bBakeMirroredPoses = !GenerateMirrorAtomMap();
 	InitializePoseMatrix();
 	
 	MMPreProcessTask.EnterProgressFrame();
@@ -410,7 +420,7 @@ void UMotionDataAsset::PreProcess()
 
 		PreProcessAnim(i, false);
 
-		if (MirrorDataTable != nullptr && SourceMotionSequenceObjects[i]->bEnableMirroring)
+		if(bBakeMirroredPoses && MirrorDataTable != nullptr && SourceMotionSequenceObjects[i]->bEnableMirroring)
 		{
 			PreProcessAnim(i, true);
 		}
@@ -423,7 +433,7 @@ void UMotionDataAsset::PreProcess()
 
 		PreProcessBlendSpace(i, false);
 
-		if(MirrorDataTable != nullptr && SourceBlendSpaceObjects[i]->bEnableMirroring)
+		if(bBakeMirroredPoses && MirrorDataTable != nullptr && SourceBlendSpaceObjects[i]->bEnableMirroring)
 		{
 			PreProcessBlendSpace(i, true);
 		}
@@ -436,14 +446,17 @@ void UMotionDataAsset::PreProcess()
 		
 		PreProcessComposite(i, false);
 
-		if (MirrorDataTable != nullptr && SourceCompositeObjects[i]->bEnableMirroring)
+		if(bBakeMirroredPoses && MirrorDataTable != nullptr && SourceCompositeObjects[i]->bEnableMirroring)
 		{
 			PreProcessComposite(i, true);
 		}
 	}
 	
+	ApplyAdaptiveSampling();
 	GeneratePoseSequencing();
 	MarkEdgePoses(0.25f);
+	PruneRedundantPoses();
+	BakeRootMotionTable();
 	
 	//Find a list of traits used
 	// TArray<FMotionTraitField> UsedMotionTraits;
@@ -472,13 +485,9 @@ void UMotionDataAsset::PreProcess()
 	GenerateSearchPoseMatrix();
 	MMPreProcessTask.EnterProgressFrame();
 
-	//Standard deviations
+	//Standard deviations (all motion tag sets are generated in a single pass over the pose matrix)
 	FeatureStandardDeviations.Empty(TagSlack);
-	for (const FGameplayTagContainer& Tags : UsedMotionTags)
-	{;
-		FeatureStandardDeviations.Emplace(FCalibrationData(this));
-		FeatureStandardDeviations.Last().GenerateStandardDeviationWeights(this, Tags);
-	}
+	FCalibrationData::GenerateStandardDeviationWeights(this, UsedMotionTags, FeatureStandardDeviations);
 	
 	bIsProcessed = true;
 
@@ -489,7 +498,15 @@ void UMotionDataAsset::PreProcess()
 void UMotionDataAsset::ClearPoses()
 {
 	Poses.Empty();
+	RuntimePoses.Empty();
+	PoseRootMotionTable.Empty();
+	AnimNotifyIndices.Empty();
+	MirrorAtomSourceIndices.Empty();
+	MirrorAtomSigns.Empty();
 	bIsProcessed = false;
+	bVariablePoseSpacing = false;
+
+	FMotionMatchingRuntimeData::Invalidate(this);
 }
 
 bool UMotionDataAsset::IsSetupValid()
@@ -609,6 +626,278 @@ float UMotionDataAsset::GetPoseInterval() const
 	return PoseInterval;
 }
 
+float UMotionDataAsset::GetSearchCostReduction() const
+{
+	if(UnprunedSearchPoseCount <= 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(RedundantPoseCount) / static_cast<float>(UnprunedSearchPoseCount);
+}
+
+bool UMotionDataAsset::UsesRuntimeMirroring() const
+{
+	return MirrorAtomSourceIndices.Num() > 0
+		&& MirrorAtomSourceIndices.Num() == LookupPoseMatrix.AtomCount
+		&& MirrorAtomSigns.Num() == LookupPoseMatrix.AtomCount;
+}
+
+bool UMotionDataAsset::HasBakedRootMotion() const
+{
+	return Poses.Num() > 0
+		&& PoseRootMotionTable.Num() == Poses.Num();
+}
+
+bool UMotionDataAsset::ExtractBakedRootMotion(const FAnimChannelState& ChannelState, const float StartTime,
+	const float DeltaTime, FTransform& OutRootMotion) const
+{
+	if(!HasBakedRootMotion()
+		|| !Poses.IsValidIndex(ChannelState.StartPoseId))
+	{
+		return false;
+	}
+
+	OutRootMotion = FTransform::Identity;
+	const float AnimLength = ChannelState.AnimLength;
+	if(FMath::IsNearlyZero(DeltaTime)
+		|| AnimLength < UE_KINDA_SMALL_NUMBER)
+	{
+		return true;
+	}
+
+	//Playing backwards accumulates the same range forwards and inverts it
+	const bool bPlayingBackwards = DeltaTime < 0.0f;
+	float Time = bPlayingBackwards ? StartTime + DeltaTime : StartTime;
+	float RemainingTime = FMath::Abs(DeltaTime);
+
+	if(ChannelState.bLoop)
+	{
+		Time = FMotionMatchingUtils::WrapAnimationTime(Time, AnimLength);
+	}
+	else
+	{
+		RemainingTime += FMath::Min(Time, 0.0f);
+		Time = FMath::Clamp(Time, 0.0f, AnimLength);
+	}
+
+	FRootMotionMovementParams RootMotionParams;
+	for(int32 Iteration = 0; RemainingTime > UE_KINDA_SMALL_NUMBER && Iteration < 256; ++Iteration)
+	{
+		int32 BeforePoseId = 0;
+		int32 AfterPoseId = 0;
+		float InterpolationValue = 0.0f;
+		FindPosePairAtTime(ChannelState.StartPoseId, Time, AnimLength, BeforePoseId, AfterPoseId, InterpolationValue);
+
+		const FPoseRootMotion& PoseRootMotion = PoseRootMotionTable[BeforePoseId];
+		const float StepTime = FMath::Min(RemainingTime, Poses[BeforePoseId].Time + PoseRootMotion.Duration - Time);
+
+		if(StepTime < UE_KINDA_SMALL_NUMBER
+			|| PoseRootMotion.Duration < UE_KINDA_SMALL_NUMBER)
+		{
+			//The end of the animation has been reached. Looping animations continue from the start
+			if(!ChannelState.bLoop
+				|| Time < AnimLength - UE_KINDA_SMALL_NUMBER)
+			{
+				break;
+			}
+
+			Time = 0.0f;
+			continue;
+		}
+
+		RootMotionParams.Accumulate(PoseRootMotion.GetRootMotion(StepTime / PoseRootMotion.Duration));
+		Time += StepTime;
+		RemainingTime -= StepTime;
+	}
+
+	OutRootMotion = RootMotionParams.GetRootMotionTransform();
+	if(bPlayingBackwards)
+	{
+		OutRootMotion = OutRootMotion.Inverse();
+	}
+
+	return true;
+}
+
+bool UMotionDataAsset::IsSearchPoseMirrorable(const int32 MatrixPoseId) const
+{
+	return SearchPoseMirrorMask.IsValidIndex(MatrixPoseId) && SearchPoseMirrorMask[MatrixPoseId];
+}
+
+void UMotionDataAsset::MirrorPoseArray(const float* InPoseArray, float* OutPoseArray) const
+{
+	//Note: The input and output arrays must not overlap as atoms are read from their counterpart location
+	const int32 AtomCount = MirrorAtomSourceIndices.Num();
+	for(int32 AtomIndex = 0; AtomIndex < AtomCount; ++AtomIndex)
+	{
+		OutPoseArray[AtomIndex] = MirrorAtomSigns[AtomIndex] * InPoseArray[MirrorAtomSourceIndices[AtomIndex]];
+	}
+}
+
+bool UMotionDataAsset::HasVariablePoseSpacing() const
+{
+	return bVariablePoseSpacing;
+}
+
+bool UMotionDataAsset::IsSamePoseSequence(const FPoseMotionData& PoseA, const FPoseMotionData& PoseB) const
+{
+	return PoseA.AnimType == PoseB.AnimType
+		&& PoseA.AnimId == PoseB.AnimId
+		&& PoseA.bMirrored == PoseB.bMirrored
+		&& FVector2D::Distance(PoseA.BlendSpacePosition, PoseB.BlendSpacePosition) < 0.001f;
+}
+
+int32 UMotionDataAsset::GetPoseCountInTimeSpan(const int32 PoseId, const float TimeSpan) const
+{
+	if(!bVariablePoseSpacing)
+	{
+		return FMath::CeilToInt32(TimeSpan / FMath::Max(0.01f, PoseInterval));
+	}
+
+	if(!Poses.IsValidIndex(PoseId))
+	{
+		return 0;
+	}
+
+	const FPoseMotionData& StartPose = Poses[PoseId];
+	int32 PoseIndex = PoseId + 1;
+	for(; PoseIndex < Poses.Num(); ++PoseIndex)
+	{
+		const FPoseMotionData& Pose = Poses[PoseIndex];
+		
+		if(!IsSamePoseSequence(StartPose, Pose))
+		{
+			++PoseIndex; //Include the first pose of the next sequence so that callers can still detect the animation change
+			break;
+		}
+
+		if(Pose.Time - StartPose.Time >= TimeSpan)
+		{
+			break;
+		}
+	}
+
+	return PoseIndex - PoseId;
+}
+
+int32 UMotionDataAsset::FindClosestPoseIdInRange(const int32 StartPoseId, const int32 EndPoseId, const float AnimTime) const
+{
+	if(Poses.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+	
+	const int32 RangeStart = FMath::Clamp(StartPoseId, 0, Poses.Num() - 1);
+	int32 Low = RangeStart;
+	int32 High = FMath::Clamp(EndPoseId, RangeStart, Poses.Num() - 1);
+
+	//Binary search for the first pose at or after the desired time
+	while(Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if(Poses[Mid].Time < AnimTime)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	if(Low > RangeStart && AnimTime - Poses[Low - 1].Time < Poses[Low].Time - AnimTime)
+	{
+		return Low - 1;
+	}
+
+	return Low;
+}
+
+void UMotionDataAsset::FindPosePairAtTime(const int32 PoseId, const float AnimTime, const float AnimLength,
+	int32& OutBeforePoseId, int32& OutAfterPoseId, float& OutInterpolationValue) const
+{
+	const int32 PoseCount = Poses.Num();
+	if(PoseCount == 0)
+	{
+		OutBeforePoseId = OutAfterPoseId = INDEX_NONE;
+		OutInterpolationValue = 0.0f;
+		return;
+	}
+	
+	const FPoseMotionData& SequencePose = Poses[FMath::Clamp(PoseId, 0, PoseCount - 1)];
+
+	//Gallop backwards until a pose at or before the desired time is found or the start of the sequence is reached
+	int32 Low = SequencePose.PoseId;
+	int32 Step = 1;
+	while(Poses[Low].Time > AnimTime)
+	{
+		int32 Probe = Low - Step;
+		if(Probe < 0 || !IsSamePoseSequence(Poses[Probe], SequencePose))
+		{
+			//Binary search for the first pose of the sequence
+			while(Low - Probe > 1)
+			{
+				const int32 Mid = (Low + Probe) / 2;
+				if(Mid >= 0 && IsSamePoseSequence(Poses[Mid], SequencePose))
+				{
+					Low = Mid;
+				}
+				else
+				{
+					Probe = Mid;
+				}
+			}
+			
+			break;
+		}
+
+		Low = Probe;
+		Step *= 2;
+	}
+
+	//Gallop forwards until a pose after the desired time is found or the end of the sequence is passed
+	int32 High = Low + 1;
+	Step = 1;
+	while(High < PoseCount
+		&& IsSamePoseSequence(Poses[High], SequencePose)
+		&& Poses[High].Time <= AnimTime)
+	{
+		Low = High;
+		Step *= 2;
+		High = Low + Step;
+	}
+	
+	//Binary search for the last pose at or before the desired time
+	High = FMath::Min(High, PoseCount);
+	while(High - Low > 1)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if(IsSamePoseSequence(Poses[Mid], SequencePose) && Poses[Mid].Time <= AnimTime)
+		{
+			Low = Mid;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	const FPoseMotionData& BeforePose = Poses[Low];
+	const FPoseMotionData& AfterPose = Poses[FMath::Clamp(BeforePose.NextPoseId, 0, PoseCount - 1)];
+	
+	float AfterTime = AfterPose.Time;
+	if(AfterPose.PoseId < BeforePose.PoseId)
+	{
+		AfterTime += AnimLength; //The sequence loops back to its start
+	}
+
+	OutBeforePoseId = BeforePose.PoseId;
+	OutAfterPoseId = AfterPose.PoseId;
+	OutInterpolationValue = AfterTime > BeforePose.Time + UE_SMALL_NUMBER
+		? FMath::Clamp((AnimTime - BeforePose.Time) / (AfterTime - BeforePose.Time), 0.0f, 1.0f) : 0.0f;
+}
+
 float UMotionDataAsset::GetPoseFavour(const int32 PoseId) const
 {
 	//Pose Favour is stored as the first atom of a pose array
@@ -723,7 +1012,8 @@ int32 UMotionDataAsset::DatabasePoseIdToMatrixPoseId(int32 DatabasePoseId) const
 
 bool UMotionDataAsset::IsSearchPoseMatrixGenerated() const
 {
-	return SearchPoseMatrix.PoseCount > 0;
+	return SearchPoseMatrix.PoseCount > 0
+		&& RuntimePoses.Num() == Poses.Num();
 }
 
 void UMotionDataAsset::PostLoad()
@@ -809,11 +1099,11 @@ void UMotionDataAsset::RemapTracksToNewSkeleton(USkeleton* NewSkeleton, bool bCo
 void UMotionDataAsset::TickAssetPlayer(FAnimTickRecord& Instance, FAnimNotifyQueue& NotifyQueue, FAnimAssetTickContext& Context) const
 {
 	const float DeltaTime = Context.GetDeltaTime();
-	const bool bGenerateNotifies = NotifyTriggerMode != ENotifyTriggerMode::None;
 
-	TArray<FAnimNotifyEventReference> Notifies;
-	
 	FAnimChannelState* ChannelState = reinterpret_cast<FAnimChannelState*>(Instance.BlendSpace.BlendSampleDataCache);
+	const bool bGenerateNotifies = NotifyTriggerMode != ENotifyTriggerMode::None && !ChannelState->bSkipNotifies;
+	TArray<FAnimNotifyEventReference>& Notifies = ChannelState->NotifyScratch;
+	Notifies.Reset();
 	
 	switch (ChannelState->AnimType)
 	{
@@ -845,11 +1135,7 @@ void UMotionDataAsset::TickAssetPlayer(FAnimTickRecord& Instance, FAnimNotifyQue
 							}
 						}
 					
-						FAnimTickRecord TickRecord;
-						TickRecord.bLooping = MotionAnim->bLoop;
-						FAnimNotifyContext AnimNotifyContext(TickRecord);
-						MotionAnim->Sequence->GetAnimNotifies(PreviousTime, DeltaTime, AnimNotifyContext);
-						Notifies = AnimNotifyContext.ActiveNotifies;
+						GatherAnimNotifies(MotionAnim->Sequence, PreviousTime, DeltaTime, MotionAnim->bLoop, Notifies);
 					}
 				} break;
 				case EMotionAnimAssetType::BlendSpace:
@@ -884,11 +1170,7 @@ void UMotionDataAsset::TickAssetPlayer(FAnimTickRecord& Instance, FAnimNotifyQue
 
 						if (BlendSequence)
 						{
-							FAnimTickRecord TickRecord;
-							TickRecord.bLooping = bLooping;
-							FAnimNotifyContext AnimNotifyContext(TickRecord);
-							BlendSequence->GetAnimNotifies(PreviousTime, DeltaTime, AnimNotifyContext);
-							Notifies = AnimNotifyContext.ActiveNotifies;
+							GatherAnimNotifies(BlendSequence, PreviousTime, DeltaTime, bLooping, Notifies);
 						}
 					}
 				} break;
@@ -906,11 +1188,7 @@ void UMotionDataAsset::TickAssetPlayer(FAnimTickRecord& Instance, FAnimNotifyQue
 							}
 						}
 						
-						FAnimTickRecord TickRecord;
-						TickRecord.bLooping = MotionComposite->bLoop;
-						FAnimNotifyContext AnimNotifyContext(TickRecord);
-						MotionComposite->AnimComposite->GetAnimNotifies(PreviousTime, DeltaTime, AnimNotifyContext);
-						Notifies = AnimNotifyContext.ActiveNotifies;
+						GatherAnimNotifies(MotionComposite->AnimComposite, PreviousTime, DeltaTime, MotionComposite->bLoop, Notifies);
 					}
 				}
 			default: break;
@@ -947,18 +1225,19 @@ void UMotionDataAsset::TickAnimChannelForSequence(const FAnimChannelState& Chann
 		{
 			if (NotifyTriggerMode == ENotifyTriggerMode::AllAnimations)
 			{
-				FAnimTickRecord TickRecord;
-				TickRecord.bLooping = MotionAnim->bLoop;
-				FAnimNotifyContext AnimNotifyContext(TickRecord);
-				Sequence->GetAnimNotifies(PreviousTime, DeltaTime, AnimNotifyContext);
-				Notifies = AnimNotifyContext.ActiveNotifies;
+				GatherAnimNotifies(Sequence, PreviousTime, DeltaTime, MotionAnim->bLoop, Notifies);
 			}
 		}
 
 		//Root Motion
 		if (Context.RootMotionMode == ERootMotionMode::RootMotionFromEverything && Sequence->bEnableRootMotion)
 		{
-			FTransform RootMotion = Sequence->ExtractRootMotion(PreviousTime, DeltaTime, MotionAnim->bLoop);
+			FTransform RootMotion;
+			if(!ChannelState.bUseBakedRootMotion
+				|| !ExtractBakedRootMotion(ChannelState, PreviousTime, DeltaTime, RootMotion))
+			{
+				RootMotion = Sequence->ExtractRootMotion(PreviousTime, DeltaTime, MotionAnim->bLoop);
+			}
 
 			if (ChannelState.bMirrored && MirrorDataTable != nullptr)
 			{
@@ -988,6 +1267,22 @@ void UMotionDataAsset::TickAnimChannelForBlendSpace(const FAnimChannelState& Cha
 	{
 		const float CurrentTime = FMath::Clamp(ChannelState.AnimTime, 0.0f, PlayLength);
 		const float PreviousTime = CurrentTime - DeltaTime;
+
+		//Baked root motion already has the blend sample weights applied
+		bool bExtractSampleRootMotion = Context.RootMotionMode == ERootMotionMode::RootMotionFromEverything;
+		FTransform BakedRootMotion;
+		if(bExtractSampleRootMotion
+			&& ChannelState.bUseBakedRootMotion
+			&& ExtractBakedRootMotion(ChannelState, PreviousTime, DeltaTime, BakedRootMotion))
+		{
+			if (ChannelState.bMirrored && MirrorDataTable != nullptr)
+			{
+				BakedRootMotion.Mirror(EAxis::X, EAxis::X);
+			}
+
+			Context.RootMotionMovementParams.Accumulate(BakedRootMotion);
+			bExtractSampleRootMotion = false;
+		}
 		
 		for(int32 i = 0; i < ChannelState.BlendSampleDataCache.Num(); ++i)
 		{
@@ -1010,16 +1305,12 @@ void UMotionDataAsset::TickAnimChannelForBlendSpace(const FAnimChannelState& Cha
 			{
 				if (NotifyTriggerMode == ENotifyTriggerMode::AllAnimations)
 				{
-					FAnimTickRecord TickRecord;
-					TickRecord.bLooping = MotionBlendSpace->bLoop;
-					FAnimNotifyContext AnimNotifyContext(TickRecord);
-					SampleSequence->GetAnimNotifies(PreviousTime, DeltaTime, AnimNotifyContext);
-					Notifies = AnimNotifyContext.ActiveNotifies;
+					GatherAnimNotifies(SampleSequence, PreviousTime, DeltaTime, MotionBlendSpace->bLoop, Notifies);
 				}
 			}
 
 			//RootMotion
-			if (Context.RootMotionMode == ERootMotionMode::RootMotionFromEverything && SampleSequence->bEnableRootMotion)
+			if (bExtractSampleRootMotion && SampleSequence->bEnableRootMotion)
 			{
 				FTransform RootMotion = SampleSequence->ExtractRootMotion(PreviousTime, DeltaTime, MotionBlendSpace->bLoop);
 				
@@ -1055,29 +1346,21 @@ void UMotionDataAsset::TickAnimChannelForComposite(const FAnimChannelState& Chan
 		{
 			if (NotifyTriggerMode == ENotifyTriggerMode::AllAnimations)
 			{
-				FAnimTickRecord TickRecord;
-				TickRecord.bLooping = MotionComposite->bLoop;
-				FAnimNotifyContext AnimNotifyContext(TickRecord);
-				Composite->GetAnimNotifies(PreviousTime, DeltaTime, AnimNotifyContext);
-
-				Notifies.Reset(AnimNotifyContext.ActiveNotifies.Num());
-
-				for(FAnimNotifyEventReference NotifyRef : AnimNotifyContext.ActiveNotifies)
-				{
-					if(const FAnimNotifyEvent* Notify = NotifyRef.GetNotify())
-					{
-						Notifies.Add(NotifyRef);
-					}
-				}
+				GatherAnimNotifies(Composite, PreviousTime, DeltaTime, MotionComposite->bLoop, Notifies);
 			}
 		}
 
 		//Root Motion
 		if (Context.RootMotionMode == ERootMotionMode::RootMotionFromEverything)
 		{
-			FRootMotionMovementParams RootMotionParams;
-			Composite->ExtractRootMotionFromTrack(Composite->AnimationTrack, PreviousTime, PreviousTime + DeltaTime, RootMotionParams);
-			FTransform RootMotion = RootMotionParams.GetRootMotionTransform();
+			FTransform RootMotion;
+			if(!ChannelState.bUseBakedRootMotion
+				|| !ExtractBakedRootMotion(ChannelState, PreviousTime, DeltaTime, RootMotion))
+			{
+				FRootMotionMovementParams RootMotionParams;
+				Composite->ExtractRootMotionFromTrack(Composite->AnimationTrack, PreviousTime, PreviousTime + DeltaTime, RootMotionParams);
+				RootMotion = RootMotionParams.GetRootMotionTransform();
+			}
 
 			if (ChannelState.bMirrored && MirrorDataTable != nullptr)
 			{
@@ -1281,6 +1564,36 @@ void UMotionDataAsset::AddAnimNotifiesToNotifyQueue(FAnimNotifyQueue& NotifyQueu
 	}
 }
 
+void UMotionDataAsset::GatherAnimNotifies(const UAnimSequenceBase* SourceAnim, const float StartTime, const float DeltaTime,
+	const bool bLooping, TArray<FAnimNotifyEventReference>& OutNotifies) const
+{
+	if(!SourceAnim)
+	{
+		return;
+	}
+
+	const FAnimNotifyIndex* NotifyIndex = AnimNotifyIndices.Find(SourceAnim);
+	if(NotifyIndex && NotifyIndex->IsValidFor(SourceAnim))
+	{
+		NotifyIndex->GetAnimNotifies(SourceAnim, StartTime, DeltaTime, bLooping, OutNotifies);
+		return;
+	}
+
+	//Fallback for animations without a notify index (e.g. composites whose notifies live in their segments)
+	FAnimTickRecord TickRecord;
+	TickRecord.bLooping = bLooping;
+	FAnimNotifyContext AnimNotifyContext(TickRecord);
+	SourceAnim->GetAnimNotifies(StartTime, DeltaTime, AnimNotifyContext);
+
+	for(const FAnimNotifyEventReference& NotifyRef : AnimNotifyContext.ActiveNotifies)
+	{
+		if(NotifyRef.GetNotify())
+		{
+			OutNotifies.Add(NotifyRef);
+		}
+	}
+}
+
 void UMotionDataAsset::InitializePoseMatrix()
 {
 	if(!MotionMatchConfig)
@@ -1300,6 +1613,9 @@ void UMotionDataAsset::InitializePoseMatrix()
 	}
 	LookupPoseMatrix.AtomCount = AtomCount;
 
+	//Mirrored poses are only stored in the matrix if they are not mirrored at runtime
+	const bool bBakeMirroredPoses = MirrorAtomSourceIndices.Num() == 0;
+
 	//Get Pose Count from sequences
 	int32 PoseCount = 0;
 	for(TObjectPtr<UMotionSequenceObject> MotionAnimSequence : SourceMotionSequenceObjects)
@@ -1307,7 +1623,7 @@ void UMotionDataAsset::InitializePoseMatrix()
 		if(MotionAnimSequence)
 		{
 			const int32 PoseCountThisAnim = FMath::FloorToInt32(MotionAnimSequence->GetPlayLength() / (PoseInterval * MotionAnimSequence->PlayRate)) + 1;
-			PoseCount += MotionAnimSequence->bEnableMirroring ? PoseCountThisAnim * 2 : PoseCountThisAnim;
+			PoseCount += bBakeMirroredPoses && MotionAnimSequence->bEnableMirroring ? PoseCountThisAnim * 2 : PoseCountThisAnim;
 		}
 	}
 
@@ -1317,7 +1633,7 @@ void UMotionDataAsset::InitializePoseMatrix()
 		if(MotionComposite)
 		{
 			const int32 PoseCountThisAnim = FMath::FloorToInt32(MotionComposite->GetPlayLength() / (PoseInterval * MotionComposite->PlayRate)) + 1;
-			PoseCount += MotionComposite->bEnableMirroring ? PoseCountThisAnim * 2 : PoseCountThisAnim;
+			PoseCount += bBakeMirroredPoses && MotionComposite->bEnableMirroring ? PoseCountThisAnim * 2 : PoseCountThisAnim;
 		}
 	}
 
@@ -1326,16 +1642,14 @@ void UMotionDataAsset::InitializePoseMatrix()
 	{
 		if(MotionBlendSpace)
 		{
-			const FBlendParameter XAxisParameter = MotionBlendSpace->BlendSpace->GetBlendParameter(0);
-			const FBlendParameter YAxisParameter = MotionBlendSpace->BlendSpace->GetBlendParameter(1);
-		
-			const int32 BSSampleCount = FMath::Floor((XAxisParameter.Max - XAxisParameter.Min) / MotionBlendSpace->SampleSpacing.X)
-				* FMath::Floor((YAxisParameter.Max - XAxisParameter.Min) / MotionBlendSpace->SampleSpacing.Y);
+			FVector2D GridStart, GridStep;
+			const FIntPoint GridSize = GetBlendSpaceSampleGrid(MotionBlendSpace, GridStart, GridStep);
+			const int32 BSSampleCount = GridSize.X * GridSize.Y; //Adaptive sampling may use fewer but never more than this
 
 			const int32 PoseCountThisAnim = (FMath::FloorToInt32(MotionBlendSpace->GetPlayLength()
 				/ (PoseInterval * MotionBlendSpace->PlayRate)) + 1) * BSSampleCount;
 		
-			PoseCount += MotionBlendSpace->bEnableMirroring ? PoseCountThisAnim * 2 : PoseCountThisAnim;
+			PoseCount += bBakeMirroredPoses && MotionBlendSpace->bEnableMirroring ? PoseCountThisAnim * 2 : PoseCountThisAnim;
 		}
 	}
 
@@ -1481,153 +1795,338 @@ void UMotionDataAsset::PreProcessBlendSpace(const int32 SourceBlendSpaceIndex, c
 	MotionBlendSpace->AnimId = SourceBlendSpaceIndex;
 
 	//Determine initial values to begin pre-processing
-	const bool TwoDBlendSpace = Cast<UBlendSpace>(BlendSpace) == nullptr ? false : true;
-	const FBlendParameter XAxisParameter = BlendSpace->GetBlendParameter(0);
-	const float XAxisStart = XAxisParameter.Min;
-	const float XAxisEnd = XAxisParameter.Max;
-	const float XAxisStep = FMath::Abs((XAxisEnd - XAxisStart) * MotionBlendSpace->SampleSpacing.X);
-	float YAxisStart = 0.0f;
-	float YAxisEnd = 0.1f;
-	float YAxisStep = 0.2f;
-
-	if (TwoDBlendSpace)
-	{
-		const FBlendParameter YAxisParameter = BlendSpace->GetBlendParameter(1);
-		YAxisStart = YAxisParameter.Min;
-		YAxisEnd = YAxisParameter.Max;
-		YAxisStep = FMath::Abs((YAxisEnd - YAxisStart) * MotionBlendSpace->SampleSpacing.Y);
-	}
-
-	FVector BlendSpacePosition = FVector(XAxisStart, YAxisStart, 0.0f);
+	FVector2D GridStart, GridStep;
+	const FIntPoint GridSize = GetBlendSpaceSampleGrid(MotionBlendSpace, GridStart, GridStep);
 
 	const float AnimLength = MotionBlendSpace->GetPlayLength();
 	const float PlayRate = MotionBlendSpace->GetPlayRate();
-	float CurrentTime = 0.0f;
 	
 	if (PoseInterval < 0.01f)
 	{
 		PoseInterval = 0.01f;
 	}
 
+	const float TimeStep = PoseInterval * PlayRate;
+	const int32 TimeStepCount = TimeStep > UE_SMALL_NUMBER ? FMath::FloorToInt32(AnimLength / TimeStep) + 1 : 1;
+	const int32 AtomCount = LookupPoseMatrix.AtomCount;
 	const int32 StartPoseId = Poses.Num();
 
-	for (float YAxisValue = YAxisStart; YAxisValue <= YAxisEnd; YAxisValue += YAxisStep)
+	//Sample data is looked up once per blend space position and shared by every feature and time step evaluated there
+	FMMPreProcessUtils::ResetBlendSampleCache();
+
+	auto GetBlendSpacePosition = [&](const FIntPoint& GridPoint)
 	{
-		BlendSpacePosition.Y = YAxisValue;
+		return FVector2D(GridStart.X + GridPoint.X * GridStep.X, GridStart.Y + GridPoint.Y * GridStep.Y);
+	};
 
-		for (float XAxisValue = XAxisStart; XAxisValue <= XAxisEnd; XAxisValue += XAxisStep)
+	//Evaluates the pose at every time step for a single blend space position. OutAtoms must fit TimeStepCount poses
+	auto EvaluateSamplePoint = [&](const FIntPoint& GridPoint, float* OutAtoms, const int32 MaxTimeSteps)
+	{
+		const FVector2D BlendSpacePosition = GetBlendSpacePosition(GridPoint);
+		
+		for(int32 TimeIndex = 0; TimeIndex < MaxTimeSteps; ++TimeIndex)
 		{
-			BlendSpacePosition.X = XAxisValue;
-
-			//Evaluate blend space sample data here
-			TArray<FBlendSampleData> BlendSampleData;
+			float* PoseAtoms = &OutAtoms[TimeIndex * AtomCount];
+			PoseAtoms[0] = MotionBlendSpace->CostMultiplier; //This is the pose favour, defaults to 1.0f and is set otherwise by tags
 			
-			int32 CachedTriangulationIndex = -1; //Workaround. Caching for performance during pre-processing is not necessary
-			BlendSpace->GetSamplesFromBlendInput(BlendSpacePosition, BlendSampleData, CachedTriangulationIndex, false);
-
-			CurrentTime = 0.0f;
-			while (CurrentTime <= AnimLength)
+			int32 CurrentFeatureOffset = 1; //Current Feature offset starts at 1 because we need to skip the first float used for pose favour
+			for(UMatchFeatureBase* MatchFeature : MotionMatchConfig->Features)
 			{
-				const int32 PoseId = Poses.Num();
-
-				const int32 LookupIndex = PoseId * LookupPoseMatrix.AtomCount;
-				const int32 MaxLookupIndex = LookupIndex + LookupPoseMatrix.AtomCount - 1;
-				if(MaxLookupIndex < 0 || MaxLookupIndex >= LookupPoseMatrix.PoseArray.Num())
+				if(MatchFeature)
 				{
-					break;
-				}
-				
-				LookupPoseMatrix.PoseArray[LookupIndex] = MotionBlendSpace->CostMultiplier; //This is the pose favour, defaults to 1.0f and is set otherwise by tags
-		
-				int32 CurrentFeatureOffset = 1; //Current Feature offset starts at 1 because we need to skip the first float used for pose favour
-				for(UMatchFeatureBase* MatchFeature : MotionMatchConfig->Features)
-				{
-					if(MatchFeature)
-					{
-						float* ResultLocation = &LookupPoseMatrix.PoseArray[PoseId * LookupPoseMatrix.AtomCount + CurrentFeatureOffset];
-						MatchFeature->EvaluatePreProcess(ResultLocation, MotionBlendSpace->BlendSpace, CurrentTime, PoseInterval,
-						                                 bMirror, MirrorDataTable, FVector2D(BlendSpacePosition.X, BlendSpacePosition.Y), MotionBlendSpace);
-						
-						CurrentFeatureOffset += MatchFeature->Size();
-					}
+					MatchFeature->EvaluatePreProcess(&PoseAtoms[CurrentFeatureOffset], MotionBlendSpace->BlendSpace, TimeIndex * TimeStep,
+						PoseInterval, bMirror, MirrorDataTable, BlendSpacePosition, MotionBlendSpace);
+					
+					CurrentFeatureOffset += MatchFeature->Size();
 				}
-				
-				FPoseMotionData NewPoseData = FPoseMotionData(PoseId, EMotionAnimAssetType::BlendSpace, SourceBlendSpaceIndex,
-					CurrentTime, EPoseSearchFlag::Searchable, bMirror, MotionBlendSpace->MotionTags);
-
-				NewPoseData.BlendSpacePosition = FVector2D(BlendSpacePosition.X, BlendSpacePosition.Y);
-				
-				Poses.Add(NewPoseData);
-				CurrentTime += PoseInterval * PlayRate;
 			}
 		}
-	}
+	};
 
-	//PreProcess Tags 
-	for (FAnimNotifyEvent& NotifyEvent : MotionBlendSpace->Tags)
+	//Find the grid points to sample. Uniform sampling uses every grid point while adaptive sampling subdivides the
+	//blend space only where the features cannot be interpolated from the surrounding samples.
+	TArray<FIntPoint> SamplePoints;
+	TMap<FIntPoint, TArray<float>> EvaluatedSamples;
+	
+	if(PoseSamplingMode == EPoseSamplingMode::Adaptive
+		&& AtomCount > 1
+		&& (GridSize.X > 2 || GridSize.Y > 2))
 	{
-		if (UTagSection* TagSection = Cast<UTagSection>(NotifyEvent.NotifyStateClass))
+		const int32 SampleAtomCount = TimeStepCount * AtomCount;
+		auto FindOrEvaluateSample = [&](const FIntPoint& GridPoint) -> const TArray<float>&
 		{
-			const float TagStartTime = NotifyEvent.GetTriggerTime() / PlayRate;
-			const float TagEndTime = TagStartTime + (NotifyEvent.GetDuration() / PlayRate);
-
-			//Pre-process the tag itself
-			TagSection->PreProcessTag(MotionBlendSpace, this, TagStartTime, TagStartTime + NotifyEvent.Duration);
-
-			//Find the range of poses affected by this tag
-			int32 TagStartPoseId = StartPoseId + FMath::RoundHalfToEven(TagStartTime / PoseInterval);
-			int32 TagEndPoseId = StartPoseId + FMath::RoundHalfToEven(TagEndTime / PoseInterval);
+			if(const TArray<float>* ExistingSample = EvaluatedSamples.Find(GridPoint))
+			{
+				return *ExistingSample;
+			}
 
-			TagStartPoseId = FMath::Clamp(TagStartPoseId, 0, Poses.Num() - 1);
-			TagEndPoseId = FMath::Clamp(TagEndPoseId, 0, Poses.Num() - 1);
+			TArray<float>& NewSample = EvaluatedSamples.Add(GridPoint);
+			NewSample.SetNumUninitialized(SampleAtomCount);
+			EvaluateSamplePoint(GridPoint, NewSample.GetData(), TimeStepCount);
+			return NewSample;
+		};
 
-			//Apply the tags pre-processing to all poses in this range
-			for (int32 PoseIndex = TagStartPoseId; PoseIndex < TagEndPoseId; ++PoseIndex)
+		const FIntPoint GridMax(GridSize.X - 1, GridSize.Y - 1);
+		const FIntPoint RootCorners[4] = { FIntPoint(0, 0), FIntPoint(GridMax.X, 0), FIntPoint(0, GridMax.Y), GridMax };
+		
+		//Errors are normalized by the standard deviation of each atom across the blend space corners
+		FStandardDeviationAccumulator Accumulator(AtomCount - 1);
+		for(const FIntPoint& Corner : RootCorners)
+		{
+			const TArray<float>& Sample = FindOrEvaluateSample(Corner);
+			for(int32 TimeIndex = 0; TimeIndex < TimeStepCount; ++TimeIndex)
 			{
-				TagSection->PreProcessPose(Poses[PoseIndex], MotionBlendSpace, this, TagStartTime, TagEndTime);
+				Accumulator.AddSample(&Sample[TimeIndex * AtomCount + 1]); //+1 to skip the Pose Cost Multiplier
 			}
-
-			continue; //Don't check for a tag point if we already know its a tag section
 		}
 
-		if (UTagPoint* TagPoint = Cast<UTagPoint>(NotifyEvent.Notify))
+		TArray<float> InvStandardDeviations;
+		InvStandardDeviations.SetNumZeroed(AtomCount - 1);
+		for(int32 i = 0; i < InvStandardDeviations.Num(); ++i)
 		{
-			const float TagTime = NotifyEvent.GetTriggerTime() / PlayRate;
-			int32 TagClosestPoseId = StartPoseId + FMath::RoundHalfToEven(TagTime / PoseInterval);
-			TagClosestPoseId = FMath::Clamp(TagClosestPoseId, 0, Poses.Num() - 1);
-
-			TagPoint->PreProcessTag(Poses[TagClosestPoseId], MotionBlendSpace, this, TagTime);
+			const double StandardDeviation = FMath::Sqrt(Accumulator.DistToMeanSqr[i] / FMath::Max(Accumulator.Count, 1));
+			InvStandardDeviations[i] = StandardDeviation > UE_KINDA_SMALL_NUMBER ? static_cast<float>(1.0 / StandardDeviation) : 0.0f;
 		}
-	}
-	
-#endif
-}
-
-void UMotionDataAsset::PreProcessComposite(const int32 SourceCompositeIndex, const bool bMirror /*= false*/)
-{
-#if WITH_EDITOR
-	TObjectPtr<UMotionCompositeObject> MotionComposite = SourceCompositeObjects[SourceCompositeIndex];
 
-	if(!MotionComposite)
-	{
-		return;
-	}
-	
-	const UAnimComposite* Composite = MotionComposite->AnimComposite;
+		TSet<FIntPoint> AcceptedPoints;
+		AcceptedPoints.Append(MakeArrayView(RootCorners));
 
-	if (!Composite)
-	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to pre-process composite. The animation composite is null and has been skipped. Check that all your animations are valid."));
-		return;
-	}
+		//Cells are stored as (Min, Max) grid point pairs and are refined depth first
+		TArray<TPair<FIntPoint, FIntPoint>> CellStack;
+		CellStack.Emplace(FIntPoint(0, 0), GridMax);
+		
+		while(CellStack.Num() > 0)
+		{
+			const TPair<FIntPoint, FIntPoint> Cell = CellStack.Pop(false);
+			const FIntPoint& CellMin = Cell.Key;
+			const FIntPoint& CellMax = Cell.Value;
+			const FIntPoint CellSpan = CellMax - CellMin;
 
-	Modify();
+			if(CellSpan.X < 2 && CellSpan.Y < 2)
+			{
+				continue; //There are no grid points inside this cell
+			}
 
-	MotionComposite->AnimId = SourceCompositeIndex;
+			const FIntPoint CellMid((CellMin.X + CellMax.X) / 2, (CellMin.Y + CellMax.Y) / 2);
+			const int32 XValues[3] = { CellMin.X, CellMid.X, CellMax.X };
+			const int32 YValues[3] = { CellMin.Y, CellMid.Y, CellMax.Y };
 
-	const float AnimLength = Composite->GetPlayLength();
-	const float PlayRate = MotionComposite->GetPlayRate();
-	float CurrentTime = 0.0f;
+			const float* Corner00 = FindOrEvaluateSample(CellMin).GetData();
+			const float* Corner10 = FindOrEvaluateSample(FIntPoint(CellMax.X, CellMin.Y)).GetData();
+			const float* Corner01 = FindOrEvaluateSample(FIntPoint(CellMin.X, CellMax.Y)).GetData();
+			const float* Corner11 = FindOrEvaluateSample(CellMax).GetData();
+			
+			//Test the centre and edge mid points of the cell against a bilinear interpolation of its corners
+			TArray<FIntPoint, TInlineAllocator<5>> TestPoints;
+			bool bWithinError = true;
+			for(const int32 Y : YValues)
+			{
+				for(const int32 X : XValues)
+				{
+					const FIntPoint TestPoint(X, Y);
+					if((X == CellMin.X || X == CellMax.X) && (Y == CellMin.Y || Y == CellMax.Y))
+					{
+						continue; //Corners are already sampled
+					}
+
+					TestPoints.AddUnique(TestPoint);
+
+					if(!bWithinError)
+					{
+						continue; //The cell will be subdivided anyway so there is no need to evaluate it yet
+					}
+					
+					const float AlphaX = CellSpan.X > 0 ? static_cast<float>(X - CellMin.X) / CellSpan.X : 0.0f;
+					const float AlphaY = CellSpan.Y > 0 ? static_cast<float>(Y - CellMin.Y) / CellSpan.Y : 0.0f;
+					const float* TestAtoms = FindOrEvaluateSample(TestPoint).GetData();
+					
+					for(int32 TimeIndex = 0; TimeIndex < TimeStepCount && bWithinError; ++TimeIndex)
+					{
+						for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
+						{
+							const int32 Index = TimeIndex * AtomCount + AtomIndex;
+							const float Interpolated = FMath::BiLerp(Corner00[Index], Corner10[Index],
+								Corner01[Index], Corner11[Index], AlphaX, AlphaY);
+							
+							if(FMath::Abs(Interpolated - TestAtoms[Index]) * InvStandardDeviations[AtomIndex - 1] > AdaptiveSamplingMaxError)
+							{
+								bWithinError = false;
+								break;
+							}
+						}
+					}
+				}
+			}
+
+			if(bWithinError)
+			{
+				continue;
+			}
+			
+			AcceptedPoints.Append(TestPoints);
+
+			//Split the cell along each axis that still has grid points inside it
+			const int32 XSplitCount = CellSpan.X > 1 ? 2 : 1;
+			const int32 YSplitCount = CellSpan.Y > 1 ? 2 : 1;
+			for(int32 YSplit = 0; YSplit < YSplitCount; ++YSplit)
+			{
+				for(int32 XSplit = 0; XSplit < XSplitCount; ++XSplit)
+				{
+					const FIntPoint ChildMin(XSplitCount == 1 ? CellMin.X : XValues[XSplit], YSplitCount == 1 ? CellMin.Y : YValues[YSplit]);
+					const FIntPoint ChildMax(XSplitCount == 1 ? CellMax.X : XValues[XSplit + 1], YSplitCount == 1 ? CellMax.Y : YValues[YSplit + 1]);
+					CellStack.Emplace(ChildMin, ChildMax);
+				}
+			}
+		}
+
+		SamplePoints = AcceptedPoints.Array();
+		SamplePoints.Sort([](const FIntPoint& A, const FIntPoint& B)
+		{
+			return A.Y == B.Y ? A.X < B.X : A.Y < B.Y;
+		});
+
+		UE_LOG(LogTemp, Log, TEXT("Motion Data '%s': adaptive sampling used %d of %d sample points for blend space '%s'."),
+			*GetName(), SamplePoints.Num(), GridSize.X * GridSize.Y, *BlendSpace->GetName());
+	}
+	else
+	{
+		SamplePoints.Reserve(GridSize.X * GridSize.Y);
+		for(int32 Y = 0; Y < GridSize.Y; ++Y)
+		{
+			for(int32 X = 0; X < GridSize.X; ++X)
+			{
+				SamplePoints.Emplace(X, Y);
+			}
+		}
+	}
+
+	//Add the poses for each sample point to the pose database
+	for(const FIntPoint& SamplePoint : SamplePoints)
+	{
+		const int32 LookupIndex = Poses.Num() * AtomCount;
+		const int32 MaxTimeSteps = FMath::Min(TimeStepCount, (LookupPoseMatrix.PoseArray.Num() - LookupIndex) / FMath::Max(1, AtomCount));
+		if(MaxTimeSteps <= 0)
+		{
+			break;
+		}
+
+		if(const TArray<float>* EvaluatedSample = EvaluatedSamples.Find(SamplePoint))
+		{
+			FMemory::Memcpy(&LookupPoseMatrix.PoseArray[LookupIndex], EvaluatedSample->GetData(), MaxTimeSteps * AtomCount * sizeof(float));
+		}
+		else
+		{
+			EvaluateSamplePoint(SamplePoint, &LookupPoseMatrix.PoseArray[LookupIndex], MaxTimeSteps);
+		}
+
+		const FVector2D BlendSpacePosition = GetBlendSpacePosition(SamplePoint);
+		for(int32 TimeIndex = 0; TimeIndex < MaxTimeSteps; ++TimeIndex)
+		{
+			FPoseMotionData NewPoseData = FPoseMotionData(Poses.Num(), EMotionAnimAssetType::BlendSpace, SourceBlendSpaceIndex,
+				TimeIndex * TimeStep, EPoseSearchFlag::Searchable, bMirror, MotionBlendSpace->MotionTags);
+
+			NewPoseData.BlendSpacePosition = BlendSpacePosition;
+			
+			Poses.Add(NewPoseData);
+		}
+	}
+
+	//PreProcess Tags 
+	for (FAnimNotifyEvent& NotifyEvent : MotionBlendSpace->Tags)
+	{
+		if (UTagSection* TagSection = Cast<UTagSection>(NotifyEvent.NotifyStateClass))
+		{
+			const float TagStartTime = NotifyEvent.GetTriggerTime() / PlayRate;
+			const float TagEndTime = TagStartTime + (NotifyEvent.GetDuration() / PlayRate);
+
+			//Pre-process the tag itself
+			TagSection->PreProcessTag(MotionBlendSpace, this, TagStartTime, TagStartTime + NotifyEvent.Duration);
+
+			//Find the range of poses affected by this tag
+			int32 TagStartPoseId = StartPoseId + FMath::RoundHalfToEven(TagStartTime / PoseInterval);
+			int32 TagEndPoseId = StartPoseId + FMath::RoundHalfToEven(TagEndTime / PoseInterval);
+
+			TagStartPoseId = FMath::Clamp(TagStartPoseId, 0, Poses.Num() - 1);
+			TagEndPoseId = FMath::Clamp(TagEndPoseId, 0, Poses.Num() - 1);
+
+			//Apply the tags pre-processing to all poses in this range
+			for (int32 PoseIndex = TagStartPoseId; PoseIndex < TagEndPoseId; ++PoseIndex)
+			{
+				TagSection->PreProcessPose(Poses[PoseIndex], MotionBlendSpace, this, TagStartTime, TagEndTime);
+			}
+
+			continue; //Don't check for a tag point if we already know its a tag section
+		}
+
+		if (UTagPoint* TagPoint = Cast<UTagPoint>(NotifyEvent.Notify))
+		{
+			const float TagTime = NotifyEvent.GetTriggerTime() / PlayRate;
+			int32 TagClosestPoseId = StartPoseId + FMath::RoundHalfToEven(TagTime / PoseInterval);
+			TagClosestPoseId = FMath::Clamp(TagClosestPoseId, 0, Poses.Num() - 1);
+
+			TagPoint->PreProcessTag(Poses[TagClosestPoseId], MotionBlendSpace, this, TagTime);
+		}
+	}
+
+	FMMPreProcessUtils::ResetBlendSampleCache();
+#endif
+}
+
+FIntPoint UMotionDataAsset::GetBlendSpaceSampleGrid(const UMotionBlendSpaceObject* InMotionBlendSpace, FVector2D& OutStart, FVector2D& OutStep)
+{
+	OutStart = FVector2D::ZeroVector;
+	OutStep = FVector2D::ZeroVector;
+	
+	if(!InMotionBlendSpace
+		|| !InMotionBlendSpace->BlendSpace)
+	{
+		return FIntPoint::ZeroValue;
+	}
+
+	FIntPoint GridSize(1, 1);
+	for(int32 Axis = 0; Axis < 2; ++Axis)
+	{
+		const FBlendParameter& AxisParameter = InMotionBlendSpace->BlendSpace->GetBlendParameter(Axis);
+		const float AxisRange = AxisParameter.Max - AxisParameter.Min;
+		const float AxisStep = FMath::Abs(AxisRange * InMotionBlendSpace->SampleSpacing[Axis]);
+
+		OutStart[Axis] = AxisParameter.Min;
+		OutStep[Axis] = AxisStep;
+
+		if(AxisStep > UE_KINDA_SMALL_NUMBER)
+		{
+			GridSize[Axis] = FMath::FloorToInt32(AxisRange / AxisStep + UE_KINDA_SMALL_NUMBER) + 1;
+		}
+	}
+
+	return GridSize;
+}
+
+void UMotionDataAsset::PreProcessComposite(const int32 SourceCompositeIndex, const bool bMirror /*= false*/)
+{
+#if WITH_EDITOR
+	TObjectPtr<UMotionCompositeObject> MotionComposite = SourceCompositeObjects[SourceCompositeIndex];
+
+	if(!MotionComposite)
+	{
+		return;
+	}
+	
+	const UAnimComposite* Composite = MotionComposite->AnimComposite;
+
+	if (!Composite)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to pre-process composite. The animation composite is null and has been skipped. Check that all your animations are valid."));
+		return;
+	}
+
+	Modify();
+
+	MotionComposite->AnimId = SourceCompositeIndex;
+
+	const float AnimLength = Composite->GetPlayLength();
+	const float PlayRate = MotionComposite->GetPlayRate();
+	float CurrentTime = 0.0f;
 	const float TimeHorizon = 1.0f * PlayRate;
 
 	if (PoseInterval < 0.01f)
@@ -1712,6 +2211,360 @@ void UMotionDataAsset::PreProcessComposite(const int32 SourceCompositeIndex, con
 #endif
 }
 
+void UMotionDataAsset::ApplyAdaptiveSampling()
+{
+	bVariablePoseSpacing = false;
+
+	const int32 AtomCount = LookupPoseMatrix.AtomCount;
+	const int32 PoseCount = FMath::Min(Poses.Num(), LookupPoseMatrix.PoseArray.Num() / FMath::Max(1, AtomCount));
+	if(PoseSamplingMode != EPoseSamplingMode::Adaptive
+		|| PoseCount < 3
+		|| AtomCount < 2)
+	{
+		return;
+	}
+
+	TArray<float>& PoseArray = LookupPoseMatrix.PoseArray;
+
+	//Errors are normalized by the standard deviation of each atom so that a single threshold works across features
+	TArray<float> InvStandardDeviations;
+	CalculateAtomInvStandardDeviations(InvStandardDeviations);
+
+	//Returns true if all poses between the two key poses can be reconstructed by interpolating the key poses
+	auto CanInterpolateBetween = [&](const int32 KeyPoseA, const int32 KeyPoseB)
+	{
+		const FPoseMotionData& PoseA = Poses[KeyPoseA];
+		const FPoseMotionData& PoseB = Poses[KeyPoseB];
+		const float TimeSpan = PoseB.Time - PoseA.Time;
+		
+		if(!IsSamePoseSequence(PoseA, PoseB) || TimeSpan < UE_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const float* AtomsA = &PoseArray[KeyPoseA * AtomCount];
+		const float* AtomsB = &PoseArray[KeyPoseB * AtomCount];
+		for(int32 PoseId = KeyPoseA + 1; PoseId < KeyPoseB; ++PoseId)
+		{
+			const FPoseMotionData& Pose = Poses[PoseId];
+			const float* Atoms = &PoseArray[PoseId * AtomCount];
+
+			//Never drop poses that carry different tag or search data than the pose that will be used in their place
+			if(Pose.SearchFlag != PoseA.SearchFlag
+				|| Pose.MotionTags != PoseA.MotionTags
+				|| !FMath::IsNearlyEqual(Atoms[0], AtomsA[0]))
+			{
+				return false;
+			}
+			
+			const float Alpha = (Pose.Time - PoseA.Time) / TimeSpan;
+			for(int32 AtomIndex = 1; AtomIndex < AtomCount; ++AtomIndex)
+			{
+				const float Interpolated = FMath::Lerp(AtomsA[AtomIndex], AtomsB[AtomIndex], Alpha);
+				if(FMath::Abs(Interpolated - Atoms[AtomIndex]) * InvStandardDeviations[AtomIndex - 1] > AdaptiveSamplingMaxError)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	};
+
+	//Greedily extend each key pose as far as the error and stride allow
+	TArray<int32> KeyPoseIds;
+	KeyPoseIds.Reserve(PoseCount);
+	KeyPoseIds.Add(0);
+	
+	const int32 MaxStride = FMath::Max(1, AdaptiveSamplingMaxStride);
+	int32 KeyPoseId = 0;
+	while(KeyPoseId < PoseCount - 1)
+	{
+		int32 NextKeyPoseId = KeyPoseId + 1;
+		while(NextKeyPoseId + 1 < PoseCount
+			&& NextKeyPoseId + 1 - KeyPoseId <= MaxStride
+			&& CanInterpolateBetween(KeyPoseId, NextKeyPoseId + 1))
+		{
+			++NextKeyPoseId;
+		}
+
+		KeyPoseIds.Add(NextKeyPoseId);
+		KeyPoseId = NextKeyPoseId;
+	}
+
+	if(KeyPoseIds.Num() == PoseCount)
+	{
+		return;
+	}
+
+	//Compact the poses and the pose matrix in place. Key poses are in ascending order so rows only ever move backwards
+	for(int32 NewPoseId = 0; NewPoseId < KeyPoseIds.Num(); ++NewPoseId)
+	{
+		const int32 OldPoseId = KeyPoseIds[NewPoseId];
+		if(OldPoseId != NewPoseId)
+		{
+			Poses[NewPoseId] = Poses[OldPoseId];
+			FMemory::Memcpy(&PoseArray[NewPoseId * AtomCount], &PoseArray[OldPoseId * AtomCount], AtomCount * sizeof(float));
+		}
+
+		Poses[NewPoseId].PoseId = NewPoseId;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Motion Data '%s': adaptive sampling reduced the pose database from %d to %d poses."),
+		*GetName(), PoseCount, KeyPoseIds.Num());
+
+	Poses.SetNum(KeyPoseIds.Num());
+	LookupPoseMatrix.PoseCount = KeyPoseIds.Num();
+	PoseArray.SetNum(KeyPoseIds.Num() * AtomCount);
+	bVariablePoseSpacing = true;
+}
+
+void UMotionDataAsset::PruneRedundantPoses()
+{
+	const int32 AtomCount = LookupPoseMatrix.AtomCount;
+	const int32 FeatureAtomCount = AtomCount - 1; //The first atom is the pose cost multiplier
+	const int32 PoseCount = FMath::Min(Poses.Num(), LookupPoseMatrix.PoseArray.Num() / FMath::Max(1, AtomCount));
+
+	RedundantPoseThresholdUsed = RedundantPoseThreshold;
+	UnprunedSearchPoseCount = 0;
+	RedundantPoseCount = 0;
+
+	//Group searchable poses by motion tags since poses can only be redundant within the same search section. Poses
+	//that can be mirrored at runtime are also grouped separately from those that can't, otherwise pruning a mirrorable
+	//pose in favour of a non-mirrorable one would silently remove its mirrored search candidate.
+	const bool bRuntimeMirroring = UsesRuntimeMirroring();
+	TArray<TPair<FGameplayTagContainer, bool>> TagSets;
+	TArray<TArray<int32>> TagSetPoseIds;
+	for(int32 PoseId = 0; PoseId < PoseCount; ++PoseId)
+	{
+		const FPoseMotionData& Pose = Poses[PoseId];
+		if(Pose.SearchFlag != EPoseSearchFlag::Searchable)
+		{
+			continue;
+		}
+
+		const TPair<FGameplayTagContainer, bool> TagSet(Pose.MotionTags,
+			bRuntimeMirroring && IsMirroringEnabled(Pose.AnimType, Pose.AnimId));
+		
+		int32 TagSetIndex = TagSets.IndexOfByKey(TagSet);
+		if(TagSetIndex == INDEX_NONE)
+		{
+			TagSetIndex = TagSets.Add(TagSet);
+			TagSetPoseIds.AddDefaulted();
+		}
+		
+		TagSetPoseIds[TagSetIndex].Add(PoseId);
+		++UnprunedSearchPoseCount;
+	}
+	
+	if(RedundantPoseThreshold < UE_SMALL_NUMBER
+		|| FeatureAtomCount < 1
+		|| UnprunedSearchPoseCount < 2)
+	{
+		return;
+	}
+	
+	TArray<float> InvStandardDeviations;
+	CalculateAtomInvStandardDeviations(InvStandardDeviations);
+
+	//Distances are the RMS of the per atom normalized differences so that the threshold does not depend on the atom count
+	const float MaxDistanceSqrSum = RedundantPoseThreshold * RedundantPoseThreshold * FeatureAtomCount;
+	const TArray<float>& PoseArray = LookupPoseMatrix.PoseArray;
+
+	TArray<float> NormalizedPoses;
+	TArray<float> SortKeys;
+	TArray<int32> SortedPoseIds;
+	TArray<int32> KeptPoseIds;
+	for(const TArray<int32>& PoseIds : TagSetPoseIds)
+	{
+		const int32 SetPoseCount = PoseIds.Num();
+		NormalizedPoses.SetNumUninitialized(SetPoseCount * FeatureAtomCount, false);
+		SortKeys.SetNumUninitialized(SetPoseCount, false);
+		
+		for(int32 SetIndex = 0; SetIndex < SetPoseCount; ++SetIndex)
+		{
+			const float* Atoms = &PoseArray[PoseIds[SetIndex] * AtomCount + 1];
+			float* NormalizedAtoms = &NormalizedPoses[SetIndex * FeatureAtomCount];
+			
+			float KeySum = 0.0f;
+			for(int32 AtomIndex = 0; AtomIndex < FeatureAtomCount; ++AtomIndex)
+			{
+				NormalizedAtoms[AtomIndex] = Atoms[AtomIndex] * InvStandardDeviations[AtomIndex];
+				KeySum += NormalizedAtoms[AtomIndex];
+			}
+
+			//The mean of the normalized atoms never differs between two poses by more than their RMS distance so it
+			//can be used to bound the search to a sliding window
+			SortKeys[SetIndex] = KeySum / FeatureAtomCount;
+		}
+
+		SortedPoseIds.Reset();
+		for(int32 SetIndex = 0; SetIndex < SetPoseCount; ++SetIndex)
+		{
+			SortedPoseIds.Add(SetIndex);
+		}
+		
+		SortedPoseIds.Sort([&SortKeys](const int32 A, const int32 B)
+		{
+			return SortKeys[A] < SortKeys[B] || (SortKeys[A] == SortKeys[B] && A < B);
+		});
+
+		//Greedy leader clustering. Each pose is either kept searchable or is redundant with a previously kept pose
+		KeptPoseIds.Reset();
+		int32 WindowStart = 0;
+		for(const int32 SetIndex : SortedPoseIds)
+		{
+			const float Key = SortKeys[SetIndex];
+			while(WindowStart < KeptPoseIds.Num() && SortKeys[KeptPoseIds[WindowStart]] < Key - RedundantPoseThreshold)
+			{
+				++WindowStart;
+			}
+
+			const float* NormalizedAtoms = &NormalizedPoses[SetIndex * FeatureAtomCount];
+			const float CostMultiplier = PoseArray[PoseIds[SetIndex] * AtomCount];
+			
+			bool bRedundant = false;
+			for(int32 KeptIndex = WindowStart; KeptIndex < KeptPoseIds.Num() && !bRedundant; ++KeptIndex)
+			{
+				const int32 KeptSetIndex = KeptPoseIds[KeptIndex];
+				if(!FMath::IsNearlyEqual(CostMultiplier, PoseArray[PoseIds[KeptSetIndex] * AtomCount]))
+				{
+					continue;
+				}
+				
+				const float* KeptAtoms = &NormalizedPoses[KeptSetIndex * FeatureAtomCount];
+				float DistanceSqrSum = 0.0f;
+				for(int32 AtomIndex = 0; AtomIndex < FeatureAtomCount && DistanceSqrSum <= MaxDistanceSqrSum; ++AtomIndex)
+				{
+					DistanceSqrSum += FMath::Square(NormalizedAtoms[AtomIndex] - KeptAtoms[AtomIndex]);
+				}
+
+				bRedundant = DistanceSqrSum <= MaxDistanceSqrSum;
+			}
+
+			if(bRedundant)
+			{
+				Poses[PoseIds[SetIndex]].SearchFlag = EPoseSearchFlag::NextNatural;
+				++RedundantPoseCount;
+			}
+			else
+			{
+				KeptPoseIds.Add(SetIndex);
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Motion Data '%s': pruned %d of %d searchable poses as redundant (threshold %f). Search cost reduced by %.1f%%."),
+		*GetName(), RedundantPoseCount, UnprunedSearchPoseCount, RedundantPoseThresholdUsed, GetSearchCostReduction() * 100.0f);
+}
+
+void UMotionDataAsset::CalculateAtomInvStandardDeviations(TArray<float>& OutInvStandardDeviations) const
+{
+	const int32 AtomCount = LookupPoseMatrix.AtomCount;
+	const int32 FeatureAtomCount = FMath::Max(0, AtomCount - 1); //The first atom is the pose cost multiplier
+	const int32 PoseCount = FMath::Min(Poses.Num(), LookupPoseMatrix.PoseArray.Num() / FMath::Max(1, AtomCount));
+	
+	FStandardDeviationAccumulator Accumulator(FeatureAtomCount);
+	for(int32 PoseId = 0; PoseId < PoseCount; ++PoseId)
+	{
+		Accumulator.AddSample(&LookupPoseMatrix.PoseArray[PoseId * AtomCount + 1]);
+	}
+
+	OutInvStandardDeviations.SetNumUninitialized(FeatureAtomCount);
+	for(int32 AtomIndex = 0; AtomIndex < FeatureAtomCount; ++AtomIndex)
+	{
+		const double Variance = Accumulator.DistToMeanSqr[AtomIndex] / FMath::Max(1, Accumulator.Count);
+		OutInvStandardDeviations[AtomIndex] = Variance > UE_SMALL_NUMBER ? static_cast<float>(1.0 / FMath::Sqrt(Variance)) : 0.0f;
+	}
+}
+
+bool UMotionDataAsset::GenerateMirrorAtomMap()
+{
+	MirrorAtomSourceIndices.Empty();
+	MirrorAtomSigns.Empty();
+
+	if(!bMirrorAtRuntime
+		|| !MirrorDataTable
+		|| !MotionMatchConfig)
+	{
+		return false;
+	}
+
+	const USkeleton* Skeleton = MotionMatchConfig->GetSourceSkeleton();
+	const TArray<TObjectPtr<UMatchFeatureBase>>& Features = MotionMatchConfig->Features;
+
+	//Find the atom offset of each feature. Note: The first atom is the pose cost multiplier
+	TArray<int32> FeatureOffsets;
+	FeatureOffsets.SetNumZeroed(Features.Num());
+	int32 AtomCount = 1;
+	for(int32 FeatureIndex = 0; FeatureIndex < Features.Num(); ++FeatureIndex)
+	{
+		FeatureOffsets[FeatureIndex] = AtomCount;
+		AtomCount += Features[FeatureIndex] ? Features[FeatureIndex]->Size() : 0;
+	}
+
+	MirrorAtomSourceIndices.SetNumZeroed(AtomCount);
+	MirrorAtomSigns.Init(1.0f, AtomCount);
+
+	for(int32 FeatureIndex = 0; FeatureIndex < Features.Num(); ++FeatureIndex)
+	{
+		const UMatchFeatureBase* Feature = Features[FeatureIndex];
+		if(!Feature)
+		{
+			continue;
+		}
+
+		const FName BoneName = Feature->GetFeatureBoneName();
+		const FName MirrorBoneName = BoneName.IsNone() ? BoneName
+			: FMMPreProcessUtils::FindMirrorBoneName(Skeleton, MirrorDataTable, BoneName);
+
+		//Features without a bone or on a bone that mirrors to itself are their own counterpart
+		int32 CounterpartIndex = Feature->IsMirrorCounterpart(Feature, MirrorBoneName) ? FeatureIndex : INDEX_NONE;
+		for(int32 OtherIndex = 0; OtherIndex < Features.Num() && CounterpartIndex == INDEX_NONE; ++OtherIndex)
+		{
+			if(Feature->IsMirrorCounterpart(Features[OtherIndex], MirrorBoneName))
+			{
+				CounterpartIndex = OtherIndex;
+			}
+		}
+
+		if(CounterpartIndex == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Motion Data Asset: Runtime mirroring could not be used because the match feature on bone '%s' has no counterpart feature on the mirror bone '%s'. Mirrored poses will be baked into the pose database instead."),
+				*BoneName.ToString(), *MirrorBoneName.ToString());
+			
+			MirrorAtomSourceIndices.Empty();
+			MirrorAtomSigns.Empty();
+			return false;
+		}
+
+		const int32 FeatureOffset = FeatureOffsets[FeatureIndex];
+		const int32 CounterpartOffset = FeatureOffsets[CounterpartIndex];
+		for(int32 i = 0; i < Feature->Size(); ++i)
+		{
+			MirrorAtomSourceIndices[FeatureOffset + i] = CounterpartOffset + i;
+		}
+		
+		Feature->GetMirrorAtomSigns(&MirrorAtomSigns[FeatureOffset]);
+	}
+
+	return true;
+}
+
+bool UMotionDataAsset::IsMirroringEnabled(const EMotionAnimAssetType AnimType, const int32 AnimId) const
+{
+	const UMotionAnimObject* MotionAnim = nullptr;
+	switch(AnimType)
+	{
+		case EMotionAnimAssetType::Sequence: MotionAnim = SourceMotionSequenceObjects.IsValidIndex(AnimId) ? SourceMotionSequenceObjects[AnimId] : nullptr; break;
+		case EMotionAnimAssetType::BlendSpace: MotionAnim = SourceBlendSpaceObjects.IsValidIndex(AnimId) ? SourceBlendSpaceObjects[AnimId] : nullptr; break;
+		case EMotionAnimAssetType::Composite: MotionAnim = SourceCompositeObjects.IsValidIndex(AnimId) ? SourceCompositeObjects[AnimId] : nullptr; break;
+		default: break;
+	}
+
+	return MotionAnim && MotionAnim->bEnableMirroring;
+}
+
 void UMotionDataAsset::GeneratePoseSequencing()
 {
 	for (int32 i = 0; i < Poses.Num(); ++i)
@@ -1787,44 +2640,140 @@ void UMotionDataAsset::GeneratePoseSequencing()
 				Pose.NextPoseId = Pose.PoseId;
 			}
 		}
+	}
+
+	if(Poses.Num() == 0)
+	{
+		return;
+	}
 
-		//If the Pose at the beginning of the database is looping, we need to fix its before Pose reference
-		FPoseMotionData& StartPose = Poses[0];
-		const UMotionAnimObject* StartMotionAnim = GetEditableSourceAnim(StartPose.AnimId, StartPose.AnimType);
+	//If the Pose at the beginning of the database is looping, we need to fix its before Pose reference
+	FPoseMotionData& StartPose = Poses[0];
+	const UMotionAnimObject* StartMotionAnim = GetEditableSourceAnim(StartPose.AnimId, StartPose.AnimType);
 
-		if (StartMotionAnim->bLoop)
+	if (StartMotionAnim->bLoop)
+	{
+		//Poses may not be evenly spaced (adaptive sampling) so find the end of the sequence rather than computing it
+		int32 EndOfSequenceId = StartPose.PoseId;
+		while(EndOfSequenceId + 1 < Poses.Num() && IsSamePoseSequence(StartPose, Poses[EndOfSequenceId + 1]))
 		{
-			const int32 PosesToEnd = FMath::FloorToInt((StartMotionAnim->GetPlayLength() - StartPose.Time) / PoseInterval);
-			StartPose.LastPoseId = StartPose.PoseId + PosesToEnd;
+			++EndOfSequenceId;
 		}
+		
+		StartPose.LastPoseId = EndOfSequenceId;
+	}
 
-		//If the Pose at the end of the database is looping, we need to fix its after Pose reference
-		FPoseMotionData& EndPose = Poses.Last();
-		const UMotionAnimObject* EndMotionAnim = GetEditableSourceAnim(EndPose.AnimId, EndPose.AnimType);
+	//If the Pose at the end of the database is looping, we need to fix its after Pose reference
+	FPoseMotionData& EndPose = Poses.Last();
+	const UMotionAnimObject* EndMotionAnim = GetEditableSourceAnim(EndPose.AnimId, EndPose.AnimType);
 
-		if (EndMotionAnim->bLoop)
+	if (EndMotionAnim->bLoop)
+	{
+		int32 StartOfSequenceId = EndPose.PoseId;
+		while(StartOfSequenceId > 0 && IsSamePoseSequence(EndPose, Poses[StartOfSequenceId - 1]))
 		{
-			const int32 PosesToBeginning = FMath::FloorToInt(EndPose.Time / PoseInterval);
-			EndPose.NextPoseId = EndPose.PoseId - PosesToBeginning;
+			--StartOfSequenceId;
 		}
+		
+		EndPose.NextPoseId = StartOfSequenceId;
+	}
+}
+
+void UMotionDataAsset::BakeRootMotionTable()
+{
+	PoseRootMotionTable.Empty(Poses.Num());
+	for(const FPoseMotionData& Pose : Poses)
+	{
+		const UMotionAnimObject* MotionAnim = GetSourceAnim(Pose.AnimId, Pose.AnimType);
+		if(!MotionAnim)
+		{
+			PoseRootMotionTable.Emplace();
+			continue;
+		}
+
+		//Each pose covers the time until the next pose of its sequence or the end of the animation for the last pose
+		float IntervalEndTime = MotionAnim->GetPlayLength();
+		if(Pose.NextPoseId > Pose.PoseId
+			&& Poses.IsValidIndex(Pose.NextPoseId))
+		{
+			IntervalEndTime = Poses[Pose.NextPoseId].Time;
+		}
+
+		const float Duration = FMath::Max(IntervalEndTime - Pose.Time, 0.0f);
+		FRootMotionMovementParams RootMotionParams;
+		
+		if(Duration > UE_KINDA_SMALL_NUMBER)
+		{
+			switch(Pose.AnimType)
+			{
+				case EMotionAnimAssetType::Sequence:
+				{
+					const UAnimSequence* Sequence = Cast<UMotionSequenceObject>(MotionAnim)->Sequence;
+					if(Sequence && Sequence->bEnableRootMotion)
+					{
+						RootMotionParams.Accumulate(Sequence->ExtractRootMotion(Pose.Time, Duration, false));
+					}
+				} break;
+				case EMotionAnimAssetType::BlendSpace:
+				{
+					const UBlendSpace* BlendSpace = Cast<UMotionBlendSpaceObject>(MotionAnim)->BlendSpace;
+					if(!BlendSpace)
+					{
+						break;
+					}
+
+					//Matches the runtime extraction which samples every blend sample at the same time
+					for(const FBlendSampleData& BlendSample : FMMPreProcessUtils::FindBlendSamples(BlendSpace, Pose.BlendSpacePosition))
+					{
+						const UAnimSequence* SampleSequence = BlendSample.Animation;
+						const float SampleWeight = BlendSample.GetClampedWeight();
+						if(SampleSequence
+							&& SampleSequence->bEnableRootMotion
+							&& SampleWeight > ZERO_ANIMWEIGHT_THRESH)
+						{
+							RootMotionParams.AccumulateWithBlend(SampleSequence->ExtractRootMotion(Pose.Time, Duration, false), SampleWeight);
+						}
+					}
+				} break;
+				case EMotionAnimAssetType::Composite:
+				{
+					const UAnimComposite* Composite = Cast<UMotionCompositeObject>(MotionAnim)->AnimComposite;
+					if(Composite)
+					{
+						Composite->ExtractRootMotionFromTrack(Composite->AnimationTrack, Pose.Time, Pose.Time + Duration, RootMotionParams);
+					}
+				} break;
+				default: break;
+			}
+		}
+
+		PoseRootMotionTable.Emplace(RootMotionParams.GetRootMotionTransform(), Duration);
 	}
 }
 
 void UMotionDataAsset::MarkEdgePoses(float InMaxAnimBlendTime)
 {
 	const int32 EdgePoseCount = FMath::CeilToInt32(InMaxAnimBlendTime / GetPoseInterval());
+	const float EdgeTime = EdgePoseCount * GetPoseInterval() + UE_KINDA_SMALL_NUMBER;
 	
 	for(int32 i = 0; i < Poses.Num(); ++i)
 	{
 		if(Poses[i].SearchFlag == EPoseSearchFlag::DoNotUse)
 		{
 			//Look back a certain number of poses and mark them as edge poses
-			for(int32 n = 1; n <= EdgePoseCount; ++n)
+			for(int32 n = 1; bVariablePoseSpacing || n <= EdgePoseCount; ++n)
 			{
 				const int32 PoseIndex = i - n;
 				if(PoseIndex < 0)
 				{
-					continue;
+					break;
+				}
+
+				//With variable pose spacing the edge is measured in time instead of pose count
+				if(bVariablePoseSpacing && (!IsSamePoseSequence(Poses[i], Poses[PoseIndex])
+					|| Poses[i].Time - Poses[PoseIndex].Time > EdgeTime))
+				{
+					break;
 				}
 
 				FPoseMotionData& Pose = Poses[PoseIndex];
@@ -1855,6 +2804,9 @@ void UMotionDataAsset::GenerateSearchPoseMatrix()
 	SearchPoseMatrix.AtomCount = LookupPoseMatrix.AtomCount;
 	SearchPoseMatrix.PoseCount = ValidPoseCount;
 	SearchPoseMatrix.PoseArray.SetNumZeroed(ValidPoseCount * LookupPoseMatrix.AtomCount);
+	SearchPoseMirrorMask.Init(false, ValidPoseCount);
+	const bool bRuntimeMirroring = UsesRuntimeMirroring();
+	
 	//Add valid pose Id remaps to the remap array and add poses to the search pose matrix
 	int32 ValidPoseId = 0;
 
@@ -1896,6 +2848,11 @@ void UMotionDataAsset::GenerateSearchPoseMatrix()
 			PoseIdRemap[ValidPoseId] = i;
 			PoseIdRemapReverse.Add(i, ValidPoseId);
 
+			if(bRuntimeMirroring)
+			{
+				SearchPoseMirrorMask[ValidPoseId] = IsMirroringEnabled(Pose.AnimType, Pose.AnimId);
+			}
+
 			++ValidPoseId;
 		}
 
@@ -1904,9 +2861,73 @@ void UMotionDataAsset::GenerateSearchPoseMatrix()
 
 	SearchPoseMatrix.PoseCount = ValidPoseId;
 
+	//Bake the compact runtime pose table
+	RuntimePoses.Empty(Poses.Num());
+	for(const FPoseMotionData& Pose : Poses)
+	{
+		RuntimePoses.Emplace(Pose, MotionTagList.IndexOfByKey(Pose.MotionTags));
+	}
+
+	//Count the usable poses ahead of each pose, back to front, so that forced searches are a single look-up at runtime
+	for(int32 i = RuntimePoses.Num() - 1; i >= 0; --i)
+	{
+		FRuntimePoseData& RuntimePose = RuntimePoses[i];
+		if(RuntimePose.SearchFlag == EPoseSearchFlag::DoNotUse)
+		{
+			RuntimePose.UsablePoseCount = 0;
+			continue;
+		}
+
+		//The run of usable poses stops at mirrored copies and other blend space sample positions of the same animation
+		RuntimePose.UsablePoseCount = 1;
+		RuntimePose.UsableEndTime = RuntimePose.Time;
+		if(i + 1 < RuntimePoses.Num()
+			&& IsSamePoseSequence(Poses[i], Poses[i + 1]))
+		{
+			const FRuntimePoseData& NextRuntimePose = RuntimePoses[i + 1];
+			if(NextRuntimePose.UsablePoseCount > 0)
+			{
+				RuntimePose.UsablePoseCount += NextRuntimePose.UsablePoseCount;
+				RuntimePose.UsableEndTime = NextRuntimePose.UsableEndTime;
+			}
+		}
+	}
+
 	//Create AABB data structures
 	PoseAABBMatrix_Outer = FPoseAABBMatrix(SearchPoseMatrix, 64);
 	PoseAABBMatrix_Inner = FPoseAABBMatrix(SearchPoseMatrix, 16);
+
+	GenerateAnimNotifyIndices();
+}
+
+void UMotionDataAsset::GenerateAnimNotifyIndices()
+{
+	AnimNotifyIndices.Empty();
+
+	for(const TObjectPtr<UMotionSequenceObject> MotionAnim : SourceMotionSequenceObjects)
+	{
+		if(MotionAnim && MotionAnim->Sequence)
+		{
+			AnimNotifyIndices.Add(MotionAnim->Sequence, FAnimNotifyIndex(MotionAnim->Sequence));
+		}
+	}
+
+	for(const TObjectPtr<UMotionBlendSpaceObject> MotionBlendSpace : SourceBlendSpaceObjects)
+	{
+		if(!MotionBlendSpace || !MotionBlendSpace->BlendSpace)
+		{
+			continue;
+		}
+
+		for(const FBlendSample& BlendSample : MotionBlendSpace->BlendSpace->GetBlendSamples())
+		{
+			const UAnimSequenceBase* SampleAnim = BlendSample.Animation;
+			if(SampleAnim && !AnimNotifyIndices.Contains(SampleAnim))
+			{
+				AnimNotifyIndices.Add(SampleAnim, FAnimNotifyIndex(SampleAnim));
+			}
+		}
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -59,7 +59,36 @@ void UMatchFeatureBase::ExtractRuntime(FCSPose<FCompactPose>& CSPose, float* Res
 {
 }
 
+bool UMatchFeatureBase::UsesRuntimePose() const
+{
+	return true;
+}
+
+bool UMatchFeatureBase::HasRuntimeHistory() const
+{
+	return false;
+}
+
+bool UMatchFeatureBase::RuntimeHistoryNeedsPose() const
+{
+	return false;
+}
+
+void UMatchFeatureBase::UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy)
+{
+}
+
 void UMatchFeatureBase::SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, AActor* InActor)
+{
+	SourceResolvedInputData(OutFeatureArray, FeatureOffset, InActor ? ResolveInputSource(InActor) : nullptr);
+}
+
+UObject* UMatchFeatureBase::ResolveInputSource(AActor* InActor) const
+{
+	return nullptr;
+}
+
+void UMatchFeatureBase::SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, UObject* InInputSource)
 {
 	const int32 MaxIterations = FMath::Min(Size(), OutFeatureArray.Num() - FeatureOffset);
 	for(int32 i = 0; i < MaxIterations; ++i)
@@ -84,13 +113,53 @@ float UMatchFeatureBase::GetDefaultWeight(int32 AtomId) const
 	return DefaultWeight;
 }
 
-void UMatchFeatureBase::CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-	const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const
+void UMatchFeatureBase::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
+{
+}
+
+void UMatchFeatureBase::ReduceAtomGroup(TArray<float>& InOutDistToMeanSqrArray, const int32 GroupStartIndex, const int32 GroupSize)
+{
+	if(GroupStartIndex < 0 || GroupStartIndex + GroupSize > InOutDistToMeanSqrArray.Num())
+	{
+		return;
+	}
+	
+	float GroupDistanceSqr = 0.0f;
+	for(int32 i = GroupStartIndex; i < GroupStartIndex + GroupSize; ++i)
+	{
+		GroupDistanceSqr += InOutDistToMeanSqrArray[i];
+	}
+
+	for(int32 i = GroupStartIndex; i < GroupStartIndex + GroupSize; ++i)
+	{
+		InOutDistToMeanSqrArray[i] = GroupDistanceSqr;
+	}
+}
+
+FName UMatchFeatureBase::GetFeatureBoneName() const
+{
+	return NAME_None;
+}
+
+bool UMatchFeatureBase::IsMirrorCounterpart(const UMatchFeatureBase* InOtherFeature, const FName MirroredBoneName) const
+{
+	if(!InOtherFeature)
+	{
+		return false;
+	}
+
+	return InOtherFeature->GetClass() == GetClass()
+		&& InOtherFeature->PoseCategory == PoseCategory
+		&& InOtherFeature->Size() == Size()
+		&& InOtherFeature->GetFeatureBoneName() == MirroredBoneName;
+}
+
+void UMatchFeatureBase::GetMirrorAtomSigns(float* OutSigns) const
 {
-	for(int32 i = FeatureOffset; i < FeatureOffset + Size(); ++i)
+	for(int32 i = 0; i < Size(); ++i)
 	{
-		const float DistanceToMean = InPoseArray[PoseStartIndex + i] - InMeanArray[i];
-		OutDistToMeanSqrArray[i] += DistanceToMean * DistanceToMean;
+		OutSigns[i] = 1.0f;
 	}
 }
 
@@ -82,10 +82,7 @@ void UMatchFeature_BodyMomentum2D::EvaluatePreProcess(float* ResultLocation, UBl
 		return;
 	}
 	
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 	
 	FVector RootVelocity;
 	float RootRotVelocity;
@@ -133,26 +130,51 @@ void UMatchFeature_BodyMomentum2D::ExtractRuntime(FCSPose<FCompactPose>& CSPose,
     *ResultLocation = Velocity.Y;
 }
 
-void UMatchFeature_BodyMomentum2D::SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset,
-	AActor* InActor)
+bool UMatchFeature_BodyMomentum2D::UsesRuntimePose() const
 {
-	if(!InActor)
+	return false;
+}
+
+bool UMatchFeature_BodyMomentum2D::HasRuntimeHistory() const
+{
+	return true;
+}
+
+void UMatchFeature_BodyMomentum2D::UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy)
+{
+	if(!AnimInstanceProxy)
 	{
-		UMatchFeatureBase::SourceInputData(OutFeatureArray, FeatureOffset, nullptr);
 		return;
 	}
-	
-	
-	if(UCharacterMovementComponent* MovementComponent = InActor->GetComponentByClass<UCharacterMovementComponent>())
+
+	const FVector ActorLocation = AnimInstanceProxy->GetActorTransform().GetLocation();
+	*FeatureCacheLocation = ActorLocation.X;
+	++FeatureCacheLocation;
+	*FeatureCacheLocation = ActorLocation.Y;
+}
+
+UObject* UMatchFeature_BodyMomentum2D::ResolveInputSource(AActor* InActor) const
+{
+	return InActor ? InActor->GetComponentByClass<UCharacterMovementComponent>() : nullptr;
+}
+
+void UMatchFeature_BodyMomentum2D::SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset,
+	UObject* InInputSource)
+{
+	const UCharacterMovementComponent* MovementComponent = Cast<UCharacterMovementComponent>(InInputSource);
+	if(!MovementComponent
+		|| !MovementComponent->GetOwner())
 	{
-		const FVector Velocity = InActor->GetActorTransform().TransformVector(MovementComponent->Velocity);
+		UMatchFeatureBase::SourceResolvedInputData(OutFeatureArray, FeatureOffset, nullptr);
+		return;
+	}
 
+	const FVector Velocity = MovementComponent->GetOwner()->GetActorTransform().TransformVector(MovementComponent->Velocity);
 
-		if(OutFeatureArray.Num() > FeatureOffset + 1)
-		{
-			OutFeatureArray[FeatureOffset] = Velocity.X;
-			OutFeatureArray[FeatureOffset + 1] = Velocity.Y;
-		}
+	if(OutFeatureArray.Num() > FeatureOffset + 1)
+	{
+		OutFeatureArray[FeatureOffset] = Velocity.X;
+		OutFeatureArray[FeatureOffset + 1] = Velocity.Y;
 	}
 }
 
@@ -178,25 +200,17 @@ bool UMatchFeature_BodyMomentum2D::NextPoseToleranceTest(const TArray<float>& De
 	return true;
 }
 
-void UMatchFeature_BodyMomentum2D::CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-                                                                                        const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const
+void UMatchFeature_BodyMomentum2D::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
 {
-	const FVector2d Momentum2d
-	{
-		InPoseArray[PoseStartIndex + FeatureOffset],
-		InPoseArray[PoseStartIndex + FeatureOffset + 1],
-	};
-
-	const FVector2d MeanMomentum2d
-	{
-		InMeanArray[FeatureOffset],
-		InMeanArray[FeatureOffset + 1]
-	};
-
-	const float DistanceToMean = FVector2d::DistSquared(Momentum2d, MeanMomentum2d);
+	ReduceAtomGroup(InOutDistToMeanSqrArray, FeatureOffset, 2);
+}
 
-	OutDistToMeanSqrArray[FeatureOffset] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+1] += DistanceToMean;
+void UMatchFeature_BodyMomentum2D::GetMirrorAtomSigns(float* OutSigns) const
+{
+	*OutSigns = -1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
 }
 
 bool UMatchFeature_BodyMomentum2D::CanBeQualityFeature() const
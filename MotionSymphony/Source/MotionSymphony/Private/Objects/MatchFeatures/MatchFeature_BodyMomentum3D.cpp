@@ -92,10 +92,7 @@ void UMatchFeature_BodyMomentum3D::EvaluatePreProcess(float* ResultLocation, UBl
 		return;
 	}
 	
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 	
 	FVector RootVelocity;
 	float RootRotVelocity;
@@ -150,19 +147,51 @@ void UMatchFeature_BodyMomentum3D::ExtractRuntime(FCSPose<FCompactPose>& CSPose,
 	*ResultLocation = Velocity.Z;
 }
 
-void UMatchFeature_BodyMomentum3D::SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset,
-	AActor* InActor)
+bool UMatchFeature_BodyMomentum3D::UsesRuntimePose() const
 {
-	if(!InActor)
+	return false;
+}
+
+bool UMatchFeature_BodyMomentum3D::HasRuntimeHistory() const
+{
+	return true;
+}
+
+void UMatchFeature_BodyMomentum3D::UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy)
+{
+	if(!AnimInstanceProxy)
 	{
-		UMatchFeatureBase::SourceInputData(OutFeatureArray, FeatureOffset, nullptr);
 		return;
 	}
 
-	if(UCharacterMovementComponent* MovementComponent = InActor->GetComponentByClass<UCharacterMovementComponent>())
+	const FVector ActorLocation = AnimInstanceProxy->GetActorTransform().GetLocation();
+	*FeatureCacheLocation = ActorLocation.X;
+	++FeatureCacheLocation;
+	*FeatureCacheLocation = ActorLocation.Y;
+	++FeatureCacheLocation;
+	*FeatureCacheLocation = ActorLocation.Z;
+}
+
+UObject* UMatchFeature_BodyMomentum3D::ResolveInputSource(AActor* InActor) const
+{
+	return InActor ? InActor->GetComponentByClass<UCharacterMovementComponent>() : nullptr;
+}
+
+void UMatchFeature_BodyMomentum3D::SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset,
+	UObject* InInputSource)
+{
+	const UCharacterMovementComponent* MovementComponent = Cast<UCharacterMovementComponent>(InInputSource);
+	if(!MovementComponent
+		|| !MovementComponent->GetOwner())
 	{
-		const FVector Velocity = InActor->GetActorTransform().TransformVector(MovementComponent->Velocity);
+		UMatchFeatureBase::SourceResolvedInputData(OutFeatureArray, FeatureOffset, nullptr);
+		return;
+	}
+
+	const FVector Velocity = MovementComponent->GetOwner()->GetActorTransform().TransformVector(MovementComponent->Velocity);
 
+	if(OutFeatureArray.Num() > FeatureOffset + 2)
+	{
 		OutFeatureArray[FeatureOffset] = Velocity.X;
 		OutFeatureArray[FeatureOffset + 1] = Velocity.Y;
 		OutFeatureArray[FeatureOffset + 2] = Velocity.Z;
@@ -191,29 +220,19 @@ bool UMatchFeature_BodyMomentum3D::NextPoseToleranceTest(const TArray<float>& De
 	return true;
 }
 
-void UMatchFeature_BodyMomentum3D::CalculateDistanceSqrToMeanArrayForStandardDeviations(
-	TArray<float>& OutDistToMeanSqrArray, const TArray<float>& InMeanArray, const TArray<float>& InPoseArray,
-	const int32 FeatureOffset, const int32 PoseStartIndex) const
+void UMatchFeature_BodyMomentum3D::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
 {
-	const FVector Momentum
-	{
-		InPoseArray[PoseStartIndex + FeatureOffset],
-		InPoseArray[PoseStartIndex + FeatureOffset + 1],
-		InPoseArray[PoseStartIndex + FeatureOffset + 2]
-	};
-
-	const FVector MeanMomentum
-	{
-		InMeanArray[FeatureOffset],
-		InMeanArray[FeatureOffset + 1],
-		InMeanArray[FeatureOffset + 2]
-	};
-
-	const float DistanceToMean = FVector::DistSquared(Momentum, MeanMomentum);
+	ReduceAtomGroup(InOutDistToMeanSqrArray, FeatureOffset, 3);
+}
 
-	OutDistToMeanSqrArray[FeatureOffset] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+1] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+1] += DistanceToMean;
+void UMatchFeature_BodyMomentum3D::GetMirrorAtomSigns(float* OutSigns) const
+{
+	*OutSigns = -1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
 }
 
 bool UMatchFeature_BodyMomentum3D::CanBeQualityFeature() const
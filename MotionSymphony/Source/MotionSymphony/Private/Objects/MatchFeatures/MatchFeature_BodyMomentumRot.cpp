@@ -75,10 +75,7 @@ void UMatchFeature_BodyMomentumRot::EvaluatePreProcess(float* ResultLocation, UB
 		return;
 	}
 
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 
 	
 	 FVector RootVelocity;
@@ -112,6 +109,31 @@ void UMatchFeature_BodyMomentumRot::ExtractRuntime(FCSPose<FCompactPose>& CSPose
 	*FeatureCacheLocation = BodyRotation;
 }
 
+bool UMatchFeature_BodyMomentumRot::UsesRuntimePose() const
+{
+	return false;
+}
+
+bool UMatchFeature_BodyMomentumRot::HasRuntimeHistory() const
+{
+	return true;
+}
+
+void UMatchFeature_BodyMomentumRot::UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy)
+{
+	if(!AnimInstanceProxy)
+	{
+		return;
+	}
+
+	*FeatureCacheLocation = AnimInstanceProxy->GetComponentTransform().GetRotation().Z;
+}
+
+void UMatchFeature_BodyMomentumRot::GetMirrorAtomSigns(float* OutSigns) const
+{
+	*OutSigns = -1.0f;
+}
+
 bool UMatchFeature_BodyMomentumRot::CanBeQualityFeature() const
 {
 	return true;
@@ -70,7 +70,7 @@ void UMatchFeature_BoneAxis::EvaluatePreProcess(float* ResultLocation, UAnimSequ
 
 	switch(Axis)
 	{
-		case EAxis::Type::X: *ResultLocation = BoneTransform_CS.GetLocation().X; break;
+		case EAxis::Type::X: *ResultLocation = bMirror ? -BoneTransform_CS.GetLocation().X : BoneTransform_CS.GetLocation().X; break;
 		case EAxis::Type::Y: *ResultLocation = BoneTransform_CS.GetLocation().Y; break;
 		case EAxis::Type::Z: *ResultLocation = BoneTransform_CS.GetLocation().Z; break;
 		default: *ResultLocation = 0.0f; break;
@@ -106,7 +106,7 @@ void UMatchFeature_BoneAxis::EvaluatePreProcess(float* ResultLocation, UAnimComp
 	
 	switch(Axis)
 	{
-		case EAxis::Type::X: *ResultLocation = BoneTransform_CS.GetLocation().X; break;
+		case EAxis::Type::X: *ResultLocation = bMirror ? -BoneTransform_CS.GetLocation().X : BoneTransform_CS.GetLocation().X; break;
 		case EAxis::Type::Y: *ResultLocation = BoneTransform_CS.GetLocation().Y; break;
 		case EAxis::Type::Z: *ResultLocation = BoneTransform_CS.GetLocation().Z; break;
 		default: *ResultLocation = 0.0f; break;
@@ -127,10 +127,7 @@ void UMatchFeature_BoneAxis::EvaluatePreProcess(float* ResultLocation, UBlendSpa
 	FTransform BoneTransform_CS = FTransform::Identity;
 	FName BoneName = BoneReference.BoneName;
 	
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 	
 
 	if(bMirror && MirrorDataTable)
@@ -148,7 +145,7 @@ void UMatchFeature_BoneAxis::EvaluatePreProcess(float* ResultLocation, UBlendSpa
 	
 	switch(Axis)
 	{
-		case EAxis::Type::X: *ResultLocation = BoneTransform_CS.GetLocation().X; break;
+		case EAxis::Type::X: *ResultLocation = bMirror ? -BoneTransform_CS.GetLocation().X : BoneTransform_CS.GetLocation().X; break;
 		case EAxis::Type::Y: *ResultLocation = BoneTransform_CS.GetLocation().Y; break;
 		case EAxis::Type::Z: *ResultLocation = BoneTransform_CS.GetLocation().Z; break;
 		default: *ResultLocation = 0.0f; break;
@@ -180,6 +177,26 @@ void UMatchFeature_BoneAxis::ExtractRuntime(FCSPose<FCompactPose>& CSPose, float
 	}
 }
 
+FName UMatchFeature_BoneAxis::GetFeatureBoneName() const
+{
+	return BoneReference.BoneName;
+}
+
+bool UMatchFeature_BoneAxis::IsMirrorCounterpart(const UMatchFeatureBase* InOtherFeature, const FName MirroredBoneName) const
+{
+	if(!Super::IsMirrorCounterpart(InOtherFeature, MirroredBoneName))
+	{
+		return false;
+	}
+
+	return Cast<UMatchFeature_BoneAxis>(InOtherFeature)->Axis == Axis;
+}
+
+void UMatchFeature_BoneAxis::GetMirrorAtomSigns(float* OutSigns) const
+{
+	*OutSigns = Axis == EAxis::X ? -1.0f : 1.0f;
+}
+
 bool UMatchFeature_BoneAxis::CanBeQualityFeature() const
 {
 	return true;
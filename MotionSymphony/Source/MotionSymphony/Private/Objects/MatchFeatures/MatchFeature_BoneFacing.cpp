@@ -115,10 +115,7 @@ void UMatchFeature_BoneFacing::EvaluatePreProcess(float* ResultLocation, UBlendS
 	}
 
 	TArray<FBlendSample> BlendSamples =  InBlendSpace->GetBlendSamples();
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 	
 	FTransform JointTransform_CS = FTransform::Identity;
 	TArray<FName> BonesToRoot;
@@ -168,28 +165,34 @@ void UMatchFeature_BoneFacing::ExtractRuntime(FCSPose<FCompactPose>& CSPose, flo
 	*ResultLocation = BoneFacing.Z;
 }
 
-void UMatchFeature_BoneFacing::CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-	const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const
+void UMatchFeature_BoneFacing::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
 {
-	const FVector Facing
-	{
-		InPoseArray[PoseStartIndex + FeatureOffset],
-		InPoseArray[PoseStartIndex + FeatureOffset + 1],
-		InPoseArray[PoseStartIndex + FeatureOffset + 2]
-	};
+	ReduceAtomGroup(InOutDistToMeanSqrArray, FeatureOffset, 3);
+}
+
+FName UMatchFeature_BoneFacing::GetFeatureBoneName() const
+{
+	return BoneReference.BoneName;
+}
 
-	const FVector MeanFacing
+bool UMatchFeature_BoneFacing::IsMirrorCounterpart(const UMatchFeatureBase* InOtherFeature, const FName MirroredBoneName) const
+{
+	if(!Super::IsMirrorCounterpart(InOtherFeature, MirroredBoneName))
 	{
-		InMeanArray[FeatureOffset],
-		InMeanArray[FeatureOffset + 1],
-		InMeanArray[FeatureOffset + 2]
-	};
+		return false;
+	}
 
-	const float DistanceToMean = FVector::DistSquared(Facing, MeanFacing);
+	return Cast<UMatchFeature_BoneFacing>(InOtherFeature)->FacingAxis == FacingAxis;
+}
 
-	OutDistToMeanSqrArray[FeatureOffset] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+1] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+2] += DistanceToMean;
+void UMatchFeature_BoneFacing::GetMirrorAtomSigns(float* OutSigns) const
+{
+	*OutSigns = -1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
 }
 
 bool UMatchFeature_BoneFacing::CanBeQualityFeature() const
@@ -95,10 +95,7 @@ void UMatchFeature_BoneHeight::EvaluatePreProcess(float* ResultLocation, UBlendS
 	FTransform BoneTransform_CS = FTransform::Identity;
 	FName BoneName = BoneReference.BoneName;
 	
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 	
 
 	if(bMirror && MirrorDataTable)
@@ -136,6 +133,11 @@ void UMatchFeature_BoneHeight::ExtractRuntime(FCSPose<FCompactPose>& CSPose, flo
 	*ResultLocation = BoneLocation.Z;
 }
 
+FName UMatchFeature_BoneHeight::GetFeatureBoneName() const
+{
+	return BoneReference.BoneName;
+}
+
 bool UMatchFeature_BoneHeight::CanBeQualityFeature() const
 {
 	return true;
@@ -115,10 +115,7 @@ void UMatchFeature_BoneLocation::EvaluatePreProcess(float* ResultLocation, UBlen
 	}
 
 	TArray<FBlendSample> BlendSamples =  InBlendSpace->GetBlendSamples();
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 	
 	FTransform JointTransform_CS = FTransform::Identity;
 	TArray<FName> BonesToRoot;
@@ -168,28 +165,24 @@ void UMatchFeature_BoneLocation::ExtractRuntime(FCSPose<FCompactPose>& CSPose, f
 	*ResultLocation = BoneLocation.Z;
 }
 
-void UMatchFeature_BoneLocation::CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-	const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const
+void UMatchFeature_BoneLocation::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
 {
-	const FVector Location
-	{
-		InPoseArray[PoseStartIndex + FeatureOffset],
-		InPoseArray[PoseStartIndex + FeatureOffset + 1],
-		InPoseArray[PoseStartIndex + FeatureOffset + 2]
-	};
-
-	const FVector MeanLocation
-	{
-		InMeanArray[FeatureOffset],
-		InMeanArray[FeatureOffset + 1],
-		InMeanArray[FeatureOffset + 2]
-	};
+	ReduceAtomGroup(InOutDistToMeanSqrArray, FeatureOffset, 3);
+}
 
-	const float DistanceToMean = FVector::DistSquared(Location, MeanLocation);
+FName UMatchFeature_BoneLocation::GetFeatureBoneName() const
+{
+	return BoneReference.BoneName;
+}
 
-	OutDistToMeanSqrArray[FeatureOffset] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+1] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+2] += DistanceToMean;
+void UMatchFeature_BoneLocation::GetMirrorAtomSigns(float* OutSigns) const
+{
+	*OutSigns = -1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
 }
 
 bool UMatchFeature_BoneLocation::CanBeQualityFeature() const
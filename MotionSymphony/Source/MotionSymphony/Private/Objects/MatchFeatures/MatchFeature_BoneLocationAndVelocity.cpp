@@ -189,10 +189,7 @@ void UMatchFeature_BoneLocationAndVelocity::EvaluatePreProcess(float* ResultLoca
 	TArray<FName> BonesToRoot;
 	FName BoneName = BoneReference.BoneName;
 
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 
 	if(bMirror && MirrorDataTable)
 	{
@@ -272,6 +269,32 @@ void UMatchFeature_BoneLocationAndVelocity::ExtractRuntime(FCSPose<FCompactPose>
 	*ResultLocation = Velocity.Z;
 }
 
+bool UMatchFeature_BoneLocationAndVelocity::HasRuntimeHistory() const
+{
+	return true;
+}
+
+bool UMatchFeature_BoneLocationAndVelocity::RuntimeHistoryNeedsPose() const
+{
+	return true;
+}
+
+void UMatchFeature_BoneLocationAndVelocity::UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy)
+{
+	if(BoneReference.CachedCompactPoseIndex == -1)
+	{
+		return;
+	}
+
+	//Only the bone location is needed for the velocity calculation on the next extracted frame
+	const FVector BoneLocation = CSPose.GetComponentSpaceTransform(BoneReference.CachedCompactPoseIndex).GetLocation();
+	*FeatureCacheLocation = BoneLocation.X;
+	++FeatureCacheLocation;
+	*FeatureCacheLocation = BoneLocation.Y;
+	++FeatureCacheLocation;
+	*FeatureCacheLocation = BoneLocation.Z;
+}
+
 float UMatchFeature_BoneLocationAndVelocity::GetDefaultWeight(int32 AtomId) const
 {
 	if(AtomId > 2)
@@ -282,46 +305,31 @@ float UMatchFeature_BoneLocationAndVelocity::GetDefaultWeight(int32 AtomId) cons
 	return DefaultWeight;
 }
 
-void UMatchFeature_BoneLocationAndVelocity::CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-                                                                                                 const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const
+void UMatchFeature_BoneLocationAndVelocity::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
 {
-	const FVector Location
-	{
-		InPoseArray[PoseStartIndex + FeatureOffset],
-		InPoseArray[PoseStartIndex + FeatureOffset + 1],
-		InPoseArray[PoseStartIndex + FeatureOffset + 2]
-	};
+	ReduceAtomGroup(InOutDistToMeanSqrArray, FeatureOffset, 3); //Location
+	ReduceAtomGroup(InOutDistToMeanSqrArray, FeatureOffset + 3, 3); //Velocity
+}
 
-	const FVector Velocity
-	{
-		InPoseArray[PoseStartIndex + FeatureOffset + 3],
-		InPoseArray[PoseStartIndex + FeatureOffset + 4],
-		InPoseArray[PoseStartIndex + FeatureOffset + 5]
-	};
+FName UMatchFeature_BoneLocationAndVelocity::GetFeatureBoneName() const
+{
+	return BoneReference.BoneName;
+}
 
-	const FVector MeanLocation
-	{
-		InMeanArray[FeatureOffset],
-		InMeanArray[FeatureOffset + 1],
-		InMeanArray[FeatureOffset + 2]
-	};
-	
-	const FVector MeanVelocity
-	{
-		InMeanArray[FeatureOffset + 3],
-		InMeanArray[FeatureOffset + 4],
-		InMeanArray[FeatureOffset + 5]
-	};
-	
-	const float DistanceToMean_Location = FVector::DistSquared(Location, MeanLocation);
-	const float DistanceToMean_Velocity = FVector::DistSquared(Velocity, MeanVelocity);
-
-	OutDistToMeanSqrArray[FeatureOffset] += DistanceToMean_Location;
-	OutDistToMeanSqrArray[FeatureOffset+1] += DistanceToMean_Location;
-	OutDistToMeanSqrArray[FeatureOffset+2] += DistanceToMean_Location;
-	OutDistToMeanSqrArray[FeatureOffset+3] += DistanceToMean_Velocity;
-	OutDistToMeanSqrArray[FeatureOffset+4] += DistanceToMean_Velocity;
-	OutDistToMeanSqrArray[FeatureOffset+5] += DistanceToMean_Velocity;
+void UMatchFeature_BoneLocationAndVelocity::GetMirrorAtomSigns(float* OutSigns) const
+{
+	*OutSigns = -1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
+	++OutSigns;
+	*OutSigns = -1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
 }
 
 bool UMatchFeature_BoneLocationAndVelocity::CanBeQualityFeature() const
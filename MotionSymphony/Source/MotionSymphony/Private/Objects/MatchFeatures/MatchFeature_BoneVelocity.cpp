@@ -145,10 +145,7 @@ void UMatchFeature_BoneVelocity::EvaluatePreProcess(float* ResultLocation, UBlen
 	TArray<FName> BonesToRoot;
 	FName BoneName = BoneReference.BoneName;
 
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 
 	if(bMirror && MirrorDataTable)
 	{
@@ -213,28 +210,50 @@ void UMatchFeature_BoneVelocity::ExtractRuntime(FCSPose<FCompactPose>& CSPose, f
 	*ResultLocation = Velocity.Z;
 }
 
-void UMatchFeature_BoneVelocity::CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-	const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const
+bool UMatchFeature_BoneVelocity::HasRuntimeHistory() const
 {
-	const FVector Velocity
-	{
-		InPoseArray[PoseStartIndex + FeatureOffset],
-		InPoseArray[PoseStartIndex + FeatureOffset + 1],
-		InPoseArray[PoseStartIndex + FeatureOffset + 2]
-	};
+	return true;
+}
+
+bool UMatchFeature_BoneVelocity::RuntimeHistoryNeedsPose() const
+{
+	return true;
+}
 
-	const FVector MeanVelocity
+void UMatchFeature_BoneVelocity::UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy)
+{
+	if(BoneReference.CachedCompactPoseIndex == -1)
 	{
-		InMeanArray[FeatureOffset],
-		InMeanArray[FeatureOffset + 1],
-		InMeanArray[FeatureOffset + 2]
-	};
+		return;
+	}
 
-	const float DistanceToMean = FVector::DistSquared(Velocity, MeanVelocity);
+	//Only the bone location is needed for the velocity calculation on the next extracted frame
+	const FVector BoneLocation = CSPose.GetComponentSpaceTransform(BoneReference.CachedCompactPoseIndex).GetLocation();
+	*FeatureCacheLocation = BoneLocation.X;
+	++FeatureCacheLocation;
+	*FeatureCacheLocation = BoneLocation.Y;
+	++FeatureCacheLocation;
+	*FeatureCacheLocation = BoneLocation.Z;
+}
+
+void UMatchFeature_BoneVelocity::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
+{
+	ReduceAtomGroup(InOutDistToMeanSqrArray, FeatureOffset, 3);
+}
+
+FName UMatchFeature_BoneVelocity::GetFeatureBoneName() const
+{
+	return BoneReference.BoneName;
+}
 
-	OutDistToMeanSqrArray[FeatureOffset] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+1] += DistanceToMean;
-	OutDistToMeanSqrArray[FeatureOffset+2] += DistanceToMean;
+void UMatchFeature_BoneVelocity::GetMirrorAtomSigns(float* OutSigns) const
+{
+	*OutSigns = -1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
+	++OutSigns;
+	*OutSigns = 1.0f;
 }
 
 bool UMatchFeature_BoneVelocity::CanBeQualityFeature() const
@@ -287,11 +287,17 @@ void UMatchFeature_Distance::EvaluatePreProcess(float* ResultLocation, UBlendSpa
 	*ResultLocation = 0.0f;
 }
 
-void UMatchFeature_Distance::SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, AActor* InActor)
+UObject* UMatchFeature_Distance::ResolveInputSource(AActor* InActor) const
 {
-	if(!InActor)
+	return InActor ? InActor->GetComponentByClass<UDistanceMatching>() : nullptr;
+}
+
+void UMatchFeature_Distance::SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, UObject* InInputSource)
+{
+	UDistanceMatching* DistanceMatching = Cast<UDistanceMatching>(InInputSource);
+	if(!DistanceMatching)
 	{
-		UMatchFeatureBase::SourceInputData(OutFeatureArray, FeatureOffset, nullptr);
+		UMatchFeatureBase::SourceResolvedInputData(OutFeatureArray, FeatureOffset, nullptr);
 		return;
 	}
 
@@ -301,18 +307,15 @@ void UMatchFeature_Distance::SourceInputData(TArray<float>& OutFeatureArray, con
 		return;
 	}
 
-	if(UDistanceMatching* DistanceMatching = InActor->GetComponentByClass<UDistanceMatching>())
+	if(DistanceMatching->DoesCurrentStateMatchFeature(this))
 	{
-		if(DistanceMatching->DoesCurrentStateMatchFeature(this))
-		{
-			const float Distance = DistanceMatching->GetMarkerDistance();
-			const float DistanceSqr = Distance * Distance;
-			OutFeatureArray[FeatureOffset] = Distance < 0.0f ? -1.0f * DistanceSqr : DistanceSqr;
-		}
-		else
-		{
-			OutFeatureArray[FeatureOffset] = 0.0f;
-		}
+		const float Distance = DistanceMatching->GetMarkerDistance();
+		const float DistanceSqr = Distance * Distance;
+		OutFeatureArray[FeatureOffset] = Distance < 0.0f ? -1.0f * DistanceSqr : DistanceSqr;
+	}
+	else
+	{
+		OutFeatureArray[FeatureOffset] = 0.0f;
 	}
 }
 
@@ -412,10 +415,7 @@ FTransform UMatchFeature_Distance::ExtractBlendSpaceRootMotion(const UBlendSpace
 		return FTransform();
 	}
 	
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(InBlendSpacePosition.X, InBlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, InBlendSpacePosition);
 
 	FRootMotionMovementParams RootMotionParams;
 	RootMotionParams.Clear();
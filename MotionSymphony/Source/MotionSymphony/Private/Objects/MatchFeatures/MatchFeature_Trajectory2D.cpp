@@ -220,10 +220,7 @@ void UMatchFeature_Trajectory2D::EvaluatePreProcess(float* ResultLocation, UBlen
 		return;
 	}
 
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 
 	//Extract User Data
 	bool bLoop = false;
@@ -276,41 +273,44 @@ void UMatchFeature_Trajectory2D::EvaluatePreProcess(float* ResultLocation, UBlen
 	}
 }
 
-void UMatchFeature_Trajectory2D::SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, AActor* InActor)
+UObject* UMatchFeature_Trajectory2D::ResolveInputSource(AActor* InActor) const
 {
-	if(!InActor)
+	return InActor ? InActor->GetComponentByClass<UTrajectoryGenerator_Base>() : nullptr;
+}
+
+void UMatchFeature_Trajectory2D::SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, UObject* InInputSource)
+{
+	const UTrajectoryGenerator_Base* TrajectoryGenerator = Cast<UTrajectoryGenerator_Base>(InInputSource);
+	if(!TrajectoryGenerator)
 	{
-		UMatchFeatureBase::SourceInputData(OutFeatureArray, FeatureOffset, nullptr);
+		UMatchFeatureBase::SourceResolvedInputData(OutFeatureArray, FeatureOffset, nullptr);
 		return;
 	}
 
-	if(UTrajectoryGenerator_Base* TrajectoryGenerator = InActor->GetComponentByClass<UTrajectoryGenerator_Base>())
-	{
-		const FTrajectory& Trajectory = TrajectoryGenerator->GetCurrentTrajectory();
+	const FTrajectory& Trajectory = TrajectoryGenerator->GetCurrentTrajectory();
 
-		const int32 Iterations = FMath::Min(TrajectoryTiming.Num(), Trajectory.TrajectoryPoints.Num());
-		
-		for(int32 i = 0; i < Iterations; ++i)
-		{
-			const FTrajectoryPoint& TrajectoryPoint = Trajectory.TrajectoryPoints[i];
+	const int32 Iterations = FMath::Min(TrajectoryTiming.Num(), Trajectory.TrajectoryPoints.Num());
+	
+	for(int32 i = 0; i < Iterations; ++i)
+	{
+		const FTrajectoryPoint& TrajectoryPoint = Trajectory.TrajectoryPoints[i];
 
-			FVector RotationVector = FQuat(FVector::UpVector,
-				FMath::DegreesToRadians(TrajectoryPoint.RotationZ)) * FVector::ForwardVector;
-			RotationVector = RotationVector.GetSafeNormal() * 100.0f;
+		FVector RotationVector = FQuat(FVector::UpVector,
+			FMath::DegreesToRadians(TrajectoryPoint.RotationZ)) * FVector::ForwardVector;
+		RotationVector = RotationVector.GetSafeNormal() * 100.0f;
 
-			const int32 PointOffset = FeatureOffset + (i * 4.0f);
+		const int32 PointOffset = FeatureOffset + (i * 4);
 
-			if(PointOffset + 3 >= OutFeatureArray.Num())
-			{
-				UE_LOG(LogTemp, Error, TEXT("UMatchFeature_Trajectory2D: SourceInputData(...) - Feature does not fit in FeatureArray"));
-				return;
-			}
-			
-			OutFeatureArray[PointOffset] = TrajectoryPoint.Position.X;
-			OutFeatureArray[PointOffset + 1] = TrajectoryPoint.Position.Y;
-			OutFeatureArray[PointOffset + 2] = RotationVector.X;
-			OutFeatureArray[PointOffset + 3] = RotationVector.Y;
+		if(PointOffset + 3 >= OutFeatureArray.Num())
+		{
+			UE_LOG(LogTemp, Error, TEXT("UMatchFeature_Trajectory2D: SourceInputData(...) - Feature does not fit in FeatureArray"));
+			return;
 		}
+		
+		OutFeatureArray[PointOffset] = TrajectoryPoint.Position.X;
+		OutFeatureArray[PointOffset + 1] = TrajectoryPoint.Position.Y;
+		OutFeatureArray[PointOffset + 2] = RotationVector.X;
+		OutFeatureArray[PointOffset + 3] = RotationVector.Y;
 	}
 }
 
@@ -407,45 +407,29 @@ float UMatchFeature_Trajectory2D::GetDefaultWeight(int32 AtomId) const
 	}
 }
 
-void UMatchFeature_Trajectory2D::CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-	const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const
+void UMatchFeature_Trajectory2D::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
 {
 	for(int32 i = 0; i < TrajectoryTiming.Num(); ++i)
 	{
-		const int32 MeansStartIndex = FeatureOffset + i*4;
-		const int32 PointStartIndex = PoseStartIndex + MeansStartIndex;
-		
-		FVector2d PointLocation
-		{
-			InPoseArray[PointStartIndex],
-			InPoseArray[PointStartIndex + 1]
-		};
-
-		FVector2d MeanPointLocation
-		{
-			InMeanArray[MeansStartIndex],
-			InMeanArray[MeansStartIndex + 1]
-		};
-	
-		FVector2d PointFacing
-		{
-			InPoseArray[PointStartIndex + 2],
-			InPoseArray[PointStartIndex + 3]
-		};
-
-		FVector2d MeanPointFacing
-		{
-			InMeanArray[MeansStartIndex + 2],
-			InMeanArray[MeansStartIndex + 3]
-		};
-		
-		const float DistanceToMean_Location = FVector2d::DistSquared(PointLocation, MeanPointLocation);
-		const float DistanceToMean_Facing = FVector2d::DistSquared(PointFacing, MeanPointFacing);
+		const int32 PointStartIndex = FeatureOffset + i*4;
+		ReduceAtomGroup(InOutDistToMeanSqrArray, PointStartIndex, 2); //Location
+		ReduceAtomGroup(InOutDistToMeanSqrArray, PointStartIndex + 2, 2); //Facing
+	}
+}
 
-		OutDistToMeanSqrArray[MeansStartIndex] += DistanceToMean_Location;
-		OutDistToMeanSqrArray[MeansStartIndex + 1] += DistanceToMean_Location;
-		OutDistToMeanSqrArray[MeansStartIndex + 2] += DistanceToMean_Facing;
-		OutDistToMeanSqrArray[MeansStartIndex + 3] += DistanceToMean_Facing;
+void UMatchFeature_Trajectory2D::GetMirrorAtomSigns(float* OutSigns) const
+{
+	for(int32 i = 0; i < TrajectoryTiming.Num(); ++i)
+	{
+		*OutSigns = -1.0f;
+		++OutSigns;
+		*OutSigns = 1.0f;
+		++OutSigns;
+		*OutSigns = 1.0f;
+		++OutSigns;
+		*OutSigns = -1.0f;
+		++OutSigns;
 	}
 }
 
@@ -214,10 +214,7 @@ void UMatchFeature_Trajectory3D::EvaluatePreProcess(float* ResultLocation, UBlen
 		return;
 	}
 
-	TArray<FBlendSampleData> SampleDataList;
-	int32 CachedTriangulationIndex = -1;
-	InBlendSpace->GetSamplesFromBlendInput(FVector(BlendSpacePosition.X, BlendSpacePosition.Y, 0.0f),
-		SampleDataList, CachedTriangulationIndex, false);
+	const TArray<FBlendSampleData>& SampleDataList = FMMPreProcessUtils::FindBlendSamples(InBlendSpace, BlendSpacePosition);
 
 	//Extract User Data
 	bool bLoop = false;
@@ -269,39 +266,42 @@ void UMatchFeature_Trajectory3D::EvaluatePreProcess(float* ResultLocation, UBlen
 	}
 }
 
-void UMatchFeature_Trajectory3D::SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, AActor* InActor)
+UObject* UMatchFeature_Trajectory3D::ResolveInputSource(AActor* InActor) const
 {
-	if(!InActor)
+	return InActor ? InActor->GetComponentByClass<UTrajectoryGenerator_Base>() : nullptr;
+}
+
+void UMatchFeature_Trajectory3D::SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, UObject* InInputSource)
+{
+	const UTrajectoryGenerator_Base* TrajectoryGenerator = Cast<UTrajectoryGenerator_Base>(InInputSource);
+	if(!TrajectoryGenerator)
 	{
-		UMatchFeatureBase::SourceInputData(OutFeatureArray, FeatureOffset, nullptr);
+		UMatchFeatureBase::SourceResolvedInputData(OutFeatureArray, FeatureOffset, nullptr);
 		return;
 	}
 
-	if(UTrajectoryGenerator_Base* TrajectoryGenerator = InActor->GetComponentByClass<UTrajectoryGenerator_Base>())
-	{
-		const FTrajectory& Trajectory = TrajectoryGenerator->GetCurrentTrajectory();
+	const FTrajectory& Trajectory = TrajectoryGenerator->GetCurrentTrajectory();
 
-		const int32 Iterations = FMath::Min(TrajectoryTiming.Num(), Trajectory.TrajectoryPoints.Num());
-		for(int32 i = 0; i < Iterations; ++i)
-		{
-			const FTrajectoryPoint& TrajectoryPoint = Trajectory.TrajectoryPoints[i];
+	const int32 Iterations = FMath::Min(TrajectoryTiming.Num(), Trajectory.TrajectoryPoints.Num());
+	for(int32 i = 0; i < Iterations; ++i)
+	{
+		const FTrajectoryPoint& TrajectoryPoint = Trajectory.TrajectoryPoints[i];
 
-			const FVector RotationVector = FQuat(FVector::UpVector,
-				FMath::DegreesToRadians(TrajectoryPoint.RotationZ)) * FVector::ForwardVector;
+		const FVector RotationVector = FQuat(FVector::UpVector,
+			FMath::DegreesToRadians(TrajectoryPoint.RotationZ)) * FVector::ForwardVector;
 
-			const int32 PointOffset = FeatureOffset + i;
-			if(PointOffset + 4 >= OutFeatureArray.Num())
-			{
-				UE_LOG(LogTemp, Error, TEXT("UMatchFeature_Trajectory3D: SourceInputData(...) - Feature does not fit in FeatureArray"));
-				return;
-			}
-			
-			OutFeatureArray[PointOffset] = TrajectoryPoint.Position.X;
-			OutFeatureArray[PointOffset + 1] = TrajectoryPoint.Position.Y;
-			OutFeatureArray[PointOffset + 2] = TrajectoryPoint.Position.Z;
-			OutFeatureArray[PointOffset + 3] = RotationVector.X;
-			OutFeatureArray[PointOffset + 4] = RotationVector.Y;
+		const int32 PointOffset = FeatureOffset + (i * 5);
+		if(PointOffset + 4 >= OutFeatureArray.Num())
+		{
+			UE_LOG(LogTemp, Error, TEXT("UMatchFeature_Trajectory3D: SourceInputData(...) - Feature does not fit in FeatureArray"));
+			return;
 		}
+		
+		OutFeatureArray[PointOffset] = TrajectoryPoint.Position.X;
+		OutFeatureArray[PointOffset + 1] = TrajectoryPoint.Position.Y;
+		OutFeatureArray[PointOffset + 2] = TrajectoryPoint.Position.Z;
+		OutFeatureArray[PointOffset + 3] = RotationVector.X;
+		OutFeatureArray[PointOffset + 4] = RotationVector.Y;
 	}
 }
 
@@ -402,50 +402,31 @@ float UMatchFeature_Trajectory3D::GetDefaultWeight(int32 AtomId) const
 	}
 }
 
-void UMatchFeature_Trajectory3D::CalculateDistanceSqrToMeanArrayForStandardDeviations(
-	TArray<float>& OutDistToMeanSqrArray, const TArray<float>& InMeanArray, const TArray<float>& InPoseArray,
-	const int32 FeatureOffset, const int32 PoseStartIndex) const
+void UMatchFeature_Trajectory3D::ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+	const int32 FeatureOffset) const
 {
 	for(int32 i = 0; i < TrajectoryTiming.Num(); ++i)
 	{
-		const int32 MeansStartIndex = FeatureOffset + i*5;
-		const int32 PointStartIndex = PoseStartIndex + MeansStartIndex;
-		
-		FVector PointLocation
-		{
-			InPoseArray[PointStartIndex],
-			InPoseArray[PointStartIndex + 1],
-			InPoseArray[PointStartIndex + 2]
-				
-		};
-
-		FVector MeanPointLocation
-		{
-			InMeanArray[MeansStartIndex],
-			InMeanArray[MeansStartIndex + 1],
-			InMeanArray[MeansStartIndex + 2]
-		};
-	
-		FVector2d PointFacing
-		{
-			InPoseArray[PointStartIndex + 3],
-			InPoseArray[PointStartIndex + 4]
-		};
+		const int32 PointStartIndex = FeatureOffset + i*5;
+		ReduceAtomGroup(InOutDistToMeanSqrArray, PointStartIndex, 3); //Location
+		ReduceAtomGroup(InOutDistToMeanSqrArray, PointStartIndex + 3, 2); //Facing
+	}
+}
 
-		FVector2d MeanPointFacing
-		{
-			InMeanArray[MeansStartIndex + 3],
-			InMeanArray[MeansStartIndex + 4]
-		};
-		
-		const float DistanceToMean_Location = FVector::DistSquared(PointLocation, MeanPointLocation);
-		const float DistanceToMean_Facing = FVector2d::DistSquared(PointFacing, MeanPointFacing);
-
-		OutDistToMeanSqrArray[MeansStartIndex] += DistanceToMean_Location;
-		OutDistToMeanSqrArray[MeansStartIndex + 1] += DistanceToMean_Location;
-		OutDistToMeanSqrArray[MeansStartIndex + 2] += DistanceToMean_Location;
-		OutDistToMeanSqrArray[MeansStartIndex + 3] += DistanceToMean_Facing;
-		OutDistToMeanSqrArray[MeansStartIndex + 4] += DistanceToMean_Facing;
+void UMatchFeature_Trajectory3D::GetMirrorAtomSigns(float* OutSigns) const
+{
+	for(int32 i = 0; i < TrajectoryTiming.Num(); ++i)
+	{
+		*OutSigns = -1.0f;
+		++OutSigns;
+		*OutSigns = 1.0f;
+		++OutSigns;
+		*OutSigns = 1.0f;
+		++OutSigns;
+		*OutSigns = 1.0f;
+		++OutSigns;
+		*OutSigns = -1.0f;
+		++OutSigns;
 	}
 }
 
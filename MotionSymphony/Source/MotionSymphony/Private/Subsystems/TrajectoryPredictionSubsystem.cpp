@@ -0,0 +1,295 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#include "Subsystems/TrajectoryPredictionSubsystem.h"
+#include "Async/ParallelFor.h"
+
+static constexpr int32 SpringBatchChunkSize = 32;
+
+UTrajectoryPredictionSubsystem::UTrajectoryPredictionSubsystem()
+	: MaxSpringIterations(0)
+{
+}
+
+bool UTrajectoryPredictionSubsystem::RegisterGenerator(UTrajectoryGenerator* InGenerator)
+{
+	if(!InGenerator)
+	{
+		return false;
+	}
+
+	if(!InGenerator->SupportsBatchedPrediction())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TrajectoryPredictionSubsystem: '%s' may override prediction that the batched pass does not call. It will tick on its own."),
+			*InGenerator->GetClass()->GetName());
+		return false;
+	}
+	
+	Generators.AddUnique(InGenerator);
+	return true;
+}
+
+void UTrajectoryPredictionSubsystem::UnregisterGenerator(UTrajectoryGenerator* InGenerator)
+{
+	Generators.RemoveSingleSwap(InGenerator);
+}
+
+void UTrajectoryPredictionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	GatherGenerators(DeltaTime);
+
+	if(SpringGenerators.Num() == 0
+		&& CapsuleGenerators.Num() == 0)
+	{
+		return;
+	}
+
+	SolveSpringBatch();
+	SolveCapsuleBatch();
+	ScatterSpringBatch();
+
+	for(int32 i = 0; i < SpringGenerators.Num(); ++i)
+	{
+		SpringGenerators[i]->FinishBatchedPrediction(SpringDeltaTimes[i]);
+	}
+
+	for(int32 i = 0; i < CapsuleGenerators.Num(); ++i)
+	{
+		CapsuleGenerators[i]->FinishBatchedPrediction(CapsuleDeltaTimes[i]);
+	}
+}
+
+TStatId UTrajectoryPredictionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrajectoryPredictionSubsystem, STATGROUP_Tickables);
+}
+
+bool UTrajectoryPredictionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTrajectoryPredictionSubsystem::GatherGenerators(const float DeltaTime)
+{
+	SpringGenerators.Reset();
+	SpringDeltaTimes.Reset();
+	SpringIterationCounts.Reset();
+	DesiredDisplacementX.Reset();
+	DesiredDisplacementY.Reset();
+	DesiredDisplacementZ.Reset();
+	DesiredOrientations.Reset();
+	MoveDecaySteps.Reset();
+	TurnDecaySteps.Reset();
+	MaxSpringIterations = 0;
+
+	CapsuleGenerators.Reset();
+	CapsuleDeltaTimes.Reset();
+	CapsuleInputs.Reset();
+
+	//Everything that touches the character or its components is done here on the game thread
+	for(int32 GeneratorIndex = Generators.Num() - 1; GeneratorIndex > -1; --GeneratorIndex)
+	{
+		UTrajectoryGenerator* Generator = Generators[GeneratorIndex];
+		if(!IsValid(Generator))
+		{
+			Generators.RemoveAtSwap(GeneratorIndex);
+			continue;
+		}
+
+		const AActor* Owner = Generator->GetOwner();
+		if(!Generator->IsActive()
+			|| !Owner)
+		{
+			continue;
+		}
+
+		const float GeneratorDeltaTime = DeltaTime * Owner->CustomTimeDilation;
+		if(!Generator->PrepareTrajectoryUpdate(GeneratorDeltaTime))
+		{
+			continue;
+		}
+
+		FVector DesiredLinearDisplacement;
+		Generator->CalculateDesiredLinearDisplacement(DesiredLinearDisplacement);
+
+		if(Generator->UsesPathFollowPrediction())
+		{
+			//Path following walks the navigation path and is not batched
+			Generator->PathFollowPrediction(GeneratorDeltaTime, Generator->TrajectoryIterations, DesiredLinearDisplacement);
+			Generator->FinishBatchedPrediction(GeneratorDeltaTime);
+			continue;
+		}
+
+		switch(Generator->TrajectoryModel)
+		{
+			case ETrajectoryModel::Spring:
+			{
+				const int32 Iterations = Generator->TrajPositions.Num();
+				const float PercentageStep = 1.0f / FMath::Max(1.0f, static_cast<float>(Iterations - 1));
+
+				SpringGenerators.Add(Generator);
+				SpringDeltaTimes.Add(GeneratorDeltaTime);
+				SpringIterationCounts.Add(Iterations);
+				DesiredDisplacementX.Add(DesiredLinearDisplacement.X);
+				DesiredDisplacementY.Add(DesiredLinearDisplacement.Y);
+				DesiredDisplacementZ.Add(DesiredLinearDisplacement.Z);
+				DesiredOrientations.Add(FMath::DegreesToRadians(Generator->CalculateDesiredOrientation(DesiredLinearDisplacement)));
+				MoveDecaySteps.Add(FMath::Exp(-Generator->MoveResponse_Remapped * GeneratorDeltaTime * PercentageStep));
+				TurnDecaySteps.Add(FMath::Exp(-Generator->TurnResponse_Remapped * GeneratorDeltaTime * PercentageStep));
+				MaxSpringIterations = FMath::Max(MaxSpringIterations, Iterations);
+			} break;
+			case ETrajectoryModel::UECharacterMovement:
+			{
+				FTrajectoryCapsuleInput CapsuleInput;
+				if(Generator->GatherCapsuleInput(GeneratorDeltaTime, CapsuleInput))
+				{
+					CapsuleGenerators.Add(Generator);
+					CapsuleDeltaTimes.Add(GeneratorDeltaTime);
+					CapsuleInputs.Add(CapsuleInput);
+				}
+				else
+				{
+					//Nothing can change the motion so the last prediction is kept
+					Generator->FinishBatchedPrediction(GeneratorDeltaTime);
+				}
+			} break;
+			case ETrajectoryModel::CriticallyDampedSpring:
+			{
+				//The closed form spring only evaluates the extracted points so it is cheap enough to not batch
+				Generator->CriticallyDampedSpringPrediction(DesiredLinearDisplacement);
+				Generator->FinishBatchedPrediction(GeneratorDeltaTime);
+			} break;
+		}
+	}
+
+	//Copy the previous spring predictions into the batch buffers
+	const int32 SpringCount = SpringGenerators.Num();
+	const int32 BufferSize = SpringCount * MaxSpringIterations;
+	PositionsX.SetNumZeroed(BufferSize, false);
+	PositionsY.SetNumZeroed(BufferSize, false);
+	PositionsZ.SetNumZeroed(BufferSize, false);
+	Rotations.SetNumZeroed(BufferSize, false);
+
+	for(int32 Character = 0; Character < SpringCount; ++Character)
+	{
+		const UTrajectoryGenerator* Generator = SpringGenerators[Character];
+		const TArray<FVector>& TrajPositions = Generator->TrajPositions;
+		const TArray<float>& TrajRotations = Generator->TrajRotations;
+		const int32 Iterations = SpringIterationCounts[Character];
+		for(int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const int32 BufferIndex = Iteration * SpringCount + Character;
+			PositionsX[BufferIndex] = TrajPositions[Iteration].X;
+			PositionsY[BufferIndex] = TrajPositions[Iteration].Y;
+			PositionsZ[BufferIndex] = TrajPositions[Iteration].Z;
+			Rotations[BufferIndex] = FMath::DegreesToRadians(TrajRotations[Iteration]);
+		}
+
+		//Rows past the character's own iteration count are left as zero padding and are never scattered back
+		for(int32 Iteration = Iterations; Iteration < MaxSpringIterations; ++Iteration)
+		{
+			const int32 BufferIndex = Iteration * SpringCount + Character;
+			PositionsX[BufferIndex] = PositionsY[BufferIndex] = PositionsZ[BufferIndex] = Rotations[BufferIndex] = 0.0f;
+		}
+	}
+}
+
+void UTrajectoryPredictionSubsystem::SolveSpringBatch()
+{
+	const int32 SpringCount = SpringGenerators.Num();
+	if(SpringCount == 0)
+	{
+		return;
+	}
+
+	MoveDecays.Init(1.0f, SpringCount);
+	TurnDecays.Init(1.0f, SpringCount);
+	PreviousPositionsX.SetNumUninitialized(SpringCount, false);
+	PreviousPositionsY.SetNumUninitialized(SpringCount, false);
+	PreviousPositionsZ.SetNumUninitialized(SpringCount, false);
+
+	//The same model as UTrajectoryGenerator::InputPrediction. Each new point is the previous new point plus the
+	//previous prediction's displacement sprung towards the desired displacement. The spring progresses further
+	//along the trajectory.
+	const int32 ChunkCount = FMath::DivideAndRoundUp(SpringCount, SpringBatchChunkSize);
+	ParallelFor(ChunkCount, [&](const int32 ChunkIndex)
+	{
+		const int32 StartCharacter = ChunkIndex * SpringBatchChunkSize;
+		const int32 EndCharacter = FMath::Min(StartCharacter + SpringBatchChunkSize, SpringCount);
+
+		for(int32 Character = StartCharacter; Character < EndCharacter; ++Character)
+		{
+			PreviousPositionsX[Character] = PositionsX[Character];
+			PreviousPositionsY[Character] = PositionsY[Character];
+			PreviousPositionsZ[Character] = PositionsZ[Character];
+			PositionsX[Character] = PositionsY[Character] = PositionsZ[Character] = Rotations[Character] = 0.0f;
+		}
+
+		for(int32 Iteration = 1; Iteration < MaxSpringIterations; ++Iteration)
+		{
+			const int32 RowStart = Iteration * SpringCount;
+			const int32 PreviousRowStart = RowStart - SpringCount;
+			
+			for(int32 Character = StartCharacter; Character < EndCharacter; ++Character)
+			{
+				MoveDecays[Character] *= MoveDecaySteps[Character];
+				TurnDecays[Character] *= TurnDecaySteps[Character];
+				const float MoveProgress = 1.0f - MoveDecays[Character];
+				const float TurnProgress = 1.0f - TurnDecays[Character];
+				const int32 Index = RowStart + Character;
+
+				//Positions
+				const float OldX = PositionsX[Index];
+				const float OldY = PositionsY[Index];
+				const float OldZ = PositionsZ[Index];
+				const float DisplacementX = OldX - PreviousPositionsX[Character];
+				const float DisplacementY = OldY - PreviousPositionsY[Character];
+				const float DisplacementZ = OldZ - PreviousPositionsZ[Character];
+				PreviousPositionsX[Character] = OldX;
+				PreviousPositionsY[Character] = OldY;
+				PreviousPositionsZ[Character] = OldZ;
+
+				PositionsX[Index] = PositionsX[PreviousRowStart + Character] + DisplacementX
+					+ (DesiredDisplacementX[Character] - DisplacementX) * MoveProgress;
+				PositionsY[Index] = PositionsY[PreviousRowStart + Character] + DisplacementY
+					+ (DesiredDisplacementY[Character] - DisplacementY) * MoveProgress;
+				PositionsZ[Index] = PositionsZ[PreviousRowStart + Character] + DisplacementZ
+					+ (DesiredDisplacementZ[Character] - DisplacementZ) * MoveProgress;
+
+				//Rotations (FMotionMatchingUtils::LerpAngle)
+				const float OldRotation = Rotations[Index];
+				const float DeltaAngle = FMath::Fmod(DesiredOrientations[Character] - OldRotation, UE_TWO_PI);
+				Rotations[Index] = OldRotation + (FMath::Fmod(2.0f * DeltaAngle, UE_TWO_PI) - DeltaAngle) * TurnProgress;
+			}
+		}
+	});
+}
+
+void UTrajectoryPredictionSubsystem::SolveCapsuleBatch()
+{
+	ParallelFor(CapsuleGenerators.Num(), [&](const int32 CapsuleIndex)
+	{
+		UTrajectoryGenerator* Generator = CapsuleGenerators[CapsuleIndex];
+		UTrajectoryGenerator::SolveCapsulePrediction(CapsuleInputs[CapsuleIndex], Generator->TrajPositions.GetData(),
+			Generator->TrajRotations.GetData(), Generator->TrajectoryIterations);
+	});
+}
+
+void UTrajectoryPredictionSubsystem::ScatterSpringBatch()
+{
+	const int32 SpringCount = SpringGenerators.Num();
+	for(int32 Character = 0; Character < SpringCount; ++Character)
+	{
+		UTrajectoryGenerator* Generator = SpringGenerators[Character];
+		TArray<FVector>& TrajPositions = Generator->TrajPositions;
+		TArray<float>& TrajRotations = Generator->TrajRotations;
+		const int32 Iterations = SpringIterationCounts[Character];
+		for(int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const int32 BufferIndex = Iteration * SpringCount + Character;
+			TrajPositions[Iteration] = FVector(PositionsX[BufferIndex], PositionsY[BufferIndex], PositionsZ[BufferIndex]);
+			TrajRotations[Iteration] = FMath::RadiansToDegrees(Rotations[BufferIndex]);
+		}
+	}
+}
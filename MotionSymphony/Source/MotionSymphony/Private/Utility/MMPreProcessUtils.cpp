@@ -8,6 +8,21 @@
 #include "Enumerations/EMotionMatchingEnums.h"
 #include "Animation/MirrorDataTable.h"
 #include "Animation/Skeleton.h"
+#include "Animation/BlendSpace.h"
+
+namespace
+{
+	/** The last blend space sample look-up. Pre-processing can run on several threads so the cache is per thread */
+	struct FBlendSampleCache
+	{
+		const UBlendSpace* BlendSpace = nullptr;
+		FVector2D Position = FVector2D::ZeroVector;
+		int32 CachedTriangulationIndex = -1;
+		TArray<FBlendSampleData> SampleDataList;
+	};
+
+	thread_local FBlendSampleCache BlendSampleCache;
+}
 
 void FMMPreProcessUtils::ExtractRootMotionParams(FRootMotionMovementParams& OutRootMotion, 
 	const TArray<FBlendSampleData>& BlendSampleData, const float BaseTime, const float DeltaTime, const bool AllowLooping)
@@ -1222,3 +1237,38 @@ FName FMMPreProcessUtils::FindMirrorBoneName(const USkeleton* InSkeleton, UMirro
 	return BoneName;
 }
 
+const TArray<FBlendSampleData>& FMMPreProcessUtils::FindBlendSamples(const UBlendSpace* InBlendSpace, const FVector2D& InBlendSpacePosition)
+{
+	FBlendSampleCache& Cache = BlendSampleCache;
+	
+	if(Cache.BlendSpace == InBlendSpace
+		&& Cache.Position == InBlendSpacePosition)
+	{
+		return Cache.SampleDataList;
+	}
+
+	if(Cache.BlendSpace != InBlendSpace)
+	{
+		Cache.CachedTriangulationIndex = -1;
+	}
+
+	Cache.BlendSpace = InBlendSpace;
+	Cache.Position = InBlendSpacePosition;
+	Cache.SampleDataList.Reset();
+
+	if(InBlendSpace)
+	{
+		InBlendSpace->GetSamplesFromBlendInput(FVector(InBlendSpacePosition.X, InBlendSpacePosition.Y, 0.0f),
+			Cache.SampleDataList, Cache.CachedTriangulationIndex, false);
+	}
+
+	return Cache.SampleDataList;
+}
+
+void FMMPreProcessUtils::ResetBlendSampleCache()
+{
+	BlendSampleCache.BlendSpace = nullptr;
+	BlendSampleCache.Position = FVector2D::ZeroVector;
+	BlendSampleCache.CachedTriangulationIndex = -1;
+	BlendSampleCache.SampleDataList.Empty();
+}
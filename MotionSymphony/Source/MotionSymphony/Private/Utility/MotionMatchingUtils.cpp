@@ -48,6 +48,15 @@ void FMotionMatchingUtils::LerpPose(FPoseMotionData& OutLerpPose, const FPoseMot
 	OutLerpPose.Time = FMath::Lerp(From.Time, To.Time, Progress);
 }
 
+void FMotionMatchingUtils::LerpPose(FRuntimePoseData& OutLerpPose, const FRuntimePoseData& From,
+	const FRuntimePoseData& To, const float Progress)
+{
+	OutLerpPose = Progress < 0.5f ? From : To;
+	OutLerpPose.LastPoseId = From.PoseId;
+	OutLerpPose.NextPoseId = To.PoseId;
+	OutLerpPose.Time = FMath::Lerp(From.Time, To.Time, Progress);
+}
+
 void FMotionMatchingUtils::LerpLinearPoseData(TArray<float>& OutLerpPose, TArray<float> From, TArray<float> To,
                                               const float Progress)
 {
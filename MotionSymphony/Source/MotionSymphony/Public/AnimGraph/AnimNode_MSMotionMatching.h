@@ -9,6 +9,8 @@
 #include "Objects/Assets/MotionCalibration.h"
 #include "Objects/Assets/MotionDataAsset.h"
 #include "Data/AnimChannelState.h"
+#include "Data/MotionMatchingRuntimeData.h"
+#include "Data/MirrorBoneMap.h"
 #include "Data/PoseMotionData.h"
 #include "Data/Trajectory.h"
 #include "Enumerations/EMotionMatchingEnums.h"
@@ -17,6 +19,7 @@
 struct FDistanceMatchPayload;
 struct FMotionActionPayload;
 struct FMotionTraitField;
+class UMotionInputProvider;
 
 /** An animation node which performs motion matching to synthesise animation. It is an asset player
 which uses MotionAnimData asset as it's source data. The node can be used with inertialization and 
@@ -32,6 +35,12 @@ public:
 	predicted using a movement model over several iterations. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input", meta = (PinShownByDefault))
 	FMotionMatchingInputData InputData;
+
+	/** If true, the desired input is built natively by a 'Motion Input Provider' component on the owning actor instead
+	 * of being passed in through 'Input Data'. The provider writes the input on the game thread and the node only copies
+	 * it on frames where a pose search is performed. If no provider is found the node falls back to 'Input Data'. */
+	UPROPERTY(EditAnywhere, Category = "Input")
+	bool bUseInputProvider = false;
 	
 	/** Motion Matching searches only occur every 'Update Interval'. This input allows the suer to force a motion matching
 	 * update for the purposes of improve responsiveness. This is best done when there is a sudden change in user input
@@ -79,9 +88,6 @@ public:
 	selection and synthesis of animation poses. */
 	UPROPERTY(EditAnywhere, Category = "Animation Data", meta = (PinShownByDefault))
 	TObjectPtr<UMotionCalibration> UserCalibration = nullptr;
-	
-	UPROPERTY()
-	TArray<FCalibrationData> FinalCalibrationSets;
 
 	/** There are two options for pose searches, performance mode and quality mode. Performance mode still gets good
 	 results, however, the quality mode performs additional calculations which slightly improve the quality at a
@@ -101,6 +107,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Options", meta = (PinHiddenByDefault))
 	EPastTrajectoryMode PastTrajectoryMode;
 
+	/** How much work the node does each frame. 'Root Motion Only' and 'Search Only' still search and advance the chosen
+	 * animation but output the reference pose and advance root motion from the motion data's baked root motion table
+	 * (where available) instead of decompressing animation data. 'Search Only' also skips notifies. The reduced modes
+	 * take the current pose features from the pose database rather than from a motion recorder, so they can choose
+	 * different poses from 'Full' for the same input. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Root Motion", meta = (PinHiddenByDefault))
+	EMotionMatchingPlaybackMode PlaybackMode = EMotionMatchingPlaybackMode::Full;
+
+	/** The LOD at or above which the node runs in at least 'Root Motion Only' playback mode. A value of -1 means that
+	 * the playback mode is never reduced by LOD. */
+	UPROPERTY(EditAnywhere, Category = "Root Motion", meta = (ClampMin = -1))
+	int32 RootMotionOnlyLODThreshold = INDEX_NONE;
+
+	/** If true, the node always runs in 'Search Only' playback mode on dedicated servers where only the chosen pose and
+	 * its root motion are needed for authoritative movement. */
+	UPROPERTY(EditAnywhere, Category = "Root Motion")
+	bool bSearchOnlyOnDedicatedServer = false;
+
 	/** If true, the desired will be blended with the current trajectory with a time falloff. This provides a very realistic 
 	trajectory but it can also reduce responsiveness. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Response")
@@ -177,6 +201,7 @@ private:
 	float TimeSinceMotionChosen;
 	float PoseInterpolationValue;
 	bool bForcePoseSearch;
+	bool bPoseSearchDeferred;
 	int32 CurrentChosenPoseId;
 	int32 InputArraySize;
 	int32 MotionRecorderConfigIndex;
@@ -185,16 +210,29 @@ private:
 	bool bInitialized;
 	bool bTriggerTransition;
 
-	FPoseMotionData CurrentInterpolatedPose;
+	/** True if the current animation is being mirrored at runtime rather than playing a baked mirrored pose */
+	bool bRuntimeMirrored;
+
+	FRuntimePoseData CurrentInterpolatedPose;
 	TArray<float> CurrentInterpolatedPoseArray;
 	TArray<float> CalibrationArray;
+
+	/** Final calibration weights shared with every other node using the same motion data, config and user calibration */
+	TSharedPtr<const FMotionMatchingRuntimeData, ESPMode::ThreadSafe> RuntimeData;
+
+	//Runtime mirroring. The query and calibration used to search un-mirrored poses as if they were mirrored
+	TArray<float> MirroredPoseArray;
+	TArray<float> MirroredCalibrationArray;
+	TArray<float> MirroredDesiredInputArray;
 	FAnimChannelState MMAnimState;
 	
-	//Compact pose format of mirror bone map
-	TCustomBoneIndexArray<FCompactPoseBoneIndex, FCompactPoseBoneIndex> CompactPoseMirrorBones;
+	//Compact pose mirror bone map and reference rotations for the current LOD, shared with other node instances
+	TSharedPtr<const FMirrorBoneMap, ESPMode::ThreadSafe> MirrorBoneMap;
+	
+	TWeakObjectPtr<UMotionInputProvider> InputProvider;
 
-	//Pre-calculated component space to reference pose, which allows mirror to work with any joint orientation
-	TCustomBoneIndexArray<FQuat, FCompactPoseBoneIndex> ComponentSpaceRefRotations;
+	/** The input sequence of the provider when its input was last copied */
+	uint32 InputProviderSequence;
 	
 	FAnimInstanceProxy* AnimInstanceProxy; //For Debug drawing
 	
@@ -232,28 +270,39 @@ public:
 	// End of FAnimNode_Base interface
 
 private:
+	/** Returns the motion recorder to take the current pose from. Returns nullptr if there is no recorder or if the
+	 * playback mode does not evaluate the pose, in which case the recorder would only be recording the reference pose. */
+	FAnimNode_MotionRecorder* FindMotionRecorder(const FAnimationUpdateContext& Context) const;
+	void UpdatePlaybackModeState(const FAnimInstanceProxy* InAnimInstanceProxy);
 	void InitializeWithPoseRecorder(const FAnimationUpdateContext& Context);
 	void InitializeMatchedTransition(const FAnimationUpdateContext& Context);
+	void InitializeInputProvider(const FAnimationUpdateContext& Context);
+	bool UpdateInputFromProvider();
 	void UpdateMotionMatchingState(const float DeltaTime, const FAnimationUpdateContext& Context);
 	void UpdateMotionMatching(const float DeltaTime, const FAnimationUpdateContext& Context);
 	void ComputeCurrentPose();
 	void ComputeCurrentPose(const TArray<float>* CurrentPoseArray);
+	void FindCurrentPosePair(const UMotionDataAsset* InMotionData, int32& OutBeforePoseId, int32& OutAfterPoseId);
+	void MirrorCurrentPoseArray(const UMotionDataAsset* InMotionData);
+	void GenerateMirroredQuery();
 	void PoseSearch(const FAnimationUpdateContext& Context);
 	void TransitionPoseSearch(const FAnimationUpdateContext& Context);
-	bool CheckForcePoseSearch(const UMotionDataAsset* InMotionData) const;
-	int32 GetLowestCostPoseId_Transition();
-	int32 GetLowestCostPoseId_Standard();
-	int32 GetLowestCostPoseId_HighQuality(const float DeltaTime);
+	bool CheckForcePoseSearch(const UMotionDataAsset* InMotionData, const float LookAheadTime = 0.0f) const;
+	int32 GetLowestCostPoseId_Transition(bool& bOutMirrored);
+	int32 GetLowestCostPoseId_Standard(bool& bOutMirrored);
+	int32 GetLowestCostPoseId_HighQuality(const float DeltaTime, bool& bOutMirrored);
 	int32 GetLowestCostNextNaturalId(int32 LowestPoseId_LM, float& OutLowestCost, TObjectPtr<const UMotionDataAsset> InMotionData);
 	bool NextPoseToleranceTest(const FPoseMotionData& NextPose) const;
 	void ApplyTrajectoryBlending();
 	bool GenerateCalibrationArray();
 	
-	void TransitionToPose(const int32 PoseId, const FAnimationUpdateContext& Context, const float TimeOffset = 0.0f);
-	void JumpToPose(const int32 PoseIdDatabase, const float TimeOffset = 0.0f);
+	void TransitionToPose(const int32 PoseId, const FAnimationUpdateContext& Context, const float TimeOffset = 0.0f,
+		const bool bInRuntimeMirrored = false);
+	void JumpToPose(const int32 PoseIdDatabase, const float TimeOffset = 0.0f, const bool bInRuntimeMirrored = false);
 
 	TObjectPtr<const UMotionDataAsset> GetMotionData() const;
 	TObjectPtr<const UMotionCalibration> GetUserCalibration() const;
+	EMotionMatchingPlaybackMode GetPlaybackMode(const FAnimInstanceProxy* InAnimInstanceProxy) const;
 	UMirrorDataTable* GetMirrorDataTable() const;
 	void CheckValidToEvaluate(const FAnimInstanceProxy* InAnimInstanceProxy);
 
@@ -35,11 +35,46 @@ public:
 	UPROPERTY(Transient)
 	TArray<float> FeatureCacheData;
 
+	/** Set once a consumer has requested a snapshot for this config. From then on features are only extracted on
+	 * requested frames. Configs that are never requested (e.g. by pose matching nodes) are extracted every frame. */
+	bool bExtractOnRequest;
+
+	/** Set by a consumer during update when it will need a fresh snapshot of this config on its next search */
+	bool bSnapshotRequested;
+
+	/** Set when a consumer has updated this frame, whether or not it requested a snapshot. A config whose consumer did
+	 * not update (e.g. it is not relevant) is extracted so that its snapshot is current when the consumer resumes. */
+	bool bConsumerUpdated;
+
+	/** Whether the features of this config were extracted on the last evaluation */
+	bool bSnapshotCurrent;
+
 public:
 	FMotionRecordData();
 	FMotionRecordData(UMotionMatchConfig* InMotionMatchConfig);
 };
 
+/** The bones read by the recorded features and all of their ancestors for a single LOD, sorted so that parents come
+ * before children. Only these bones are retargeted and converted to component space when features are extracted. */
+struct MOTIONSYMPHONY_API FMotionRecorderBoneChain
+{
+public:
+	TArray<FCompactPoseBoneIndex> CompactBoneIndices;
+
+	/** Per chain bone, the inverse of the compact reference pose and the reference skeleton pose used for retargeting */
+	TArray<FTransform> InverseCompactRefPose;
+	TArray<FTransform> SkeletonRefPose;
+
+private:
+	TWeakObjectPtr<const UObject> Asset;
+	int32 CompactBoneCount;
+
+public:
+	FMotionRecorderBoneChain();
+
+	void Build(const FBoneContainer& BoneContainer, const TArray<TObjectPtr<UMotionMatchConfig>>& InMotionConfigs);
+	bool IsValidFor(const FBoneContainer& BoneContainer) const;
+};
 
 USTRUCT(BlueprintInternalUseOnly)
 struct MOTIONSYMPHONY_API FAnimNode_MotionRecorder : public FAnimNode_Base
@@ -62,6 +97,12 @@ private:
 	
 	TArray<FMotionRecordData> MotionRecorderData;
 
+	/** Bone chains needed by the registered configs, indexed by LOD */
+	TArray<FMotionRecorderBoneChain> LODBoneChains;
+
+	/** The source local transforms of the bone chain, kept while it is retargeted in place on the output pose */
+	TArray<FTransform> SourceChainTransforms;
+
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UMotionMatchConfig>> CopyConfigs;
 
@@ -73,9 +114,22 @@ public:
 	const TArray<float>* GetCurrentPoseArray(const int32 ConfigIndex);
 	int32 GetMotionConfigIndex(const UMotionMatchConfig* InConfig);
 	int32 RegisterMotionMatchConfig(UMotionMatchConfig* InMotionMatchConfig);
+
+	/** Requests that the features of a registered config are extracted when this recorder is next evaluated. Once a
+	 * config has been requested, evaluations without a request only update features that keep per-frame history
+	 * (e.g. velocities) and the snapshot otherwise holds the values from the last requested evaluation. Consumers call
+	 * this every update, passing bExtract as false on frames where they do not need the snapshot. */
+	void RequestSnapshot(const int32 ConfigIndex, const bool bExtract = true);
+
+	/** Returns true if the snapshot of a registered config was extracted on the last evaluation of this recorder */
+	bool IsSnapshotCurrent(const int32 ConfigIndex) const;
 	
 	static void LogRequestError(const FAnimationUpdateContext& Context, const FPoseLinkBase& RequesterPoseLink);
 
+private:
+	const FMotionRecorderBoneChain& FindOrCacheBoneChain(const FAnimInstanceProxy* InProxy);
+	void ConvertToComponentSpace(FPoseContext& Output, FComponentSpacePoseContext& CS_Output);
+
 public: 
 	// FAnimNode_Base
 	virtual bool NeedsOnInitializeAnimInstance() const override { return true; } 
@@ -47,5 +47,6 @@ protected:
 	virtual void UpdateAssetPlayer(const FAnimationUpdateContext& Context) override;
 	virtual USkeleton* GetNodeSkeleton() override;
 	
+	virtual void GatherPoseDatabaseSources(FPoseMatchDatabaseKey& OutKey) const override;
 	virtual int32 GetMinimaCostPoseId(const TArray<float>* InCurrentPoseArray) override;
 };
\ No newline at end of file
@@ -5,33 +5,12 @@
 #include "CoreMinimal.h"
 #include "AnimNode_MotionRecorder.h"
 #include "Data/CalibrationData.h"
+#include "Data/MirrorBoneMap.h"
+#include "Data/PoseMatchDatabase.h"
 #include "Animation/AnimInstanceProxy.h"
 #include "Animation/AnimNode_SequencePlayer.h"
 #include "AnimNode_PoseMatchBase.generated.h"
 
-USTRUCT(BlueprintInternalUseOnly)
-struct MOTIONSYMPHONY_API FPoseMatchData
-{
-	GENERATED_USTRUCT_BODY()
-
-public:
-	UPROPERTY()
-	int32 PoseId;
-
-	UPROPERTY()
-	int32 AnimId;
-
-	UPROPERTY()
-	bool bMirror;
-
-	UPROPERTY()
-	float Time;
-
-public:
-	FPoseMatchData();
-	FPoseMatchData(int32 InPoseId, int32 InAnimId, float InTime, bool bMirror);
-};
-
 USTRUCT(BlueprintInternalUseOnly)
 struct MOTIONSYMPHONY_API FAnimNode_PoseMatchBase : public FAnimNode_SequencePlayer
 {
@@ -62,35 +41,34 @@ protected:
 	bool bInitPoseSearch;
 	int32 PoseRecorderConfigIndex;
 
-	//Baked poses
+	//Poses baked when the anim blueprint is compiled. These are moved into the shared pose database on initialization
 	UPROPERTY()
 	TArray<FPoseMatchData> Poses;
-
-	UPROPERTY()
-	FCalibrationData FinalCalibration;
 	
 	UPROPERTY()
 	TArray<float> PoseMatrix;
 
+	/** Unique to each bake so that all instances of the same anim blueprint share one pose database */
 	UPROPERTY()
-	FCalibrationData StandardDeviation;
+	FGuid PoseBakeId;
+
+	/** The poses, pose matrix and weights searched at runtime, shared with every other instance of this node */
+	TSharedPtr<const FPoseMatchDatabase, ESPMode::ThreadSafe> PoseDatabase;
 
 	//Pose Data extracted from Motion Recorder
 
 	//The chosen animation data
-	FPoseMatchData* MatchPose;
+	const FPoseMatchData* MatchPose;
 	int32 MatchPoseIndex;
 
 	FAnimInstanceProxy* AnimInstanceProxy;
 
 private:
+	UPROPERTY()
 	bool bIsDirtyForPreProcess;
 	
-	//Compact pose format of mirror bone map
-	TCustomBoneIndexArray<FCompactPoseBoneIndex, FCompactPoseBoneIndex> CompactPoseMirrorBones;
-
-	//Pre-calculated component space to reference pose, which allows mirror to work with any joint orientation
-	TCustomBoneIndexArray<FQuat, FCompactPoseBoneIndex> ComponentSpaceRefRotations;
+	//Compact pose mirror bone map and reference rotations for the current LOD, shared with other node instances
+	TSharedPtr<const FMirrorBoneMap, ESPMode::ThreadSafe> MirrorBoneMap;
 
 public:
 	FAnimNode_PoseMatchBase();
@@ -100,13 +78,20 @@ public:
 	virtual void InitializeData();
 
 protected:
+	/** Adds the assets that the poses of this node are generated from to the pose database key */
+	virtual void GatherPoseDatabaseSources(FPoseMatchDatabaseKey& OutKey) const;
 	virtual void InitializePoseMatrix(const int32 TotalPoseCount);
 	virtual void PreProcessAnimation(UAnimSequence* Anim, int32 AnimIndex, bool bMirror = false);
 	virtual void FindMatchPose(const FAnimationUpdateContext& Context); 
 	virtual UAnimSequenceBase*	FindActiveAnim();
 	virtual int32 GetMinimaCostPoseId(const TArray<float>* InCurrentPoseArray);
+
+	/** Finds the lowest cost pose between the start and end pose (inclusive) using the bounds of the pose database to
+	 * skip blocks of poses that cannot beat the best pose found so far */
 	int32 GetMinimaCostPoseId(const TArray<float>& InCurrentPoseArray, float& OutCost, int32 InStartPoseId, int32 InEndPoseId);
-	float ComputeSinglePoseCost(const TArray<float>& InCurrentPoseArray, const int32 InPoseIndex);
+
+	/** Cost of a single pose. Returns a partial cost (at least InCostLimit) as soon as the cost limit is reached. */
+	float ComputeSinglePoseCost(const TArray<float>& InCurrentPoseArray, const int32 InPoseIndex, const float InCostLimit = UE_MAX_FLT);
 
 	int32 ComputePoseCountForSingleAnimation(TObjectPtr<UAnimSequence> Anim) const;
 	
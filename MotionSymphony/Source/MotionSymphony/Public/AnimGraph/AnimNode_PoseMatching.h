@@ -15,4 +15,7 @@ public:
 
 	virtual UAnimSequenceBase* FindActiveAnim() override;
 	virtual void PreProcess() override;
+
+protected:
+	virtual void GatherPoseDatabaseSources(FPoseMatchDatabaseKey& OutKey) const override;
 };
\ No newline at end of file
@@ -59,6 +59,54 @@ public:
 	FTransitionAnimData(const FTransitionAnimData& CopyTransition, bool bInMirror = false);
 };
 
+/** Bins transitions by the yaw of their current and desired move directions so that a transition search only needs to
+ * score the transitions in the query's neighbouring bins. Transitions with no horizontal move direction (e.g. starting
+ * from idle) go into an additional 'still' bin on that axis which is always searched. Candidate indices address the
+ * transitions first and then the mirrored transitions (i.e. mirrored index + transition count). */
+USTRUCT()
+struct MOTIONSYMPHONY_API FTransitionDirectionIndex
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY()
+	int32 BucketCount;
+
+	UPROPERTY()
+	int32 TransitionCount;
+
+	UPROPERTY()
+	int32 MirroredTransitionCount;
+
+	/** Offset of each cell into CellEntries (one extra at the end). Cells are indexed by current bucket then desired bucket */
+	UPROPERTY()
+	TArray<int32> CellStarts;
+
+	UPROPERTY()
+	TArray<int32> CellEntries;
+
+	/** Moves shorter than this (horizontally) are considered to have no direction */
+	static constexpr float StillMoveThreshold = 0.1f;
+
+public:
+	FTransitionDirectionIndex();
+
+	void Build(const TArray<FTransitionAnimData>& InTransitions, const TArray<FTransitionAnimData>& InMirroredTransitions,
+		const int32 InBucketCount);
+	bool IsBuiltFor(const int32 InTransitionCount, const int32 InMirroredTransitionCount, const int32 InBucketCount) const;
+
+	/** Adds the candidate indices of every transition in the neighbouring bins of the passed move directions. The
+	 * output is not sorted and may be empty if there are no transitions near those directions. */
+	void GatherCandidates(const FVector& InCurrentMove, const FVector& InDesiredMove, const bool bInIncludeMirrored,
+		TArray<int32>& OutCandidates) const;
+
+	/** Returns the yaw bucket of a move direction or BucketCount if the move has no horizontal direction */
+	int32 FindBucket(const FVector& InMove) const;
+
+private:
+	int32 GetCellIndex(const int32 InCurrentBucket, const int32 InDesiredBucket) const;
+};
+
 USTRUCT(BlueprintInternalUseOnly)
 struct MOTIONSYMPHONY_API FAnimNode_TransitionMatching : public FAnimNode_PoseMatchBase
 {
@@ -86,6 +134,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = TransitionSettings)
 	float EndDirectionWeight;
 
+	/** The number of yaw bins per move direction used to index transitions. Only transitions in the bins neighbouring
+	 * the current and desired move vectors are searched, so more bins search fewer transitions but tolerate less error
+	 * between the authored and actual move directions **/
+	UPROPERTY(EditAnywhere, Category = TransitionSettings, meta = (ClampMin = 4, ClampMax = 32))
+	int32 DirectionBucketCount;
+
 	/** A list of animations as well as their transition data **/
 	UPROPERTY(EditAnywhere, Category = Animation)
 	TArray<FTransitionAnimData> TransitionAnimData;
@@ -105,8 +159,14 @@ public:
 protected:
 	UPROPERTY()
 	TArray<FTransitionAnimData> MirroredTransitionAnimData;
+
+	UPROPERTY()
+	FTransitionDirectionIndex DirectionIndex;
 	
 	FDistanceMatchingModule* MatchDistanceModule;
+
+	//Transitions (candidate indices) to search on this pose search. Kept to avoid allocating on every search
+	TArray<int32> TransitionCandidates;
 	
 public:
 	FAnimNode_TransitionMatching();
@@ -132,5 +192,16 @@ protected:
 
 	int32 GetAnimationIndex(UAnimSequence* AnimSequence);
 
+	/** Fills TransitionCandidates (in ascending order) with the transitions near the current and desired move vectors,
+	 * or with every transition if the index has none nearby */
+	void GatherTransitionCandidates();
+	FTransitionAnimData& GetCandidateTransition(const int32 InCandidateIndex);
+	float ComputeTransitionDirectionCost(const FTransitionAnimData& InTransitionData) const;
+
+	/** Returns the transition with the lowest direction cost (including its cost multiplier) out of the candidates */
+	FTransitionAnimData* FindMinimaCostTransition();
+
+	virtual void GatherPoseDatabaseSources(FPoseMatchDatabaseKey& OutKey) const override;
+
 	virtual USkeleton* GetNodeSkeleton() override;
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Components/ActorComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Enumerations/EDistanceMatchingEnums.h"
+#include "Data/DistanceTimeLookupTable.h"
 #include "DistanceMatching.generated.h"
 
 USTRUCT(BlueprintInternalUseOnly)
@@ -18,14 +19,19 @@ public:
 	UAnimSequenceBase* AnimSequence;
 
 private:
-	int32 LastKeyChecked;
-	float MaxDistance;
-	TArray<FRichCurveKey> CurveKeys;
+	FName CurveName;
+	bool bLookupNegated;
+
+	/** Baked distance to time lookup, shared with every other module using the same sequence and curve */
+	TSharedPtr<const FDistanceTimeLookupTable, ESPMode::ThreadSafe> LookupTable;
 	
 public:
 	FDistanceMatchingModule();
-	void Setup(UAnimSequenceBase* InAnimSequence, const FName& DistanceCurveName);
+	void Setup(UAnimSequenceBase* InAnimSequence, const FName& DistanceCurveName, const bool bNegateCurve = false);
 	void Initialize();
+
+	/** Returns the time in the animation matching the desired distance or -1 if it cannot be matched. The lookup is
+	 * re-acquired if bNegateCurve differs from the one passed to Setup. */
 	float FindMatchingTime(float DesiredDistance, bool bNegateCurve);
 
 };
@@ -0,0 +1,65 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Objects/Assets/MotionMatchConfig.h"
+#include "MotionInputProvider.generated.h"
+
+class UMatchFeatureBase;
+
+/** A native source of motion matching input data. The objects that each input response feature sources its data from
+ * are resolved once at BeginPlay. Every tick the provider writes the input response features into its input buffer on
+ * the game thread, after its sources and before the skeletal meshes of the owner tick, without running the
+ * 'ConstructMotionInputFeatureArray' blueprint node or looking up components. The motion matching node only copies the
+ * buffer during the animation update. Enable 'Use Input Provider' on the motion matching node to use it. */
+UCLASS(BlueprintType, Category = "Motion Matching", meta = (BlueprintSpawnableComponent))
+class MOTIONSYMPHONY_API UMotionInputProvider : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** The motion match config whose input response features are provided. This must match the config used by the
+	 * motion data on the motion matching node.*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Settings)
+	TObjectPtr<UMotionMatchConfig> MotionMatchConfig;
+
+private:
+	/** The input source of each input response feature, index aligned with InputFeatures. May contain nulls */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UObject>> InputSources;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMatchFeatureBase>> InputFeatures;
+
+	TArray<int32> InputFeatureOffsets;
+	int32 ResponseDimensionCount;
+	bool bInputSourcesResolved;
+
+	/** The input response features written on the last tick */
+	TArray<float> InputBuffer;
+
+	/** Incremented every time the input buffer is written. Zero until the first write */
+	uint32 InputSequence;
+
+public:
+	UMotionInputProvider();
+
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Finds the input source of every input response feature. This is done automatically at BeginPlay but should be
+	 * called again if any of the source components are added or replaced at runtime. */
+	UFUNCTION(BlueprintCallable, Category = "MotionMatching/Input")
+	void ResolveInputSources();
+
+	/** Copies the input buffer into the start of OutDesiredInputArray if it has been written since InOutSequence, then
+	 * updates InOutSequence. The array must already be sized to at least GetResponseDimensionCount() as it will not be
+	 * resized. Only reads state written on the game thread before the owner's skeletal meshes tick, so it is safe to
+	 * call during the animation update. Returns false if nothing was copied. */
+	bool CopyInputArray(TArray<float>& OutDesiredInputArray, uint32& InOutSequence) const;
+
+	int32 GetResponseDimensionCount() const;
+	bool IsReady() const;
+};
@@ -4,9 +4,34 @@
 
 #include "CoreMinimal.h"
 #include "Components/TrajectoryGenerator_Base.h"
+#include "Data/PathArcLengthCache.h"
+#include "NavigationData.h"
 #include "Enumerations/EMotionMatchingEnums.h"
 #include "TrajectoryGenerator.generated.h"
 
+/** Character movement state sampled on the game thread for the capsule trajectory model so that the prediction itself
+ * can be solved on any thread */
+struct MOTIONSYMPHONY_API FTrajectoryCapsuleInput
+{
+public:
+	FVector Velocity;
+	FVector Acceleration;
+	float Friction;
+	float BrakingDeceleration;
+	float MaxSpeed;
+
+	float StartYaw;
+	float DesiredYaw;
+	float MaxYawStep;
+	bool bOrientRotationToMovement;
+
+	/** The time between two trajectory samples (1 / SampleRate) */
+	float SampleInterval;
+
+public:
+	FTrajectoryCapsuleInput();
+};
+
 /**
  * 
  */
@@ -34,7 +59,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviour")
 	bool bResetDirectionOnIdle;
 
-	/** Option of spring based trajectory model or based on UE5 CharacterMovement*/
+	/** Option of spring based trajectory model or based on UE5 CharacterMovement. The critically damped spring is
+	 * evaluated in closed form from the current and desired velocity so it keeps no prediction state between frames
+	 * and does not depend on frame rate. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviour")
 	ETrajectoryModel TrajectoryModel;
 
@@ -44,6 +71,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviour")
 	ETrajectoryControlMode TrajectoryControlMode;
 
+	/** If true, this generator does not tick on its own. Instead, the trajectory prediction subsystem updates it
+	 * together with every other batched generator in the world, in a single parallel pass after movement has run. Use
+	 * this for large crowds. Generators of native subclasses are left on their own tick unless the subclass reports
+	 * that it supports batched prediction. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+	bool bUseBatchedPrediction;
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Behaviour")
 	bool bUsePathAsTrajectoryForAI = false;
@@ -57,24 +91,58 @@ private:
 
 	class UCharacterMovementComponent* CharacterMovement;
 
+	/** Arc length parametrisation of the AI path that is being followed. Rebuilt when the path changes */
+	FPathArcLengthCache PathArcLengthCache;
+	FNavPathWeakPtr CachedPath;
+	FDelegateHandle CachedPathObserverHandle;
+	bool bPathArcLengthCacheDirty;
+
 public:
 	UTrajectoryGenerator();
 
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Solves the capsule trajectory model for a sampled movement state. Positions are written relative to the start
+	 * location and rotations as absolute yaw, starting from index 1. Safe to call from any thread. */
+	static void SolveCapsulePrediction(const FTrajectoryCapsuleInput& InInput, FVector* OutPositions, float* OutRotations,
+		const int32 InIterations);
+
 protected:
 	virtual void UpdatePrediction(float DeltaTime) override;
 	virtual void PathFollowPrediction(const float DeltaTime, const int32 Iterations, const FVector& DesiredLinearDisplacement);
 	virtual void InputPrediction(const float DeltaTime, const FVector& DesiredLinearDisplacement);
+	virtual void CriticallyDampedSpringPrediction(const FVector& DesiredLinearDisplacement);
 	virtual void CapsulePrediction(const float DeltaTime);
 	virtual void Setup(TArray<float>& TrajTimes) override;
 	virtual bool IsValidToUpdatePrediction() override;
 
+	/** Whether the batched pass of the trajectory prediction subsystem reproduces this generator's prediction. The
+	 * batched pass does not call UpdatePrediction, InputPrediction or CapsulePrediction, so this is false for native
+	 * subclasses which may override them. Subclasses that keep the built-in prediction can return true. */
+	virtual bool SupportsBatchedPrediction() const;
+
 	UFUNCTION(BlueprintCallable, Category = "MotionSymphony|TrajectoryGenerator")
 	void SetStrafeDirectionFromCamera(UCameraComponent* Camera);
 
 private:
+	bool UsesPathFollowPrediction() const;
+	void CalculateDesiredLinearDisplacement(FVector& OutDisplacement);
 	void CalculateDesiredLinearVelocity(FVector& OutVelocity);
+	float CalculateDesiredOrientation(const FVector& DesiredLinearDisplacement);
+	bool GatherCapsuleInput(const float DeltaTime, FTrajectoryCapsuleInput& OutInput) const;
 	void CalculateInputVectorFromAINavAgent();
 
+	/** Rebuilds the path arc length cache if the followed path has been replaced or updated since it was built */
+	void UpdatePathArcLengthCache(const FNavPathSharedPtr& InPath);
+	void ReleaseCachedPath();
+	void OnCachedPathEvent(FNavigationPath* InPath, ENavPathEvent::Type InEvent);
+
+	/** Completes an update run by the trajectory prediction subsystem once the prediction has been written back */
+	void FinishBatchedPrediction(float DeltaTime);
+
+	friend class UTrajectoryPredictionSubsystem;
+
 #if WITH_EDITOR
 	virtual void DebugDrawTrajectory(const float InDeltaTime) override;
 #endif
@@ -7,12 +7,42 @@
 #include "Objects/Assets/MotionMatchConfig.h"
 #include "Data/Trajectory.h"
 #include "Data/InputProfile.h"
+#include "Data/PastTrajectoryBuffer.h"
 #include "GameFramework/NavMovementComponent.h"
+#include "WorldCollision.h"
 #include "TrajectoryGenerator_Base.generated.h"
 
 enum class ETrajectoryControlMode : uint8;
 class UCameraComponent;
 
+/** A blocking surface found by a trajectory collision trace. Predicted points on the wrong side of it are slid back
+ * onto it, but only within the stretch of surface that the blocked segment actually swept against. */
+struct FTrajectoryCollisionPlane
+{
+public:
+	/** World location of the swept sphere centre at the time of the hit */
+	FVector Location;
+
+	/** Horizontal normal of the blocking surface */
+	FVector Normal;
+
+	/** Horizontal direction along the blocking surface */
+	FVector Tangent;
+
+	/** Distance either side of Location (along the tangent) that the surface is known to block */
+	float HalfWidth;
+
+	/** The trajectory segment that was blocked. Only points from this segment onwards are clipped */
+	int32 SegmentIndex;
+
+public:
+	FTrajectoryCollisionPlane(const FVector& InLocation, const FVector& InNormal, const float InHalfWidth,
+		const int32 InSegmentIndex);
+
+	/** Slides a world position that is behind the known stretch of surface back onto it */
+	void Clip(FVector& InOutPosition) const;
+};
+
 UCLASS(BlueprintType, Category = "Motion Matching", meta = (BlueprintSpawnableComponent))
 class MOTIONSYMPHONY_API UTrajectoryGenerator_Base : public UActorComponent
 {
@@ -40,6 +70,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Debug)
 	FVector2D DebugTimeIntervalRange;
 
+	/** If true, the predicted trajectory is clipped and slid against blocking collision so that poses running into
+	 * walls are not picked. Segment traces are issued asynchronously and their results are applied the next frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
+	bool bEnableTrajectoryCollision;
+
+	/** The collision channel that the predicted trajectory segments are swept against */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision", meta = (EditCondition = "bEnableTrajectoryCollision"))
+	TEnumAsByte<ECollisionChannel> TrajectoryCollisionChannel;
+
+	/** The radius of the sphere swept along each predicted trajectory segment */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision", meta = (EditCondition = "bEnableTrajectoryCollision", ClampMin = 0.0f))
+	float TrajectoryCollisionRadius;
+
 #if WITH_EDITORONLY_DATA
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	bool bDrawTrajectory = false;
@@ -56,9 +99,7 @@ protected:
 	//Past Trajectory
 	float MaxRecordTime;
 	float TimeSinceLastRecord;
-	TArray<FVector> RecordedPastPositions;
-	TArray<float> RecordedPastRotations;
-	TArray<float> RecordedPastTimes;
+	FPastTrajectoryBuffer RecordedPastTrajectory;
 	float CumActiveTime;
 
 	//Tracking
@@ -87,6 +128,15 @@ private:
 	bool bExtractedThisFrame;
 	FTransform CacheCharacterTransform;
 
+	/** Async sweeps issued for the last prediction, one per future trajectory segment */
+	TArray<FTraceHandle> PendingCollisionTraces;
+
+	/** The swept start and end (world space) of each pending trace */
+	TArray<FVector> PendingCollisionSegments;
+
+	/** Blocking surfaces from the last completed collision traces */
+	TArray<FTrajectoryCollisionPlane> CollisionPlanes;
+
 	USkeletalMeshComponent* SkelMeshComponent;
 	
 public:	
@@ -145,7 +195,21 @@ public:
 	virtual void BeginPlay() override;
 
 protected:
+	/** Caches the character transform, records the past trajectory and applies debug input ahead of the prediction.
+	 * Returns false if the trajectory cannot be updated this frame. */
+	bool PrepareTrajectoryUpdate(float DeltaTime);
+
+	/** Builds the trajectory from the recorded past and the predicted future once the prediction has been updated */
+	void FinalizeTrajectoryUpdate();
+
+	/** Reads back the collision traces issued last frame and issues traces along the new (un-clipped) prediction.
+	 * Never blocks on the traces. The prediction itself is left untouched, clipping is applied on extraction. */
+	void UpdateTrajectoryCollision();
+	
 	void RecordPastTrajectory(float DeltaTime);
+
+	/** Returns the index of the predicted trajectory point that is extracted for a future trajectory time */
+	int32 GetFutureSampleIndex(const float TimeDelay) const;
 	virtual void UpdatePrediction(float DeltaTime);
 	virtual void ApplyDebugInput(float DeltaTime);
 
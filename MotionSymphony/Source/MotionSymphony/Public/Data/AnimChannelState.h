@@ -7,6 +7,7 @@
 #include "Enumerations/EMotionMatchingEnums.h"
 #include "MotionSymphony.h"
 #include "Animation/AnimationAsset.h"
+#include "Animation/AnimNotifyQueue.h"
 #include "AnimChannelState.generated.h"
 
 /** A data structure for tracking animation channels within a motion matching animation stack. 
@@ -58,6 +59,15 @@ public:
 	UPROPERTY()
 	float AnimLength;
 
+	/** If true, root motion for this channel is advanced from the motion data's baked root motion table rather than
+	 * extracted from the animation */
+	UPROPERTY()
+	bool bUseBakedRootMotion;
+
+	/** If true, no notifies are gathered when this channel is ticked */
+	UPROPERTY()
+	bool bSkipNotifies;
+
 	/** Blend sample data cache used for blend spaces*/
 	TArray<FBlendSampleData> BlendSampleDataCache;
 
@@ -65,6 +75,10 @@ public:
 	UPROPERTY();
 	int32 CachedTriangulationIndex;
 
+	/** Reusable buffer that notifies are gathered into when this channel is ticked so that no array has to be
+	 * allocated per tick */
+	TArray<FAnimNotifyEventReference> NotifyScratch;
+
 public:
 	void Update(const float DeltaTime, const float NodePlayRate);
 
@@ -0,0 +1,64 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAnimSequenceBase;
+struct FAnimNotifyEvent;
+struct FAnimNotifyEventReference;
+
+/** The trigger interval of a single notify within a source animation */
+struct MOTIONSYMPHONY_API FAnimNotifyInterval
+{
+public:
+	float StartTime;
+	float EndTime;
+
+	/** Index of the notify in the source animation's Notifies array */
+	int32 NotifyIndex;
+
+	/** True for notify states (which trigger while overlapped) and false for notifies (which trigger when passed) */
+	bool bIsState;
+
+public:
+	FAnimNotifyInterval();
+	FAnimNotifyInterval(const float InStartTime, const float InEndTime, const int32 InNotifyIndex, const bool bInIsState);
+};
+
+/** The notify intervals of a single source animation sorted by start time. Notify gathering for a time range is a
+ * binary search for the range followed by a scan of the notifies within it, plus notify states that started up to
+ * MaxStateDuration earlier. This replaces the engine's linear walk of every notify and writes directly into the
+ * caller's buffer so that no temporary notify context has to be allocated and copied every tick. */
+struct MOTIONSYMPHONY_API FAnimNotifyIndex
+{
+public:
+	TArray<FAnimNotifyInterval> Intervals;
+
+	/** The longest notify state duration. Bounds how far before a time range an overlapping state can start */
+	float MaxStateDuration;
+
+	/** Number of notifies on the source animation when the index was built. Used to detect stale indices */
+	int32 SourceNotifyCount;
+
+	/** Hash of the trigger times, durations and types of the source notifies when the index was built. Notifies can
+	 * only be moved, retimed or replaced in the editor so this is only compared there. */
+	uint32 SourceNotifyHash;
+
+public:
+	FAnimNotifyIndex();
+	FAnimNotifyIndex(const UAnimSequenceBase* InSourceAnim);
+
+	bool IsValidFor(const UAnimSequenceBase* InSourceAnim) const;
+
+	/** Appends the notifies triggered by playing SourceAnim from StartTime for DeltaTime, wrapping around the end
+	 * of the animation if it loops. Matches the results of UAnimSequenceBase::GetAnimNotifies */
+	void GetAnimNotifies(const UAnimSequenceBase* InSourceAnim, const float StartTime, const float DeltaTime,
+		const bool bLooping, TArray<FAnimNotifyEventReference>& OutNotifies) const;
+
+private:
+	static uint32 HashNotifies(const TArray<FAnimNotifyEvent>& InNotifies);
+
+	void GetAnimNotifiesFromDeltaPositions(const UAnimSequenceBase* InSourceAnim, const float PreviousPosition,
+		const float CurrentPosition, TArray<FAnimNotifyEventReference>& OutNotifies) const;
+};
@@ -13,6 +13,24 @@ class UMotionDataAsset;
 class UMotionMatchConfig;
 class UMotionCalibration;
 
+/** Running mean and summed squared distance to the mean for every atom of a pose. Samples are streamed in with
+ * Welford's method and independent accumulators (e.g. filled on separate threads) can be merged afterwards so that
+ * the pose matrix only has to be read once when generating standard deviations. */
+struct MOTIONSYMPHONY_API FStandardDeviationAccumulator
+{
+public:
+	int32 Count;
+	TArray<double> Mean;
+	TArray<double> DistToMeanSqr;
+
+public:
+	FStandardDeviationAccumulator();
+	FStandardDeviationAccumulator(const int32 AtomCount);
+
+	void AddSample(const float* Atoms);
+	void Merge(const FStandardDeviationAccumulator& Other);
+};
+
 /** A data structure containing weightings and multipliers for specific motion
 matching aspects. Motion Matching distance costs are multiplied by these 
 weights where relevant to calibrate the animation data.*/
@@ -38,4 +56,12 @@ public:
 	void GenerateStandardDeviationWeights(const UMotionDataAsset* SourceMotionData, const FGameplayTagContainer& MotionTags);
 	void GenerateStandardDeviationWeights(const TArray<float>& PoseMatrix, UMotionMatchConfig* InMMConfig);
 	void GenerateFinalWeights(UMotionMatchConfig* MotionMatchConfig, const FCalibrationData& StdDeviationNormalizers);
+
+	/** Generates the standard deviation weights for every motion tag set in a single parallel pass over the lookup
+	 * pose matrix. OutCalibrationSets is resized to match MotionTagSets and is indexed the same way. */
+	static void GenerateStandardDeviationWeights(const UMotionDataAsset* SourceMotionData,
+		const TArray<FGameplayTagContainer>& MotionTagSets, TArray<FCalibrationData>& OutCalibrationSets);
+
+private:
+	void GenerateWeightsFromAccumulator(const FStandardDeviationAccumulator& Accumulator, UMotionMatchConfig* InMMConfig);
 };
\ No newline at end of file
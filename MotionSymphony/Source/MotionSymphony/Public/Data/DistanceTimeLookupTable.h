@@ -0,0 +1,45 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+
+class UAnimSequenceBase;
+
+/** A distance matching curve baked into a distance to time table sampled at uniform distance intervals so that the
+ * time for a distance is found with a single interpolated lookup instead of a scan over the curve keys. Tables only
+ * depend on the sequence, the curve keys and whether it is negated so they are shared between every distance matching
+ * module using the same combination. Acquire one with FindOrCreate. */
+struct MOTIONSYMPHONY_API FDistanceTimeLookupTable
+{
+private:
+	/** The matching time at MinDistance + i * DistanceStep */
+	TArray<float> Times;
+
+	float MinDistance;
+	float DistanceStep;
+	float InvDistanceStep;
+
+	/** The largest absolute distance on the curve. Distances further than this cannot be matched */
+	float MaxAbsDistance;
+
+	/** The time of the last curve key. Returned for distances below every value on the curve */
+	float EndTime;
+
+public:
+	FDistanceTimeLookupTable();
+
+	/** Returns the shared table for the current keys of the curve on this sequence, baking it if no module currently
+	 * holds it. A curve that has been edited since a table was baked gets a new table. Returns nullptr if the curve
+	 * could not be found or has fewer than two keys. */
+	static TSharedPtr<const FDistanceTimeLookupTable, ESPMode::ThreadSafe> FindOrCreate(const UAnimSequenceBase* InAnimSequence,
+		const FName& InDistanceCurveName, const bool bInNegateCurve);
+
+	/** Returns the time in the animation at which the (optionally negated) curve first reaches the desired distance,
+	 * interpolated between keys, or -1 if the distance is beyond the curve. */
+	float FindMatchingTime(const float InDesiredDistance) const;
+
+private:
+	void Build(const TArray<FRichCurveKey>& InCurveKeys, const bool bInNegateCurve);
+};
@@ -0,0 +1,37 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BoneContainer.h"
+#include "BoneIndices.h"
+#include "Templates/SharedPointer.h"
+
+class UMirrorDataTable;
+
+/** The compact pose mirror bone map and component space reference rotations of a mirror table for a specific set of
+ * required bones (i.e. a mesh LOD). These only depend on the mirror table, the bone container asset and its required
+ * bones so they are built once and shared (reference counted) between every node instance that mirrors that LOD.
+ * Acquire it with FindOrCreate, typically from CacheBones. */
+struct MOTIONSYMPHONY_API FMirrorBoneMap
+{
+public:
+	/** Compact pose format of mirror bone map */
+	TCustomBoneIndexArray<FCompactPoseBoneIndex, FCompactPoseBoneIndex> CompactPoseMirrorBones;
+
+	/** Pre-calculated component space to reference pose, which allows mirror to work with any joint orientation */
+	TCustomBoneIndexArray<FQuat, FCompactPoseBoneIndex> ComponentSpaceRefRotations;
+
+private:
+	/** The required bone indices this map was built for. Used to tell LODs of the same asset apart */
+	TArray<FBoneIndexType> RequiredBoneIndices;
+
+public:
+	/** Returns the shared mirror bone map for this mirror table and bone container, building it if no node currently
+	 * holds one for the same LOD. Returns nullptr if there is no mirror table or the bone container is invalid. */
+	static TSharedPtr<const FMirrorBoneMap, ESPMode::ThreadSafe> FindOrCreate(const UMirrorDataTable* InMirrorDataTable,
+		const FBoneContainer& BoneContainer);
+
+	/** True if this map was built for the required bones of the passed bone container */
+	bool IsValidFor(const FBoneContainer& BoneContainer) const;
+};
@@ -0,0 +1,57 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/ObjectKey.h"
+
+class UMotionDataAsset;
+class UMotionMatchConfig;
+class UMotionCalibration;
+
+/** Search calibration data that only depends on the motion data, its config and the user calibration. It is built once
+ * and shared (reference counted) between every motion matching node instance using the same combination of assets
+ * instead of each node generating and folding its own copy. Acquire it with FindOrCreate. */
+struct MOTIONSYMPHONY_API FMotionMatchingRuntimeData
+{
+public:
+	/** Final weights per motion tag set (indexed like FeatureStandardDeviations) with the user calibration folded in.
+	 * Only the node's quality vs responsiveness override still needs to be applied on top. */
+	TArray<TArray<float>> CalibrationSets;
+
+	/** The same weights as CalibrationSets permuted by the runtime mirror atom map so that a mirrored query can be
+	 * compared against un-mirrored poses. Empty if the motion data does not use runtime mirroring. */
+	TArray<TArray<float>> MirroredCalibrationSets;
+
+	/** One bit per atom (excluding the cost multiplier). Set if the atom belongs to a quality feature and cleared if
+	 * it belongs to a responsiveness feature. Mirror counterparts always share a category so this applies to both. */
+	TBitArray<> QualityAtomMask;
+
+private:
+	FObjectKey MotionDataKey;
+	FObjectKey MotionMatchConfigKey;
+	FObjectKey UserCalibrationKey;
+
+	/** Set when one of the source assets has changed since this data was built. Nodes still holding it re-acquire. */
+	TAtomic<bool> bStale;
+
+public:
+	FMotionMatchingRuntimeData();
+
+	/** Returns the shared runtime data for this combination of assets, building it if no node currently holds it.
+	 * Returns nullptr if the motion data has not been processed or does not match its config. */
+	static TSharedPtr<const FMotionMatchingRuntimeData, ESPMode::ThreadSafe> FindOrCreate(const UMotionDataAsset* InMotionData,
+		const UMotionCalibration* InUserCalibration);
+
+	/** Marks all shared runtime data built from the passed asset as stale and removes it from the registry. Called
+	 * whenever motion data is re-processed or a user calibration changes its adjusted weights. */
+	static void Invalidate(const UObject* InSourceAsset);
+
+	bool IsStale() const { return bStale; }
+	bool IsBuiltFrom(const UMotionDataAsset* InMotionData, const UMotionCalibration* InUserCalibration) const;
+
+private:
+	void Build(const UMotionDataAsset* InMotionData, const UMotionCalibration* InUserCalibration);
+};
@@ -0,0 +1,52 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A single recorded point of the past trajectory in world space */
+struct MOTIONSYMPHONY_API FPastTrajectorySample
+{
+public:
+	FVector Position;
+	float RotationZ;
+	float Time;
+
+public:
+	FPastTrajectorySample();
+	FPastTrajectorySample(const FVector& InPosition, const float InRotationZ, const float InTime);
+};
+
+/** Fixed capacity ring buffer of past trajectory samples. Recording overwrites the oldest sample instead of shifting
+ * the history and, because samples are recorded with increasing time, a past time can be found with a binary search.
+ * Samples are indexed chronologically, from the oldest (0) to the newest (Num() - 1). */
+struct MOTIONSYMPHONY_API FPastTrajectoryBuffer
+{
+private:
+	TArray<FPastTrajectorySample> Samples;
+
+	/** Storage index of the oldest sample */
+	int32 Head;
+	int32 Count;
+
+public:
+	FPastTrajectoryBuffer();
+
+	/** Allocates the buffer and clears any recorded samples */
+	void Initialize(const int32 InCapacity);
+
+	/** Records a sample that must be newer than every sample already recorded, overwriting the oldest when full */
+	void Record(const FVector& InPosition, const float InRotationZ, const float InTime);
+
+	int32 Num() const { return Count; }
+	int32 Capacity() const { return Samples.Num(); }
+	const FPastTrajectorySample& operator[](const int32 Index) const;
+
+	/** Returns the chronological index of the newest sample recorded strictly before InTime or INDEX_NONE if there is none */
+	int32 FindSampleBefore(const float InTime) const;
+
+	/** Interpolates the position and facing at InTime between the samples surrounding it. Times newer than the last
+	 * sample are extrapolated from the last two samples and times older than the first sample are clamped to it.
+	 * Returns false if no samples have been recorded. */
+	bool SampleAtTime(const float InTime, FVector& OutPosition, float& OutRotationZ) const;
+};
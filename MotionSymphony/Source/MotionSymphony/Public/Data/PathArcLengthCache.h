@@ -0,0 +1,44 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FNavPathPoint;
+
+/** Cumulative arc length parametrisation of a navigation path. It is built once per path and then sampled by arc
+ * length with a cursor that only moves forward, so sampling a trajectory costs the same regardless of how many
+ * points the path has. */
+struct MOTIONSYMPHONY_API FPathArcLengthCache
+{
+private:
+	TArray<FVector> Points;
+
+	/** Arc length from the first path point to each path point */
+	TArray<float> CumulativeLengths;
+
+	/** Direction and yaw of the segment starting at each path point */
+	TArray<FVector> SegmentDirections;
+	TArray<float> SegmentYaws;
+
+	/** The segment that the last sample was found on */
+	int32 Cursor;
+
+public:
+	FPathArcLengthCache();
+
+	/** Rebuilds the parametrisation from the path points */
+	void Build(const TArray<FNavPathPoint>& InPathPoints);
+	void Reset();
+
+	bool IsEmpty() const { return SegmentDirections.Num() == 0; }
+	float GetTotalLength() const { return CumulativeLengths.Num() > 0 ? CumulativeLengths.Last() : 0.0f; }
+
+	/** Returns the arc length of the closest point to InLocation on the segment starting at InSegmentIndex and moves
+	 * the cursor to that segment */
+	float ProjectOntoSegment(const int32 InSegmentIndex, const FVector& InLocation);
+
+	/** Samples the location and yaw at an arc length, which is clamped to the path. Arc lengths passed since the last
+	 * call to ProjectOntoSegment must not decrease. */
+	void SampleForward(const float InArcLength, FVector& OutLocation, float& OutYaw);
+};
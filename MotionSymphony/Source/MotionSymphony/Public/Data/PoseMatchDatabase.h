@@ -0,0 +1,81 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/CalibrationData.h"
+#include "Data/PoseMatrixAABB.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/ObjectKey.h"
+#include "PoseMatchDatabase.generated.h"
+
+class UMotionMatchConfig;
+
+USTRUCT(BlueprintInternalUseOnly)
+struct MOTIONSYMPHONY_API FPoseMatchData
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY()
+	int32 PoseId;
+
+	UPROPERTY()
+	int32 AnimId;
+
+	UPROPERTY()
+	bool bMirror;
+
+	UPROPERTY()
+	float Time;
+
+public:
+	FPoseMatchData();
+	FPoseMatchData(int32 InPoseId, int32 InAnimId, float InTime, bool bMirror);
+};
+
+/** Identifies the pose database of a pose matching node. Nodes baked together (i.e. every instance of the same anim
+ * blueprint) share the bake id. Databases of un-baked nodes (no bake id) are not shared. */
+struct MOTIONSYMPHONY_API FPoseMatchDatabaseKey
+{
+public:
+	FGuid BakeId;
+	TArray<FObjectKey> SourceAssets;
+	float PoseInterval;
+	float PosesEndTime;
+	bool bMirroring;
+
+public:
+	FPoseMatchDatabaseKey();
+
+	bool operator==(const FPoseMatchDatabaseKey& Other) const;
+	friend uint32 GetTypeHash(const FPoseMatchDatabaseKey& Key);
+};
+
+/** The searchable poses of a pose matching node along with their feature normalization and final weights. The poses
+ * are baked into the node when the anim blueprint is compiled. At runtime the first node instance moves its bake into a
+ * database and every other instance with the same key shares it (reference counted) instead of keeping its own copy
+ * and regenerating the weights. Acquire it with FindOrCreate. */
+struct MOTIONSYMPHONY_API FPoseMatchDatabase
+{
+public:
+	TArray<FPoseMatchData> Poses;
+	TArray<float> PoseMatrix;
+	FCalibrationData StandardDeviation;
+	FCalibrationData FinalCalibration;
+
+	/** Per atom bounds of consecutive blocks of poses in the pose matrix. Searches skip any block whose bounds already
+	 * cost more than the best pose found so far (outer blocks first, then the inner blocks within them). */
+	FPoseAABBMatrix PoseAABBMatrix_Outer;
+	FPoseAABBMatrix PoseAABBMatrix_Inner;
+
+	static constexpr int32 OuterAABBSize = 64;
+	static constexpr int32 InnerAABBSize = 16;
+
+public:
+	/** Returns the shared database for the key. If no node currently holds one, InBakeDatabase is called to fill the
+	 * poses and pose matrix of a new database, after which its weights are generated from the pose config. Baking only
+	 * blocks other nodes with the same key. Keys without a bake id always get a new database of their own. */
+	static TSharedPtr<const FPoseMatchDatabase, ESPMode::ThreadSafe> FindOrCreate(const FPoseMatchDatabaseKey& InKey,
+		UMotionMatchConfig* InPoseConfig, TFunctionRef<void(FPoseMatchDatabase&)> InBakeDatabase);
+};
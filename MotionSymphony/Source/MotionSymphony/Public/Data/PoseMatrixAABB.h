@@ -25,4 +25,5 @@ public:
 public:
 	FPoseAABBMatrix();
 	FPoseAABBMatrix(const FPoseMatrix& InSearchMatrix, const int32 InBoxSize);
+	FPoseAABBMatrix(const TArray<float>& InPoseArray, const int32 InAtomCount, const int32 InBoxSize);
 };
@@ -67,4 +67,65 @@ public:
 	// FPoseMotionData& operator += (const FPoseMotionData& rhs);
 	// FPoseMotionData& operator /= (const float rhs);
 	// FPoseMotionData& operator *= (const float rhs);
-};
\ No newline at end of file
+};
+
+/** The root motion of a pose's animation from the pose's time until the next pose of the same sequence (or the end of
+ * the animation). Baked at pre-process so that root motion can be advanced without extracting it from compressed
+ * animation data. It is always taken from the un-mirrored animation and mirrored at runtime like extracted root motion. */
+USTRUCT()
+struct MOTIONSYMPHONY_API FPoseRootMotion
+{
+	GENERATED_BODY()
+
+public:
+	/** Root translation over the pose interval */
+	UPROPERTY()
+	FVector3f Translation;
+
+	/** Root yaw change over the pose interval in degrees */
+	UPROPERTY()
+	float Yaw;
+
+	/** The length of the pose interval in seconds of animation time */
+	UPROPERTY()
+	float Duration;
+
+public:
+	FPoseRootMotion();
+	FPoseRootMotion(const FTransform& InRootMotion, const float InDuration);
+
+	/** Returns the root motion for a fraction of the pose interval, assuming a constant velocity across it */
+	FTransform GetRootMotion(const float Fraction) const;
+};
+
+/** A compact, trivially copyable copy of the pose data that the motion matching node reads every frame. Runtime poses
+ * are built alongside the pose database so that per frame playback never touches the heap allocated motion tags or the
+ * editor facing fields of FPoseMotionData. Motion tags are referenced by their index in the motion data's tag list.*/
+struct MOTIONSYMPHONY_API FRuntimePoseData
+{
+public:
+	int32 PoseId;
+	int32 AnimId;
+	int32 NextPoseId;
+	int32 LastPoseId;
+	float Time;
+	
+	/** The index of this pose's motion tags in the motion data's MotionTagList or INDEX_NONE if it has none */
+	int32 TagSectionIndex;
+
+	/** The number of poses, starting with this one, that play before the end of the animation or a DoNotUse pose is
+	 * reached. Used to decide if a search must be forced without looking ahead through the pose database */
+	int32 UsablePoseCount;
+
+	/** The animation time of the last pose counted in UsablePoseCount. Used instead of the pose count when the motion
+	 * data has variable pose spacing */
+	float UsableEndTime;
+	
+	EMotionAnimAssetType AnimType;
+	EPoseSearchFlag SearchFlag;
+	bool bMirrored;
+
+public:
+	FRuntimePoseData();
+	FRuntimePoseData(const FPoseMotionData& InPose, const int32 InTagSectionIndex);
+};
@@ -30,4 +30,11 @@ enum class EAllAxis : uint8
 	NegX,
 	NegY,
 	NegZ
-};
\ No newline at end of file
+};
+
+UENUM(BlueprintType)
+enum class EPoseSamplingMode : uint8
+{
+	Uniform UMETA(DisplayName = "Uniform"),
+	Adaptive UMETA(DisplayName = "Adaptive")
+};
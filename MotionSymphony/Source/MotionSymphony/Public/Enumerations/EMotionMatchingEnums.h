@@ -42,6 +42,16 @@ enum class ETransitionMethod : uint8
 	Inertialization
 };
 
+/** An enumeration for how much work the motion matching node does each frame. The reduced modes skip bone evaluation
+for characters that only need the chosen pose and its root motion (e.g. on dedicated servers or at far LODs) */
+UENUM(BlueprintType)
+enum class EMotionMatchingPlaybackMode : uint8
+{
+	Full, //Input, search, channel advance and pose evaluation as normal
+	RootMotionOnly, //Input, search and channel advance with baked root motion and notifies. Outputs the reference pose
+	SearchOnly //Input, search and channel advance with baked root motion. No pose evaluation, mirroring or notifies
+};
+
 /** An enumeration for the different methods of determining past trajectory for motion matching */
 UENUM(BlueprintType)
 enum class EPastTrajectoryMode : uint8
@@ -79,7 +89,8 @@ UENUM(BlueprintType)
 enum class ETrajectoryModel : uint8
 {
 	Spring,
-	UECharacterMovement
+	UECharacterMovement,
+	CriticallyDampedSpring
 };
 
 /** An enumeration defining the control modes for the trajectory generator. i.e. whether it is player controlled or AI controlled*/
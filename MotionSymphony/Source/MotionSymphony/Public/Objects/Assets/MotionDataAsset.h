@@ -15,6 +15,7 @@
 #include "Data/MotionAnimAsset.h"
 #include "Objects/Assets/MotionMatchConfig.h"
 #include "Data/PoseMatrix.h"
+#include "Data/AnimNotifyIndex.h"
 #include "MotionDataAsset.generated.h"
 
 class UMotionAnimObject;
@@ -38,6 +39,41 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Motion Matching", meta = (ClampMin = 0.01f, ClampMax = 0.5f))
 	float PoseInterval;
 
+	/** How poses are sampled from the source animations. 'Uniform' keeps a pose every PoseInterval while 'Adaptive'
+	 * only keeps the poses that cannot be reproduced, within AdaptiveSamplingMaxError, by interpolating their neighbours.
+	 * In adaptive mode blend spaces are also only sampled at the grid points that cannot be interpolated from the
+	 * surrounding samples.*/
+	UPROPERTY(EditAnywhere, Category = "Motion Matching|Sampling")
+	EPoseSamplingMode PoseSamplingMode;
+
+	/** The maximum error allowed when a pose is dropped by adaptive sampling. This is measured per atom in standard
+	 * deviations of that atom across the database (0.05 - 0.2 recommended). */
+	UPROPERTY(EditAnywhere, Category = "Motion Matching|Sampling", meta = (ClampMin = 0.0f, ClampMax = 1.0f,
+		EditCondition = "PoseSamplingMode == EPoseSamplingMode::Adaptive"))
+	float AdaptiveSamplingMaxError;
+
+	/** The maximum number of pose intervals that adaptive sampling may span between two kept poses */
+	UPROPERTY(EditAnywhere, Category = "Motion Matching|Sampling", meta = (ClampMin = 1, ClampMax = 20,
+		EditCondition = "PoseSamplingMode == EPoseSamplingMode::Adaptive"))
+	int32 AdaptiveSamplingMaxStride;
+
+	/** Searchable poses closer than this to an already searchable pose (RMS distance in standard deviations per atom)
+	 * are removed from the search matrix but can still be reached as next naturals. Set to 0 to disable pruning. */
+	UPROPERTY(EditAnywhere, Category = "Motion Matching|Pruning", meta = (ClampMin = 0.0f, ClampMax = 1.0f))
+	float RedundantPoseThreshold;
+
+	/** The redundant pose threshold that was used the last time this asset was pre-processed */
+	UPROPERTY(VisibleAnywhere, Category = "Motion Matching|Pruning")
+	float RedundantPoseThresholdUsed;
+
+	/** The number of searchable poses before redundant poses were pruned */
+	UPROPERTY(VisibleAnywhere, Category = "Motion Matching|Pruning")
+	int32 UnprunedSearchPoseCount;
+
+	/** The number of poses that were pruned from the search matrix as redundant */
+	UPROPERTY(VisibleAnywhere, Category = "Motion Matching|Pruning")
+	int32 RedundantPoseCount;
+
 	/** The configuration to use for this motion data asset. This includes the skeleton, trajectory points and 
 	pose joints to match when pre-processing and at runtime. Use the same configuration for this asset as you
 	do on the runtime node.*/
@@ -55,10 +91,22 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Motion Matching|Mirroring")
 	TObjectPtr<UMirrorDataTable> MirrorDataTable = nullptr;
 
+	/** If true, mirrored poses are not baked into the pose database. Only un-mirrored poses are stored along with a
+	 * per-atom mirror map generated from the motion match config, and the search is run a second time with a mirrored
+	 * query. This halves the size of the database for mirrored libraries. Every bone based match feature must have a
+	 * counterpart feature on its mirror bone (e.g. left foot and right foot), otherwise mirrored poses are baked. */
+	UPROPERTY(EditAnywhere, Category = "Motion Matching|Mirroring")
+	bool bMirrorAtRuntime = false;
+
 	/** Has the Motion Data been processed before the last time it's data was changed*/
 	UPROPERTY()
 	bool bIsProcessed;
 
+	/** True if the poses were not recorded at a fixed PoseInterval (i.e. adaptive sampling removed poses). In this case
+	 * pose lookups by time must use the time stored on each pose */
+	UPROPERTY()
+	bool bVariablePoseSpacing;
+
 	/** A list of all source animations used for this MotionData asset along with meta data 
 	related to the animation sequence for pre-processing and runtime purposes.*/
 	UPROPERTY()
@@ -106,11 +154,36 @@ public:
 	about an animation frame within the animation data set.*/
 	UPROPERTY()
 	TArray<FPoseMotionData> Poses;
+
+	/** Root motion of each pose until the next pose in its sequence, index aligned with Poses. Lets root motion be
+	 * advanced without extracting it from animation data (e.g. on dedicated servers or far LODs)*/
+	UPROPERTY()
+	TArray<FPoseRootMotion> PoseRootMotionTable;
 	
 	/** The pose matrix, all pose data represented in a single linear array of floats*/
 	UPROPERTY()
 	FPoseMatrix LookupPoseMatrix;
 
+	/** For runtime mirroring, the atom index that each atom of a mirrored pose is read from. Empty if mirrored poses
+	 * were baked into the pose database instead */
+	UPROPERTY()
+	TArray<int32> MirrorAtomSourceIndices;
+
+	/** For runtime mirroring, the sign applied to each atom of a mirrored pose (-1 for atoms across the mirror plane)*/
+	UPROPERTY()
+	TArray<float> MirrorAtomSigns;
+
+	/** One bit per search pose. Set if the animation that the pose belongs to may be mirrored at runtime */
+	TBitArray<> SearchPoseMirrorMask;
+
+	/** A compact copy of Poses, index aligned with it, that is read by the motion matching node every frame. Built
+	 * along with the search pose matrix */
+	TArray<FRuntimePoseData> RuntimePoses;
+
+	/** Sorted notify intervals for every source sequence and blend space sample, keyed by animation. Built along with
+	 * the search pose matrix so that notify gathering while ticking is a bounded binary search */
+	TMap<const UAnimSequenceBase*, FAnimNotifyIndex> AnimNotifyIndices;
+
 	/** An AABB data structure used to assist with searching through the pose matrix*/
 	UPROPERTY(Transient)
 	FPoseAABBMatrix PoseAABBMatrix_Outer;
@@ -164,6 +237,7 @@ public:
 	void ClearSourceBlendSpaces();
 	void ClearSourceComposites();
 	void GenerateSearchPoseMatrix(); //Generates a pose matrix that can be used for searches
+	void GenerateAnimNotifyIndices();
 
 	//General
 	bool CheckValidForPreProcess() const;
@@ -172,6 +246,12 @@ public:
 	bool IsSetupValid();
 	bool AreSequencesValid();
 	float GetPoseInterval() const;
+	bool HasVariablePoseSpacing() const;
+	bool IsSamePoseSequence(const FPoseMotionData& PoseA, const FPoseMotionData& PoseB) const;
+	int32 GetPoseCountInTimeSpan(const int32 PoseId, const float TimeSpan) const;
+	int32 FindClosestPoseIdInRange(const int32 StartPoseId, const int32 EndPoseId, const float AnimTime) const;
+	void FindPosePairAtTime(const int32 PoseId, const float AnimTime, const float AnimLength,
+		int32& OutBeforePoseId, int32& OutAfterPoseId, float& OutInterpolationValue) const;
 	float GetPoseFavour(const int32 PoseId) const;
 	int32 GetMotionTagIndex(const FGameplayTagContainer& MotionTags) const;
 	int32 GetMotionTagStartPoseIndex(const FGameplayTagContainer& MotionTags) const;
@@ -181,6 +261,16 @@ public:
 	int32 MatrixPoseIdToDatabasePoseId(int32 MatrixPoseId) const;
 	int32 DatabasePoseIdToMatrixPoseId(int32 DatabasePoseId) const;
 	bool IsSearchPoseMatrixGenerated() const;
+	float GetSearchCostReduction() const;
+	bool UsesRuntimeMirroring() const;
+	bool IsSearchPoseMirrorable(const int32 MatrixPoseId) const;
+	void MirrorPoseArray(const float* InPoseArray, float* OutPoseArray) const;
+	bool HasBakedRootMotion() const;
+
+	/** Accumulates the baked root motion of an animation channel from StartTime over DeltaTime. The result is not
+	 * mirrored. Returns false if there is no baked root motion table, in which case it should be extracted instead */
+	bool ExtractBakedRootMotion(const FAnimChannelState& ChannelState, const float StartTime, const float DeltaTime,
+		FTransform& OutRootMotion) const;
 	
 	
 	/** UObject Interface*/
@@ -228,6 +318,8 @@ public:
 
 private:
 	void AddAnimNotifiesToNotifyQueue(FAnimNotifyQueue& NotifyQueue, TArray<FAnimNotifyEventReference>& Notifies, float InstanceWeight) const;
+	void GatherAnimNotifies(const UAnimSequenceBase* SourceAnim, const float StartTime, const float DeltaTime,
+		const bool bLooping, TArray<FAnimNotifyEventReference>& OutNotifies) const;
 
 	/** Calculates the Atom count per pose and total pose count and then zero fills the pose matrix to fit all poses*/
 	void InitializePoseMatrix();
@@ -235,7 +327,31 @@ private:
 	void PreProcessAnim(const int32 SourceAnimIndex, const bool bMirror = false);
 	void PreProcessBlendSpace(const int32 SourceBlendSpaceIndex, const bool bMirror = false);
 	void PreProcessComposite(const int32 SourceCompositeIndex, const bool bMirror = false);
+
+	/** Finds the uniform grid, defined by SampleSpacing, that a blend space is sampled on. Returns the number of grid
+	 * points along each axis, or zero if the blend space is invalid */
+	static FIntPoint GetBlendSpaceSampleGrid(const UMotionBlendSpaceObject* InMotionBlendSpace, FVector2D& OutStart, FVector2D& OutStep);
+
+	/** Removes poses, in place, that can be reconstructed by interpolating their neighbours within the adaptive
+	 * sampling error. Must be run after all animations are pre-processed and before pose sequencing is generated*/
+	void ApplyAdaptiveSampling();
+
+	/** Marks searchable poses that are near duplicates of another searchable pose as next natural only. This shrinks
+	 * the search pose matrix while leaving the lookup pose matrix and pose playback intact */
+	void PruneRedundantPoses();
+	
+	/** Calculates the reciprocal of each atom's standard deviation (excluding the cost multiplier) across the lookup
+	 * pose matrix. Atoms with no deviation get a value of zero */
+	void CalculateAtomInvStandardDeviations(TArray<float>& OutInvStandardDeviations) const;
+
+	/** Generates the per-atom mirror map used for runtime mirroring. Returns false if mirrored poses need to be baked */
+	bool GenerateMirrorAtomMap();
+	bool IsMirroringEnabled(const EMotionAnimAssetType AnimType, const int32 AnimId) const;
+	
 	void GeneratePoseSequencing();
 	void MarkEdgePoses(float InMaxAnimBlendTime);
+
+	/** Bakes PoseRootMotionTable from the source animations. Must be run after pose sequencing is generated */
+	void BakeRootMotionTable();
 	
 };
@@ -65,18 +65,44 @@ public:
 	virtual void CacheMotionBones(const FAnimInstanceProxy* InAnimInstanceProxy);
 	virtual void ExtractRuntime(FCSPose<FCompactPose>& CSPose, float* ResultLocation, float* FeatureCacheLocation, FAnimInstanceProxy*
 	                            AnimInstanceProxy, float DeltaTime);
+
+	/** Whether ExtractRuntime reads bones from the pose. The motion recorder only retargets the chain of the bone
+	 * returned by GetFeatureBoneName, or the whole pose if a feature reads the pose without reporting a bone. */
+	virtual bool UsesRuntimePose() const;
+
+	/** Features that derive values from the previous frame (e.g. velocities) keep history in the feature cache. The
+	 * motion recorder calls UpdateRuntimeHistory on frames where ExtractRuntime is skipped so that the history is never
+	 * more than a frame old when the next extraction happens. */
+	virtual bool HasRuntimeHistory() const;
+	virtual bool RuntimeHistoryNeedsPose() const;
+	virtual void UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy);
 	
 
 	//Input Response Functions
 	virtual void SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, AActor* InActor);
+
+	/** Finds the object on the actor (e.g. a trajectory generator) that input data is sourced from. Input providers
+	 * resolve this once so that no component look-up is needed each time the input data is sourced */
+	virtual UObject* ResolveInputSource(AActor* InActor) const;
+
+	/** Writes the input data for this feature from a source previously found with ResolveInputSource */
+	virtual void SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, UObject* InInputSource);
 	virtual void ApplyInputBlending(TArray<float>& DesiredInputArray, const TArray<float>& CurrentPoseArray, const int32 FeatureOffset, const float Weight);
 	virtual bool NextPoseToleranceTest(const TArray<float>& DesiredInputArray, const TArray<float>& PoseMatrix,
 	                                   const int32 MatrixStartIndex, const int32 FeatureOffset, const float PositionTolerance, const float RotationTolerance);
 
 	virtual float GetDefaultWeight(int32 AtomId) const;
 
-	virtual void CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-	                                                                  const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const;
+	/** Standard deviations are accumulated per atom in a single pass over the pose matrix. Features that are measured
+	 * as vectors (e.g. a bone location) override this to fold the per-atom squared distances of each vector into a single
+	 * distance shared by all atoms of that vector. The default treats every atom independently. */
+	virtual void ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray, const int32 FeatureOffset) const;
+
+	/** Runtime mirroring support. A mirrored pose is produced from an un-mirrored one by reading each atom from its
+	 * counterpart feature (e.g. the opposite foot) and flipping the sign of any atom that lies across the mirror plane. */
+	virtual FName GetFeatureBoneName() const;
+	virtual bool IsMirrorCounterpart(const UMatchFeatureBase* InOtherFeature, const FName MirroredBoneName) const;
+	virtual void GetMirrorAtomSigns(float* OutSigns) const;
 
 	virtual bool CanBeQualityFeature() const;
 	virtual bool CanBeResponseFeature() const;
@@ -99,4 +125,8 @@ public:
 #endif
 	
 	bool operator <(const UMatchFeatureBase& other);
+
+protected:
+	/** Sums the squared distances of a group of atoms and writes the total back to every atom in the group */
+	static void ReduceAtomGroup(TArray<float>& InOutDistToMeanSqrArray, const int32 GroupStartIndex, const int32 GroupSize);
 };
\ No newline at end of file
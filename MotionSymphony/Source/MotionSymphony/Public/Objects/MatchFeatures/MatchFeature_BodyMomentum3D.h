@@ -31,13 +31,20 @@ public:
 	virtual void ExtractRuntime(FCSPose<FCompactPose>& CSPose, float* ResultLocation, float* FeatureCacheLocation, FAnimInstanceProxy*
 								AnimInstanceProxy, float DeltaTime) override;
 
+	virtual bool UsesRuntimePose() const override;
+	virtual bool HasRuntimeHistory() const override;
+	virtual void UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy) override;
+
 	//Functions if used as an input feature
-	virtual void SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, AActor* InActor) override;
+	virtual UObject* ResolveInputSource(AActor* InActor) const override;
+	virtual void SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, UObject* InInputSource) override;
 	virtual bool NextPoseToleranceTest(const TArray<float>& DesiredInputArray, const TArray<float>& PoseMatrix,
 									   const int32 MatrixStartIndex, const int32 FeatureOffset, const float PositionTolerance, const float RotationTolerance) override;
 
-	virtual void CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-																	  const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const override;
+	virtual void ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+		const int32 FeatureOffset) const override;
+
+	virtual void GetMirrorAtomSigns(float* OutSigns) const override;
 
 	virtual bool CanBeQualityFeature() const override;
 	virtual bool CanBeResponseFeature() const override;
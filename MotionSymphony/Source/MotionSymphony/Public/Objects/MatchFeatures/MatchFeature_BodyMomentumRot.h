@@ -33,6 +33,12 @@ public:
 	virtual void ExtractRuntime(FCSPose<FCompactPose>& CSPose, float* ResultLocation, float* FeatureCacheLocation, FAnimInstanceProxy*
 	                            AnimInstanceProxy, float DeltaTime) override;
 
+	virtual bool UsesRuntimePose() const override;
+	virtual bool HasRuntimeHistory() const override;
+	virtual void UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy) override;
+
+	virtual void GetMirrorAtomSigns(float* OutSigns) const override;
+
 	virtual bool CanBeQualityFeature() const override;
 	virtual bool CanBeResponseFeature() const override;
 	
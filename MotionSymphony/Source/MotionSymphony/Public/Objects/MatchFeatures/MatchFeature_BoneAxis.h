@@ -41,6 +41,10 @@ public:
 	virtual void ExtractRuntime(FCSPose<FCompactPose>& CSPose, float* ResultLocation, float* FeatureCacheLocation, FAnimInstanceProxy*
 	                            AnimInstanceProxy, float DeltaTime) override;
 	
+	virtual FName GetFeatureBoneName() const override;
+	virtual bool IsMirrorCounterpart(const UMatchFeatureBase* InOtherFeature, const FName MirroredBoneName) const override;
+	virtual void GetMirrorAtomSigns(float* OutSigns) const override;
+
 	virtual bool CanBeQualityFeature() const override;
 
 #if WITH_EDITOR	
@@ -37,6 +37,8 @@ public:
 	virtual void ExtractRuntime(FCSPose<FCompactPose>& CSPose, float* ResultLocation, float* FeatureCacheLocation, FAnimInstanceProxy*
 	                            AnimInstanceProxy, float DeltaTime) override;
 
+	virtual FName GetFeatureBoneName() const override;
+
 	virtual bool CanBeQualityFeature() const override;
 
 #if WITH_EDITOR	
@@ -43,10 +43,17 @@ public:
 	virtual void ExtractRuntime(FCSPose<FCompactPose>& CSPose, float* ResultLocation, float* FeatureCacheLocation, FAnimInstanceProxy*
 	                            AnimInstanceProxy, float DeltaTime) override;
 
+	virtual bool HasRuntimeHistory() const override;
+	virtual bool RuntimeHistoryNeedsPose() const override;
+	virtual void UpdateRuntimeHistory(FCSPose<FCompactPose>& CSPose, float* FeatureCacheLocation, FAnimInstanceProxy* AnimInstanceProxy) override;
+
 	virtual float GetDefaultWeight(int32 AtomId) const override;
 	
-	virtual void CalculateDistanceSqrToMeanArrayForStandardDeviations(TArray<float>& OutDistToMeanSqrArray,
-		const TArray<float>& InMeanArray, const TArray<float>& InPoseArray, const int32 FeatureOffset, const int32 PoseStartIndex) const override;
+	virtual void ReduceDistanceSqrToMeanForStandardDeviations(TArray<float>& InOutDistToMeanSqrArray,
+		const int32 FeatureOffset) const override;
+
+	virtual FName GetFeatureBoneName() const override;
+	virtual void GetMirrorAtomSigns(float* OutSigns) const override;
 
 	virtual bool CanBeQualityFeature() const override;
 	
@@ -38,7 +38,8 @@ public:
 	                                <UMotionAnimObject>
 	                                InAnimObject) override;
 
-	virtual void SourceInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, AActor* InActor) override;
+	virtual UObject* ResolveInputSource(AActor* InActor) const override;
+	virtual void SourceResolvedInputData(TArray<float>& OutFeatureArray, const int32 FeatureOffset, UObject* InInputSource) override;
 	virtual bool NextPoseToleranceTest(const TArray<float>& DesiredInputArray, const TArray<float>& PoseMatrix,
 		const int32 MatrixStartIndex, const int32 FeatureOffset, const float PositionTolerance, const float RotationTolerance) override;
 	
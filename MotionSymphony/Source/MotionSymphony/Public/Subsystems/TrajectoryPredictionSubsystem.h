@@ -0,0 +1,72 @@
+//Copyright 2020-2023 Kenneth Claassen. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/TrajectoryGenerator.h"
+#include "TrajectoryPredictionSubsystem.generated.h"
+
+/** Updates every trajectory generator that uses batched prediction in a single pass per frame, which replaces their
+ * individual component ticks. Per character state is gathered on the game thread. The spring model is then solved for
+ * all characters at once over structure of arrays buffers. It is split into chunks of characters with ParallelFor and
+ * the inner loop runs across characters so that it vectorizes. The capsule model branches per character, so it runs in
+ * parallel one character per task. Results are written back to each generator before its trajectory is extracted. */
+UCLASS()
+class MOTIONSYMPHONY_API UTrajectoryPredictionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UTrajectoryGenerator>> Generators;
+
+	//Spring model batch. Per character values are indexed by character and per iteration values are laid out as
+	//[Iteration * SpringCount + Character] so that each iteration is a contiguous row of characters.
+	TArray<UTrajectoryGenerator*> SpringGenerators;
+	TArray<float> SpringDeltaTimes;
+	TArray<int32> SpringIterationCounts;
+	TArray<float> DesiredDisplacementX;
+	TArray<float> DesiredDisplacementY;
+	TArray<float> DesiredDisplacementZ;
+	TArray<float> DesiredOrientations;
+	TArray<float> MoveDecaySteps;
+	TArray<float> TurnDecaySteps;
+	TArray<float> MoveDecays;
+	TArray<float> TurnDecays;
+	TArray<float> PreviousPositionsX;
+	TArray<float> PreviousPositionsY;
+	TArray<float> PreviousPositionsZ;
+	TArray<float> PositionsX;
+	TArray<float> PositionsY;
+	TArray<float> PositionsZ;
+	TArray<float> Rotations;
+	int32 MaxSpringIterations;
+
+	//Capsule model batch
+	TArray<UTrajectoryGenerator*> CapsuleGenerators;
+	TArray<float> CapsuleDeltaTimes;
+	TArray<FTrajectoryCapsuleInput> CapsuleInputs;
+
+public:
+	UTrajectoryPredictionSubsystem();
+
+	/** Adds a generator to the batched pass. Returns false if the generator overrides prediction that the batched pass
+	 * would bypass, in which case it should keep ticking on its own. */
+	bool RegisterGenerator(UTrajectoryGenerator* InGenerator);
+	void UnregisterGenerator(UTrajectoryGenerator* InGenerator);
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	// End of UTickableWorldSubsystem
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void GatherGenerators(const float DeltaTime);
+	void SolveSpringBatch();
+	void SolveCapsuleBatch();
+	void ScatterSpringBatch();
+};
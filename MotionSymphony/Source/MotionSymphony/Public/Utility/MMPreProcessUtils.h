@@ -11,6 +11,7 @@
 #include "Math/UnrealMathUtility.h"
 
 class UMotionDataAsset;
+class UBlendSpace;
 class USkeletalMeshComponent;
 struct FTrajectory;
 struct FTrajectoryPoint;
@@ -156,6 +157,12 @@ public:
 	static FName FindMirrorBoneName(const USkeleton* InSkeleton, UMirrorDataTable* InMirrorDataTable,
 	                                FName BoneName);
 
+	/** Finds the blend sample data for a position in a blend space. The last look-up is cached so that every feature and
+	 * time step evaluated at the same position shares it, and its triangulation index seeds the look-up of the next position.
+	 * Call ResetBlendSampleCache before pre-processing a blend space so that stale sample data is never used. */
+	static const TArray<FBlendSampleData>& FindBlendSamples(const UBlendSpace* InBlendSpace, const FVector2D& InBlendSpacePosition);
+	static void ResetBlendSampleCache();
+
 	///** Checks if the specified time on an animation is tagged with DoNotUse */
 	//static bool GetDoNotUseTag(const UAnimSequence* AnimSequence, const float Time, const float PoseInterval);
 
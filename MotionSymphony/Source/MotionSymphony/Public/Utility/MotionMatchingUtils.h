@@ -24,6 +24,8 @@ public:
 	
 	static void LerpPose(FPoseMotionData& OutLerpPose, const FPoseMotionData& From, const FPoseMotionData& To, float Progress);
 
+	static void LerpPose(FRuntimePoseData& OutLerpPose, const FRuntimePoseData& From, const FRuntimePoseData& To, float Progress);
+
 	static void LerpLinearPoseData(TArray<float>& OutLerpPose, TArray<float> From, TArray<float> To, const float Progress);
 
 	static void LerpLinearPoseData(TArray<float>& OutLerpPose, float* From, float* To, const float Progress, const int32 PoseSize);
@@ -190,8 +190,8 @@ void UAnimGraphNode_MultiPoseMatching::BakeDataDuringCompilation(FCompilerResult
 	Node.SetGroupName(SyncGroup_DEPRECATED.GroupName);
 	Node.SetGroupRole(SyncGroup_DEPRECATED.GroupRole);
 	
-	//Pre-Process the pose data here
-	Node.SetDirtyForPreProcess();
+	//Pre-Process the pose data here so that it is baked into the compiled anim blueprint
+	Node.PreProcess();
 	//Node.InitializeData();
 }
 
@@ -177,7 +177,8 @@ void UAnimGraphNode_PoseMatching::BakeDataDuringCompilation(FCompilerResultsLog
 	UAnimBlueprint* AnimBlueprint = GetAnimBlueprint();
 	AnimBlueprint->FindOrAddGroup(Node.GetGroupName());
 	
-	Node.SetDirtyForPreProcess();
+	//Bake the poses into the compiled anim blueprint so that they are cooked with it
+	Node.PreProcess();
 }
 
 void UAnimGraphNode_PoseMatching::GetAllAnimationSequencesReferred(TArray<UAnimationAsset*>& AnimationAssets) const
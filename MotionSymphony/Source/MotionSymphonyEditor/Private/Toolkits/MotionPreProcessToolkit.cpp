@@ -15,6 +15,8 @@
 #include "GUI/Widgets/SMotionBrowser.h"
 #include "GUI/Dialogs/AddNewAnimDialog.h"
 #include "Misc/MessageDialog.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
 #include "AnimPreviewInstance.h"
 #include "AssetSelection.h"
 #include "SScrubControlPanel.h"
@@ -656,10 +658,8 @@ void FMotionPreProcessToolkit::FindCurrentPose(float Time)
 		&& PreviewPoseCurrentIndex != INDEX_NONE
 		&& PreviewPoseEndIndex != INDEX_NONE)
 	{
-		TObjectPtr<UMotionAnimObject> AnimAsset = GetCurrentMotionAnim();
-
-		
-		PreviewPoseCurrentIndex = PreviewPoseStartIndex + FMath::RoundToInt(Time / (ActiveMotionDataAsset->PoseInterval * AnimAsset->PlayRate));
+		//Poses are not necessarily evenly spaced (adaptive sampling) so search by the time stored on each pose
+		PreviewPoseCurrentIndex = ActiveMotionDataAsset->FindClosestPoseIdInRange(PreviewPoseStartIndex, PreviewPoseEndIndex, Time);
 		PreviewPoseCurrentIndex = FMath::Clamp(PreviewPoseCurrentIndex, PreviewPoseStartIndex, PreviewPoseEndIndex);
 	}
 	else
@@ -1645,6 +1645,21 @@ void FMotionPreProcessToolkit::PreProcessAnimData() const
 	ActiveMotionDataAsset->Modify();
 	ActiveMotionDataAsset->PreProcess();
 	//ActiveMotionDataAsset->MarkPackageDirty();
+
+	if (ActiveMotionDataAsset->bIsProcessed
+		&& ActiveMotionDataAsset->RedundantPoseThresholdUsed > 0.0f)
+	{
+		FFormatNamedArguments Args;
+		Args.Add(TEXT("Threshold"), FText::AsNumber(ActiveMotionDataAsset->RedundantPoseThresholdUsed));
+		Args.Add(TEXT("PrunedCount"), FText::AsNumber(ActiveMotionDataAsset->RedundantPoseCount));
+		Args.Add(TEXT("SearchableCount"), FText::AsNumber(ActiveMotionDataAsset->UnprunedSearchPoseCount));
+		Args.Add(TEXT("Reduction"), FText::AsPercent(ActiveMotionDataAsset->GetSearchCostReduction()));
+
+		FNotificationInfo Info(FText::Format(LOCTEXT("RedundantPosesPruned",
+			"Pruned {PrunedCount} of {SearchableCount} searchable poses (threshold {Threshold}). Search cost reduced by {Reduction}."), Args));
+		Info.ExpireDuration = 5.0f;
+		FSlateNotificationManager::Get().AddNotification(Info);
+	}
 }
 
 void FMotionPreProcessToolkit::OpenPickAnimsDialog()